@@ -0,0 +1,162 @@
+/**
+ * @file bench_main.c
+ * @brief Benchmark suite for the bmap library.
+ * Times each public operation over several iterations and prints the best
+ * and median wall-clock time. Also used as the training run for PGO builds.
+ * Usage: bench [image.bmp] [iterations] [label]
+ * @author Arda Aksu
+ * @date 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bmap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_ITERATIONS 1000
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static void report(const char* name, double* samples, int count) {
+    qsort(samples, count, sizeof(double), compare_double);
+    printf("  %-22s best %9.3f ms   median %9.3f ms\n", name, samples[0], samples[count / 2]);
+}
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : "assets/airplane.bmp";
+    int iterations = argc > 2 ? atoi(argv[2]) : 20;
+    const char* label = argc > 3 ? argv[3] : "default";
+    if (iterations < 1) iterations = 1;
+    if (iterations > MAX_ITERATIONS) iterations = MAX_ITERATIONS;
+
+    BMPError err;
+    BMPImage* source = bmp_load(path, &err);
+    if (!source) {
+        printf("Cannot load %s (error %d)\n", path, err);
+        return 1;
+    }
+
+    printf("--- bmap benchmark [%s] %s (%dx%d), %d iterations, kernels: %s ---\n",
+           label, path, source->width, source->height, iterations, bmp_active_isa());
+
+    static double samples[MAX_ITERATIONS];
+    double start;
+
+#define BENCH(name, setup, body, teardown)            \
+    for (int it = 0; it < iterations; it++) {         \
+        setup;                                        \
+        start = now_ms();                             \
+        body;                                         \
+        samples[it] = now_ms() - start;               \
+        teardown;                                     \
+    }                                                 \
+    report(name, samples, iterations)
+
+    /*
+     * Every public operation with a hot loop gets an entry here: the same run
+     * is the PGO training set, so an operation missing from this list is
+     * compiled without a profile.
+     */
+    BMPImage* img = NULL;
+    BMPImage* other = NULL;
+    void* encoded = NULL;
+    size_t encoded_size = 0;
+    int w = source->width, h = source->height;
+
+    BENCH("bmp_load", (void)0, img = bmp_load(path, &err), bmp_free(img));
+    BENCH("bmp_load_region 1/4", (void)0,
+          img = bmp_load_region(path, 0, 0, w / 2, h / 2, &err), bmp_free(img));
+    BENCH("bmp_grayscale", img = bmp_clone(source, NULL), bmp_grayscale(img), bmp_free(img));
+    BENCH("bmp_invert", img = bmp_clone(source, NULL), bmp_invert(img), bmp_free(img));
+    BENCH("bmp_flip_horizontal", img = bmp_clone(source, NULL), bmp_flip_horizontal(img), bmp_free(img));
+    BENCH("bmp_rotate_right", img = bmp_clone(source, NULL), bmp_rotate_right(img), bmp_free(img));
+    BENCH("bmp_resize 1/2", img = bmp_clone(source, NULL), bmp_resize(img, w / 2, h / 2), bmp_free(img));
+    BENCH("bmp_resize_into linear", img = bmp_create(w / 2, h / 2, NULL),
+          bmp_resize_into(source, img, BMP_MIX_LINEAR_LIGHT), bmp_free(img));
+    BENCH("bmp_save", (void)0, bmp_save(source, "bench_tmp.bmp"), (void)0);
+
+    BMPOperation ops[] = { BMP_OP_GRAYSCALE, BMP_OP_INVERT };
+    bmp_cache_clear();
+    BENCH("bmp_cache_get_tile", (void)0,
+          img = bmp_cache_get_tile(path, 0, 0, ops, 2, &err), bmp_free(img));
+
+    /* --- Codecs and containers --- */
+    BENCH("bmp_encode_qoi", (void)0, encoded = bmp_encode_qoi(source, &encoded_size, &err), free(encoded));
+    encoded = bmp_encode_qoi(source, &encoded_size, &err);
+    BENCH("bmp_decode_qoi", (void)0, img = bmp_decode_qoi(encoded, encoded_size, &err), bmp_free(img));
+    free(encoded);
+    BENCH("bmp_encode_pnm", (void)0, encoded = bmp_encode_pnm(source, BMP_PNM_PPM, &encoded_size, &err),
+          free(encoded));
+    BENCH("bmp_save_tiled", (void)0, bmp_save_tiled(source, "bench_tmp.bmt", 256, 0, 1), (void)0);
+    remove("bench_tmp.bmt");
+
+    BMPSequence* seq = bmp_sequence_create(64, ops, 2, &err);
+    BMPImage* frame = bmp_clone(source, NULL);
+    bmp_sequence_process(seq, frame, &err);
+    BENCH("bmp_sequence_process", frame->data[0].red ^= 0xFF, bmp_sequence_process(seq, frame, &err), (void)0);
+    bmp_sequence_free(seq);
+
+    /* --- Analysis --- */
+    BMPCompareResult cmp;
+    other = bmp_clone(source, NULL);
+    bmp_invert(other);
+    BENCH("bmp_compare psnr", (void)0, bmp_compare(source, other, 0, 1, NULL, &cmp), (void)0);
+    BENCH("bmp_compare ssim", (void)0, bmp_compare(source, other, BMP_COMPARE_SSIM, 1, NULL, &cmp), (void)0);
+    BENCH("bmp_phash", (void)0, bmp_phash(source), (void)0);
+    BENCH("bmp_hash", (void)0, bmp_hash(source), (void)0);
+
+    /* --- Compositing and drawing --- */
+    BENCH("bmp_blend over 50%", img = bmp_clone(source, NULL), bmp_blend(img, other, 128, BMP_BLEND_OVER, 0),
+          bmp_free(img));
+    BENCH("bmp_blend multiply", img = bmp_clone(source, NULL), bmp_blend(img, other, 255, BMP_BLEND_MULTIPLY, 0),
+          bmp_free(img));
+    BENCH("bmp_blend over linear", img = bmp_clone(source, NULL),
+          bmp_blend(img, other, 128, BMP_BLEND_OVER, BMP_MIX_LINEAR_LIGHT), bmp_free(img));
+    const int star[] = { w / 2, h - 1, w / 8, 0, w - 1, h * 2 / 3, 0, h * 2 / 3, w * 7 / 8, 0 };
+    BENCH("bmp_fill_polygon", (void)0, bmp_fill_polygon(frame, star, 5, (Pixel){ 0, 128, 255 }), (void)0);
+    BENCH("bmp_fill_circle", (void)0, bmp_fill_circle(frame, w / 2, h / 2, h / 3, (Pixel){ 255, 0, 0 }), (void)0);
+    BENCH("bmp_draw_line_aa x64", (void)0,
+          for (int k = 0; k < 64; k++) bmp_draw_line_aa(frame, 0.5f, k * 7.25f, w - 1.5f, h - 1 - k * 5.5f,
+                                                        (Pixel){ 255, 255, 255 }),
+          (void)0);
+
+    /* --- Color spaces --- */
+    BENCH("bmp_to_color_space ycc", img = bmp_clone(source, NULL), bmp_to_color_space(img, BMP_COLOR_YCBCR601),
+          bmp_free(img));
+    BENCH("bmp_to_color_space lab", img = bmp_clone(source, NULL), bmp_to_color_space(img, BMP_COLOR_LAB),
+          bmp_free(img));
+    size_t luma = (size_t)w * h, chroma = (size_t)((w + 1) / 2) * ((h + 1) / 2);
+    uint8_t* planes = (uint8_t*)malloc(luma + 2 * chroma);
+    if (planes) {
+        BENCH("bmp_to_i420", (void)0,
+              bmp_to_i420(source, BMP_COLOR_YCBCR601_LIMITED, planes, w, planes + luma, (w + 1) / 2,
+                          planes + luma + chroma, (w + 1) / 2),
+              (void)0);
+        BENCH("bmp_from_i420", (void)0,
+              bmp_from_i420(frame, BMP_COLOR_YCBCR601_LIMITED, planes, w, planes + luma, (w + 1) / 2,
+                            planes + luma + chroma, (w + 1) / 2),
+              (void)0);
+    }
+
+#undef BENCH
+
+    free(planes);
+    bmp_free(frame);
+    bmp_free(other);
+    remove("bench_tmp.bmp");
+    bmp_cache_clear();
+    bmp_free(source);
+    return 0;
+}
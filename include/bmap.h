@@ -8,8 +8,23 @@
 #ifndef BMAP_H
 #define BMAP_H
 
+#include <stddef.h>
 #include <stdint.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Marks the public API. The shared library is built with
+ * -fvisibility=hidden, so only symbols tagged here are exported.
+ */
+#if defined(__GNUC__) && !defined(_WIN32)
+#define BMAP_API __attribute__((visibility("default")))
+#else
+#define BMAP_API
+#endif
+
 /* ========================================================================= *
  * DATA TYPES                                 *
  * ========================================================================= */
@@ -21,7 +36,9 @@ typedef enum {
     BMP_SUCCESS = 0,               /**< Operation completed successfully */
     BMP_ERR_FILE_NOT_FOUND = 1,    /**< File could not be opened or found */
     BMP_ERR_INVALID_FORMAT = 2,    /**< File is not a valid BMP or unsupported depth */
-    BMP_ERR_MALLOC_FAILED = 3      /**< Memory allocation failed (RAM is full) */
+    BMP_ERR_MALLOC_FAILED = 3,     /**< Memory allocation failed (RAM is full) */
+    BMP_ERR_INVALID_ARGUMENT = 4,  /**< A parameter is NULL, out of range or inconsistent */
+    BMP_ERR_IO = 5                 /**< A socket or mapping operation failed (e.g. bmapd is unreachable) */
 } BMPError;
 
 #pragma pack(push, 1)
@@ -44,8 +61,21 @@ typedef struct {
     int width;      /**< Image width in pixels */
     int height;     /**< Image height in pixels */
     Pixel* data;    /**< Flat array of pixels (row-major order) */
+    void* storage;  /**< Internal: scratch mapping behind data, NULL for heap memory */
 } BMPImage;
 
+/**
+ * @brief Identifiers for the library operations that can be chained.
+ * Used wherever a sequence of operations is described as data
+ * (e.g. the tile cache key).
+ */
+typedef enum {
+    BMP_OP_GRAYSCALE = 0,          /**< bmp_grayscale() */
+    BMP_OP_INVERT = 1,             /**< bmp_invert() */
+    BMP_OP_FLIP_HORIZONTAL = 2,    /**< bmp_flip_horizontal() */
+    BMP_OP_ROTATE_RIGHT = 3        /**< bmp_rotate_right() */
+} BMPOperation;
+
 
 /* ========================================================================= *
  * CORE FUNCTIONS                                *
@@ -56,7 +86,7 @@ typedef struct {
  * @param err_out Pointer to store error status (can be NULL).
  * @return Pointer to loaded BMPImage, or NULL on failure.
  */
-BMPImage* bmp_load(const char* filename, BMPError* err_out);
+BMAP_API BMPImage* bmp_load(const char* filename, BMPError* err_out);
 
 /**
  * @brief Saves the BMPImage from memory to a file on disk.
@@ -65,13 +95,339 @@ BMPImage* bmp_load(const char* filename, BMPError* err_out);
  * @param filename Target file path.
  * @return BMP_SUCCESS on success, or error code on failure.
  */
-BMPError bmp_save(const BMPImage* image, const char* filename);
+BMAP_API BMPError bmp_save(const BMPImage* image, const char* filename);
+
+/**
+ * @brief Loads a BMP file into file-backed scratch storage instead of the heap.
+ * Intended for images larger than RAM: pixel data lives in an unlinked file
+ * in the scratch directory (see bmp_set_scratch_directory()) and is paged in
+ * on demand. All other functions accept the result like any other image.
+ * @param filename Path to the BMP file.
+ * @param err_out Pointer to store error status (can be NULL).
+ * @return Pointer to loaded BMPImage, or NULL on failure.
+ */
+BMAP_API BMPImage* bmp_load_mapped(const char* filename, BMPError* err_out);
+
+/**
+ * @brief Loads a BMP file into an existing image, reusing its pixel buffer.
+ * The buffer is resized with realloc(), so processing many files of similar
+ * size in a loop does not allocate per file. Scratch-backed images are
+ * switched to heap storage.
+ * @param image Image to overwrite (e.g. from bmp_create() or a previous load).
+ * @param filename Path to the BMP file.
+ * @return BMP_SUCCESS, or an error code (BMP_ERR_INVALID_FORMAT also for a
+ *         zero width or height, or pixel data cut short); on failure the image
+ *         is unchanged unless the error is BMP_ERR_MALLOC_FAILED or the pixel
+ *         data was cut short, which leave it a valid, freeable image (the latter
+ *         with the file's dimensions and unspecified pixels).
+ */
+BMAP_API BMPError bmp_load_into(BMPImage* image, const char* filename);
+
+/**
+ * @brief Sets the directory used for out-of-core scratch files.
+ * Once set, any pixel allocation that fails on the heap (bmp_load(),
+ * bmp_rotate_right(), ...) spills to a scratch file there instead of failing.
+ * Without it, bmp_load_mapped() uses $TMPDIR or /tmp.
+ * @param directory Existing writable directory, or NULL to disable spilling.
+ * @return BMP_SUCCESS, or BMP_ERR_INVALID_ARGUMENT if the path is too long.
+ */
+BMAP_API BMPError bmp_set_scratch_directory(const char* directory);
+
+/**
+ * @brief Returns 1 if the image's pixels live in scratch storage, 0 otherwise.
+ */
+BMAP_API int bmp_is_mapped(const BMPImage* image);
 
 /**
  * @brief Frees the memory allocated for the image and its pixel data.
  * @param image Pointer to the image structure to be destroyed.
  */
-void bmp_free(BMPImage* image);
+BMAP_API void bmp_free(BMPImage* image);
+
+/**
+ * @brief Allocates a new image with uninitialized pixel data.
+ * @param width Image width in pixels (must be > 0).
+ * @param height Image height in pixels (must be > 0).
+ * @param err_out Pointer to store error status (can be NULL).
+ * @return Pointer to the new image (free with bmp_free()), or NULL on failure.
+ */
+BMAP_API BMPImage* bmp_create(int width, int height, BMPError* err_out);
+
+/**
+ * @brief Creates a deep copy of an image on the heap.
+ * @param image Pointer to the image to copy.
+ * @param err_out Pointer to store error status (can be NULL).
+ * @return Pointer to the copy (free with bmp_free()), or NULL on failure.
+ */
+BMAP_API BMPImage* bmp_clone(const BMPImage* image, BMPError* err_out);
+
+/**
+ * @brief Loads only a rectangular region of a BMP file.
+ * Issues one positioned read per needed row (one per region when rows are
+ * contiguous), so the cost scales with the size of the region instead of the
+ * size of the file. Coordinates use the same row order
+ * as bmp_load(), and the result is identical to cropping its output.
+ * The rectangle is clipped to the image bounds.
+ * @param filename Path to the BMP file.
+ * @param x Left column of the region.
+ * @param y First row of the region.
+ * @param w Region width in pixels.
+ * @param h Region height in pixels.
+ * @param err_out Pointer to store error status (can be NULL).
+ * @return Pointer to the loaded region, or NULL on failure
+ *         (BMP_ERR_INVALID_ARGUMENT if the clipped region is empty).
+ */
+BMAP_API BMPImage* bmp_load_region(const char* filename, int x, int y, int w, int h, BMPError* err_out);
+
+/** Upper bound on the worker threads used by bmp_load_region_parallel(). */
+#define BMP_REGION_MAX_THREADS 64
+
+/**
+ * @brief Same as bmp_load_region(), but fetches blocks of rows in parallel.
+ * Each thread issues positioned reads (pread) on a shared descriptor, which
+ * helps on storage that rewards queue depth (NVMe, network file systems).
+ * @param threads Number of threads to use (clamped to 1..BMP_REGION_MAX_THREADS
+ *                and to the region height).
+ * @return Pointer to the loaded region, or NULL on failure.
+ */
+BMAP_API BMPImage* bmp_load_region_parallel(const char* filename, int x, int y, int w, int h,
+                                            int threads, BMPError* err_out);
+
+
+/* ========================================================================= *
+ * IMAGE CODECS                                 *
+ * ========================================================================= */
+
+/**
+ * @brief Saves the image as lossless QOI (typically 3-4x smaller than BMP).
+ * Streams through a fixed-size buffer in a single pass. Rows are stored top
+ * to bottom, i.e. in the orientation bmp_save() produces.
+ * @return BMP_SUCCESS, BMP_ERR_FILE_NOT_FOUND if the file cannot be created,
+ *         BMP_ERR_INVALID_ARGUMENT if the image is empty or too large for QOI,
+ *         or BMP_ERR_IO if writing fails.
+ */
+BMAP_API BMPError bmp_save_qoi(const BMPImage* image, const char* filename);
+
+/**
+ * @brief Loads a QOI file (RGB or RGBA; alpha is dropped).
+ * @return Pointer to loaded BMPImage, or NULL on failure
+ *         (BMP_ERR_INVALID_FORMAT for a malformed or truncated stream).
+ */
+BMAP_API BMPImage* bmp_load_qoi(const char* filename, BMPError* err_out);
+
+/**
+ * @brief Encodes the image as QOI into a new memory buffer.
+ * @param size_out Receives the encoded size in bytes.
+ * @return Buffer owned by the caller (release with free()), or NULL on failure.
+ */
+BMAP_API void* bmp_encode_qoi(const BMPImage* image, size_t* size_out, BMPError* err_out);
+
+/**
+ * @brief Decodes a QOI stream held in memory.
+ * @return Pointer to the decoded BMPImage, or NULL on failure.
+ */
+BMAP_API BMPImage* bmp_decode_qoi(const void* data, size_t size, BMPError* err_out);
+
+
+/** Netpbm variants written by bmp_save_pnm() and bmp_encode_pnm(). */
+typedef enum {
+    BMP_PNM_PPM = 0,               /**< P6, binary RGB */
+    BMP_PNM_PGM = 1,               /**< P5, binary gray (channel average, as bmp_grayscale()) */
+    BMP_PNM_PAM = 2                /**< P7 with TUPLTYPE RGB */
+} BMPPnmFormat;
+
+/**
+ * @brief Loads a binary PPM (P6), PGM (P5) or PAM (P7) file.
+ * 8-bit RGB and gray rows are read straight into the pixel buffer and
+ * swizzled in place. Other maxvals, 16-bit samples and alpha or gray-alpha
+ * PAM tuples are scaled to 8 bits; alpha is dropped.
+ * @return Pointer to loaded BMPImage, or NULL on failure.
+ */
+BMAP_API BMPImage* bmp_load_pnm(const char* filename, BMPError* err_out);
+
+/**
+ * @brief Saves the image as 8-bit PPM, PGM or PAM.
+ * @return BMP_SUCCESS, BMP_ERR_FILE_NOT_FOUND, BMP_ERR_INVALID_ARGUMENT for an
+ *         unknown format, or BMP_ERR_IO if writing fails.
+ */
+BMAP_API BMPError bmp_save_pnm(const BMPImage* image, const char* filename, BMPPnmFormat format);
+
+/**
+ * @brief Encodes the image as PPM, PGM or PAM into a new memory buffer.
+ * @return Buffer owned by the caller (release with free()), or NULL on failure.
+ */
+BMAP_API void* bmp_encode_pnm(const BMPImage* image, BMPPnmFormat format, size_t* size_out,
+                              BMPError* err_out);
+
+/**
+ * @brief Decodes a PPM, PGM or PAM image held in memory.
+ * @return Pointer to the decoded BMPImage, or NULL on failure.
+ */
+BMAP_API BMPImage* bmp_decode_pnm(const void* data, size_t size, BMPError* err_out);
+
+
+/* ========================================================================= *
+ * TILED CONTAINER                                *
+ * ========================================================================= */
+
+/** Most pyramid levels a tiled file can hold. */
+#define BMP_TILED_MAX_LEVELS 32
+
+/** Per-tile encodings in a tiled file. */
+typedef enum {
+    BMP_TILE_RAW = 0,              /**< Pixel rows as in BMPImage::data */
+    BMP_TILE_QOI = 1               /**< QOI stream (bmp_encode_qoi()) */
+} BMPTileCodec;
+
+/** Geometry of one pyramid level. Edge tiles are clipped to the level size. */
+typedef struct {
+    int width;
+    int height;
+    int tiles_x;
+    int tiles_y;
+} BMPTiledLevel;
+
+/** Opaque handle for random tile access; see bmp_tiled_open(). */
+typedef struct BMPTiledReader BMPTiledReader;
+
+/**
+ * @brief Saves the image as a tiled pyramid (.bmt).
+ * Level 0 is the image itself; each further level halves the previous one
+ * (rounding up). A tile index at the end of the file locates every tile.
+ * @param tile_size Tile edge in pixels (e.g. 256), at most 32768.
+ * @param levels Number of levels, or 0 to keep halving until a level fits in one tile.
+ * @param compress Nonzero to store tiles as QOI where that is smaller than raw.
+ * @return BMP_SUCCESS, BMP_ERR_FILE_NOT_FOUND, BMP_ERR_INVALID_ARGUMENT,
+ *         BMP_ERR_MALLOC_FAILED or BMP_ERR_IO.
+ */
+BMAP_API BMPError bmp_save_tiled(const BMPImage* image, const char* filename, int tile_size,
+                                 int levels, int compress);
+
+/**
+ * @brief Opens a tiled file and loads its index.
+ * A reader can be shared between threads; each tile fetch is a single pread.
+ * @return Reader handle (release with bmp_tiled_close()), or NULL on failure
+ *         (BMP_ERR_INVALID_FORMAT for a bad header, index or footer).
+ */
+BMAP_API BMPTiledReader* bmp_tiled_open(const char* filename, BMPError* err_out);
+
+/** @brief Closes a reader returned by bmp_tiled_open(). */
+BMAP_API void bmp_tiled_close(BMPTiledReader* reader);
+
+/** @brief Returns the number of pyramid levels in the file. */
+BMAP_API int bmp_tiled_level_count(const BMPTiledReader* reader);
+
+/** @brief Returns the tile edge length in pixels. */
+BMAP_API int bmp_tiled_tile_size(const BMPTiledReader* reader);
+
+/**
+ * @brief Reports the size and tile grid of one level.
+ * @return BMP_SUCCESS, or BMP_ERR_INVALID_ARGUMENT if the level does not exist.
+ */
+BMAP_API BMPError bmp_tiled_level_info(const BMPTiledReader* reader, int level, BMPTiledLevel* info);
+
+/**
+ * @brief Reads one tile as its own image.
+ * @param tile_x Tile column, counted from the left.
+ * @param tile_y Tile row, counted from row 0 of BMPImage::data (the bottom).
+ * @return Pointer to the tile image, or NULL on failure.
+ */
+BMAP_API BMPImage* bmp_tiled_read_tile(const BMPTiledReader* reader, int level, int tile_x,
+                                       int tile_y, BMPError* err_out);
+
+/**
+ * @brief Reads and assembles a whole level.
+ * @return Pointer to the level image, or NULL on failure.
+ */
+BMAP_API BMPImage* bmp_tiled_read_level(const BMPTiledReader* reader, int level, BMPError* err_out);
+
+
+/* ========================================================================= *
+ * FRAME SEQUENCES                                *
+ * ========================================================================= */
+
+/** Maximum length of the operation chain of a sequence. */
+#define BMP_SEQUENCE_MAX_OPS 16
+
+/** Largest tile edge accepted by sequences and delta files. */
+#define BMP_SEQUENCE_MAX_TILE 65536
+
+/** Opaque state for incremental processing; see bmp_sequence_create(). */
+typedef struct BMPSequence BMPSequence;
+
+/** Opaque handles for keyframe/delta files (.bmd). */
+typedef struct BMPDeltaWriter BMPDeltaWriter;
+typedef struct BMPDeltaReader BMPDeltaReader;
+
+/**
+ * @brief Creates a sequence that applies an operation chain to same-sized frames.
+ * Each frame is compared tile by tile with the previous one; only changed
+ * tiles are processed again and the rest of the output is reused.
+ * @param tile_size Edge length of the change-detection tiles in pixels
+ *                  (1..BMP_SEQUENCE_MAX_TILE).
+ * @param ops Operations applied to each frame (can be NULL if op_count is 0).
+ * @param op_count Number of entries in ops (at most BMP_SEQUENCE_MAX_OPS).
+ * @return Sequence handle (release with bmp_sequence_free()), or NULL on failure.
+ */
+BMAP_API BMPSequence* bmp_sequence_create(int tile_size, const BMPOperation* ops, int op_count,
+                                          BMPError* err_out);
+
+/** @brief Releases a sequence and its output image. */
+BMAP_API void bmp_sequence_free(BMPSequence* seq);
+
+/**
+ * @brief Processes the next frame.
+ * The first frame fixes the frame size and is processed in full.
+ * @return Output image owned by the sequence, valid until the next call, or
+ *         NULL on failure (BMP_ERR_INVALID_ARGUMENT if the size changed).
+ */
+BMAP_API const BMPImage* bmp_sequence_process(BMPSequence* seq, const BMPImage* frame, BMPError* err_out);
+
+/** @brief Returns how many tiles the last bmp_sequence_process() call reprocessed. */
+BMAP_API int bmp_sequence_dirty_tiles(const BMPSequence* seq);
+
+/**
+ * @brief Starts a keyframe/delta file.
+ * The first frame is stored whole; later frames store only the tiles that
+ * differ from the previous frame, plus a full keyframe every
+ * keyframe_interval frames.
+ * @param tile_size Edge length of the delta tiles in pixels (1..BMP_SEQUENCE_MAX_TILE).
+ * @param keyframe_interval Frames between keyframes, or 0 for the first frame only.
+ * @return Writer handle (finish with bmp_delta_finish()), or NULL on failure.
+ */
+BMAP_API BMPDeltaWriter* bmp_delta_create(const char* filename, int tile_size, int keyframe_interval,
+                                          BMPError* err_out);
+
+/**
+ * @brief Appends a frame; every frame must have the size of the first.
+ * @return BMP_SUCCESS, BMP_ERR_INVALID_ARGUMENT, BMP_ERR_MALLOC_FAILED or BMP_ERR_IO.
+ */
+BMAP_API BMPError bmp_delta_append(BMPDeltaWriter* writer, const BMPImage* frame);
+
+/**
+ * @brief Writes the final header, closes the file and releases the writer.
+ * @return BMP_SUCCESS, or BMP_ERR_IO if the file could not be completed.
+ */
+BMAP_API BMPError bmp_delta_finish(BMPDeltaWriter* writer);
+
+/**
+ * @brief Opens a keyframe/delta file for sequential reading.
+ * @return Reader handle (release with bmp_delta_close()), or NULL on failure.
+ */
+BMAP_API BMPDeltaReader* bmp_delta_open(const char* filename, BMPError* err_out);
+
+/** @brief Returns the number of frames in the file. */
+BMAP_API int bmp_delta_frame_count(const BMPDeltaReader* reader);
+
+/**
+ * @brief Reconstructs the next frame.
+ * @return Frame owned by the reader, valid until the next call, or NULL at
+ *         the end of the file (err_out is BMP_SUCCESS) or on failure.
+ */
+BMAP_API const BMPImage* bmp_delta_read(BMPDeltaReader* reader, BMPError* err_out);
+
+/** @brief Closes a reader returned by bmp_delta_open(). */
+BMAP_API void bmp_delta_close(BMPDeltaReader* reader);
 
 
 /* ========================================================================= *
@@ -82,13 +438,120 @@ void bmp_free(BMPImage* image);
  * @brief Retrieves the pixel color at coordinates (x, y).
  * Performs boundary checks to prevent memory errors.
  */
-Pixel bmp_get_pixel(const BMPImage* image, int x, int y);
+BMAP_API Pixel bmp_get_pixel(const BMPImage* image, int x, int y);
 
 /**
  * @brief Updates the pixel color at coordinates (x, y).
  * Performs boundary checks to prevent memory errors.
  */
-void bmp_set_pixel(BMPImage* image, int x, int y, Pixel color);
+BMAP_API void bmp_set_pixel(BMPImage* image, int x, int y, Pixel color);
+
+/**
+ * @brief Debug mode for the unchecked accessors below.
+ * Define BMAP_CHECKED before including bmap.h (or build with -DBMAP_CHECKED)
+ * and every bmp_row(), bmp_pixel() and bmp_put_pixel() call verifies its
+ * arguments, printing the failing check and aborting on misuse. Without it
+ * they compile to a plain index.
+ */
+#ifdef BMAP_CHECKED
+#include <stdio.h>
+#include <stdlib.h>
+#define BMAP_CHECK(cond) \
+    ((cond) ? (void)0 : (fprintf(stderr, "%s:%d: bmap check failed: %s\n", __FILE__, __LINE__, #cond), abort()))
+#else
+#define BMAP_CHECK(cond) ((void)0)
+#endif
+
+/**
+ * @brief Returns a pointer to the first pixel of row y (0 is the bottom row).
+ * Rows are image->width pixels long and contiguous; no bounds checks unless
+ * BMAP_CHECKED is defined.
+ */
+static inline Pixel* bmp_row(const BMPImage* image, int y) {
+    BMAP_CHECK(image && image->data && y >= 0 && y < image->height);
+    return image->data + (size_t)y * image->width;
+}
+
+/**
+ * @brief Unchecked bmp_get_pixel(): the caller guarantees 0 <= x < width and
+ * 0 <= y < height.
+ */
+static inline Pixel bmp_pixel(const BMPImage* image, int x, int y) {
+    BMAP_CHECK(x >= 0 && image && x < image->width);
+    return bmp_row(image, y)[x];
+}
+
+/**
+ * @brief Unchecked bmp_set_pixel(); same contract as bmp_pixel().
+ */
+static inline void bmp_put_pixel(BMPImage* image, int x, int y, Pixel color) {
+    BMAP_CHECK(x >= 0 && image && x < image->width);
+    bmp_row(image, y)[x] = color;
+}
+
+/**
+ * @brief Loops over the rows of an image, bottom row first, binding y and a
+ * row pointer: BMP_FOR_EACH_ROW(img, y, row) { row[x] = ...; }
+ * break and continue behave as in a plain loop. Row pointers come from
+ * bmp_row(), so BMAP_CHECKED applies.
+ */
+#define BMP_FOR_EACH_ROW(image, y, row) \
+    for (int y = 0, y##_bmp_broke = 0; !y##_bmp_broke && y < (image)->height; y++) \
+        for (Pixel* row = (y##_bmp_broke = 1, bmp_row((image), y)); y##_bmp_broke; y##_bmp_broke = 0)
+
+/**
+ * @brief Callback for bmp_visit_rows().
+ * @param row First pixel of the visited span (the pixel at x, y).
+ * @param count Pixels in the span.
+ * @param user The pointer passed to bmp_visit_rows().
+ */
+typedef void (*BMPRowVisitor)(Pixel* row, int count, int x, int y, void* user);
+
+/**
+ * @brief Calls visit once per row of the rectangle x, y, w, h.
+ * The rectangle is validated once up front, so visitors can index their
+ * span without further checks.
+ * @return BMP_SUCCESS, or BMP_ERR_INVALID_ARGUMENT if the rectangle is empty
+ *         or not fully inside the image.
+ */
+BMAP_API BMPError bmp_visit_rows(BMPImage* image, int x, int y, int w, int h, BMPRowVisitor visit, void* user);
+
+/** Byte order of external pixel buffers passed to bmp_read_rect() / bmp_write_rect(). */
+typedef enum {
+    BMP_ORDER_BGR = 0,             /**< Same layout as Pixel; rows are copied with memcpy() */
+    BMP_ORDER_RGB = 1              /**< Red first; rows are swizzled with the SIMD kernels */
+} BMPChannelOrder;
+
+/**
+ * @brief Copies the rectangle x, y, w, h into an external 3-byte-per-pixel buffer.
+ * Buffer row i receives image row y + i (rows run bottom-up, as in the image).
+ * @param dst_stride Bytes between buffer rows, or 0 for tightly packed (w * 3).
+ * @return BMP_SUCCESS, or BMP_ERR_INVALID_ARGUMENT if the rectangle is empty,
+ *         not fully inside the image, or the stride is smaller than a row.
+ */
+BMAP_API BMPError bmp_read_rect(const BMPImage* image, int x, int y, int w, int h,
+                                void* dst, size_t dst_stride, BMPChannelOrder order);
+
+/**
+ * @brief Copies an external w x h buffer into the image at x, y (a sprite blit).
+ * The rectangle is clipped to the image once; the parts that fall outside
+ * are skipped, so sprites may hang off any edge.
+ * @param src_stride Bytes between buffer rows, or 0 for tightly packed (w * 3).
+ * @return BMP_SUCCESS (also when nothing is visible), or
+ *         BMP_ERR_INVALID_ARGUMENT for a NULL argument or a short stride.
+ */
+BMAP_API BMPError bmp_write_rect(BMPImage* image, int x, int y, int w, int h,
+                                 const void* src, size_t src_stride, BMPChannelOrder order);
+
+/**
+ * @brief Sets count pixels of row y, starting at x, to color; clipped to the image.
+ */
+BMAP_API void bmp_fill_span(BMPImage* image, int x, int y, int count, Pixel color);
+
+/**
+ * @brief Sets every pixel of the rectangle x, y, w, h to color; clipped to the image.
+ */
+BMAP_API void bmp_fill_rect(BMPImage* image, int x, int y, int w, int h, Pixel color);
 
 
 /* ========================================================================= *
@@ -98,12 +561,52 @@ void bmp_set_pixel(BMPImage* image, int x, int y, Pixel color);
 /**
  * @brief Rotates the image 90 degrees clockwise.
  */
-void bmp_rotate_right(BMPImage* image);
+BMAP_API void bmp_rotate_right(BMPImage* image);
+
+/**
+ * @brief Writes src rotated 90 degrees clockwise into an existing image.
+ * Lets callers that manage their own buffers rotate without an allocation.
+ * @param src Image to rotate (unchanged).
+ * @param dst Destination, src->height pixels wide and src->width pixels high;
+ *            must not share memory with src.
+ * @return BMP_SUCCESS, or BMP_ERR_INVALID_ARGUMENT if the sizes do not match.
+ */
+BMAP_API BMPError bmp_rotate_right_into(const BMPImage* src, BMPImage* dst);
 
 /**
  * @brief Flips the image horizontally (Mirror effect).
  */
-void bmp_flip_horizontal(BMPImage* image);
+BMAP_API void bmp_flip_horizontal(BMPImage* image);
+
+/**
+ * @brief Per-call options of bmp_resize_into() and the blend/composite functions.
+ * Averaging sRGB-encoded bytes darkens edges and mixes; with
+ * BMP_MIX_LINEAR_LIGHT the pixels are decoded to 16-bit linear values through
+ * bmp_srgb_to_linear16, run through the same integer arithmetic there and
+ * re-encoded through bmp_linear12_to_srgb (a 50% black/white mix gives 188
+ * instead of 128). Untouched pixels round-trip exactly.
+ */
+typedef enum {
+    BMP_MIX_LINEAR_LIGHT = 1 << 0  /**< Resample or blend in linear light instead of sRGB bytes */
+} BMPMixFlags;
+
+/**
+ * @brief Resizes the image to new_width x new_height (bilinear filtering on sRGB bytes).
+ * Leaves the image unchanged if a size is not positive or memory runs out;
+ * use bmp_resize_into() to resample in linear light.
+ */
+BMAP_API void bmp_resize(BMPImage* image, int new_width, int new_height);
+
+/**
+ * @brief Resizes src to the size of an existing image (same filter as bmp_resize()).
+ * Lets callers that manage their own buffers resize without a pixel allocation.
+ * @param src Image to resize (unchanged).
+ * @param dst Destination; its width and height are the target size. Must not
+ *            share memory with src.
+ * @param flags Bitwise OR of BMPMixFlags values (0 for sRGB bytes, as bmp_resize()).
+ * @return BMP_SUCCESS, BMP_ERR_INVALID_ARGUMENT or BMP_ERR_MALLOC_FAILED.
+ */
+BMAP_API BMPError bmp_resize_into(const BMPImage* src, BMPImage* dst, int flags);
 
 
 /* ========================================================================= *
@@ -113,11 +616,543 @@ void bmp_flip_horizontal(BMPImage* image);
 /**
  * @brief Converts the image to grayscale.
  */
-void bmp_grayscale(BMPImage* image);
+BMAP_API void bmp_grayscale(BMPImage* image);
 
 /**
  * @brief Inverts the colors of the image (Negative effect).
  */
-void bmp_invert(BMPImage* image);
+BMAP_API void bmp_invert(BMPImage* image);
+
+
+/* ========================================================================= *
+ * BLENDING & COMPOSITING                            *
+ * ========================================================================= */
+
+/**
+ * @brief Blend modes, per channel with s = source and d = destination (0..255).
+ * The blended value b is then mixed in by alpha: d' = (b * a + d * (255 - a)) / 255.
+ */
+typedef enum {
+    BMP_BLEND_OVER = 0,            /**< Porter-Duff source over: b = s */
+    BMP_BLEND_MULTIPLY = 1,        /**< b = s * d / 255 (darkens) */
+    BMP_BLEND_SCREEN = 2,          /**< b = 255 - (255 - s) * (255 - d) / 255 (lightens) */
+    BMP_BLEND_ADD = 3              /**< b = min(s + d, 255) */
+} BMPBlendMode;
+
+/**
+ * @brief Blends count source pixels into a destination row.
+ * The building block of bmp_composite(), exposed so callers can blend views
+ * with their own strides (e.g. bmap::composite() in bmap.hpp). All division
+ * by 255 is exact and rounded, in SIMD 16-bit fixed point.
+ * @param alpha Per-pixel coverage (count bytes, scaled by opacity), or NULL
+ *              to use opacity alone. Coverage is already linear and is used
+ *              as is in linear light.
+ * @param opacity Constant alpha; 255 is fully opaque.
+ * @param flags Bitwise OR of BMPMixFlags values.
+ */
+BMAP_API void bmp_blend_row(Pixel* dst, const Pixel* src, const uint8_t* alpha, int count,
+                            uint8_t opacity, BMPBlendMode mode, int flags);
+
+/**
+ * @brief Composites src onto dst with its bottom-left corner at x, y.
+ * Only the overlapping region of dst is read or written, so an overlay
+ * costs the size of the overlay, not of the image; src may hang off any edge.
+ * @param alpha Per-pixel coverage mask, src->width x src->height bytes in the
+ *              same row order as src, or NULL for constant opacity.
+ * @param opacity Constant alpha applied on top of the mask (255 = opaque).
+ * @param flags Bitwise OR of BMPMixFlags values.
+ * @return BMP_SUCCESS (also when src lies outside dst), or
+ *         BMP_ERR_INVALID_ARGUMENT for a NULL image or an unknown mode.
+ */
+BMAP_API BMPError bmp_composite(BMPImage* dst, int x, int y, const BMPImage* src,
+                                const uint8_t* alpha, uint8_t opacity, BMPBlendMode mode, int flags);
+
+/**
+ * @brief Blends two images of the same size: bmp_composite() at 0, 0.
+ * @return BMP_SUCCESS, or BMP_ERR_INVALID_ARGUMENT if the sizes differ.
+ */
+BMAP_API BMPError bmp_blend(BMPImage* dst, const BMPImage* src, uint8_t opacity, BMPBlendMode mode,
+                            int flags);
+
+
+/* ========================================================================= *
+ * DRAWING                                    *
+ * ========================================================================= */
+
+/*
+ * All primitives take bmp_set_pixel() coordinates (y is the row index, row 0
+ * at the bottom), accept shapes partly or wholly outside the image, and
+ * clip once before writing whole spans.
+ */
+
+/**
+ * @brief Draws a 1-pixel Bresenham line from x0, y0 to x1, y1 (both ends included).
+ */
+BMAP_API void bmp_draw_line(BMPImage* image, int x0, int y0, int x1, int y1, Pixel color);
+
+/**
+ * @brief Draws an anti-aliased line (Xiaolin Wu) with sub-pixel endpoints,
+ * blending color in by coverage.
+ */
+BMAP_API void bmp_draw_line_aa(BMPImage* image, float x0, float y0, float x1, float y1, Pixel color);
+
+/**
+ * @brief Draws the outline of the rectangle x, y, w, h, thickness pixels wide
+ * inwards. Boxes too small for a hole are filled.
+ */
+BMAP_API void bmp_draw_rect(BMPImage* image, int x, int y, int w, int h, int thickness, Pixel color);
+
+/**
+ * @brief Draws a 1-pixel circle outline: the boundary of the disc filled by
+ * bmp_fill_circle() with the same radius.
+ */
+BMAP_API void bmp_draw_circle(BMPImage* image, int cx, int cy, int radius, Pixel color);
+
+/**
+ * @brief Fills the disc x^2 + y^2 <= r^2 + r around cx, cy, one span per row.
+ */
+BMAP_API void bmp_fill_circle(BMPImage* image, int cx, int cy, int radius, Pixel color);
+
+/**
+ * @brief Draws the closed outline through count vertices.
+ * @param points count x, y pairs.
+ */
+BMAP_API void bmp_draw_polygon(BMPImage* image, const int* points, int count, Pixel color);
+
+/**
+ * @brief Fills a polygon with the even-odd rule, sampling pixel centers on
+ * each scanline (self-intersecting polygons are allowed).
+ * @param points count x, y pairs.
+ * @return BMP_SUCCESS, BMP_ERR_INVALID_ARGUMENT for fewer than 3 vertices,
+ *         or BMP_ERR_MALLOC_FAILED for polygons with very many vertices.
+ */
+BMAP_API BMPError bmp_fill_polygon(BMPImage* image, const int* points, int count, Pixel color);
+
+
+/* ========================================================================= *
+ * COLOR SPACES                                 *
+ * ========================================================================= */
+
+/**
+ * @brief 8-bit color spaces reachable from the packed BGR layout.
+ * Converted pixels are byte triples c0, c1, c2 in the order listed; stored
+ * back into a Pixel, c0 takes the blue slot and c2 the red one.
+ */
+typedef enum {
+    BMP_COLOR_HSV = 0,             /**< Hue, saturation, value; hue 0..255 is one full turn */
+    BMP_COLOR_HSL = 1,             /**< Hue, saturation, lightness; same hue as HSV */
+    BMP_COLOR_YCBCR601 = 2,        /**< BT.601 Y, Cb, Cr, full range (JPEG/JFIF) */
+    BMP_COLOR_YCBCR601_LIMITED = 3,/**< BT.601 studio range: Y 16..235, Cb/Cr 16..240 */
+    BMP_COLOR_YCBCR709 = 4,        /**< BT.709 Y, Cb, Cr, full range */
+    BMP_COLOR_YCBCR709_LIMITED = 5,/**< BT.709 studio range: Y 16..235, Cb/Cr 16..240 */
+    BMP_COLOR_LAB = 6              /**< CIELAB (D65, sRGB input): L * 255 / 100, a + 128, b + 128 */
+} BMPColorSpace;
+
+/*
+ * YCbCr runs through a SIMD fixed-point matrix kernel; HSV, HSL and Lab are
+ * integer per-pixel code (Lab takes its gamma and cube-root steps from
+ * lookup tables). The row functions allocate nothing, so they can be called
+ * from a BMPRowVisitor to convert, process and convert back while the row
+ * is still in cache.
+ */
+
+/**
+ * @brief Converts count pixels to interleaved c0, c1, c2 triples.
+ * dst may alias src (in-place conversion of a row). Does nothing for an
+ * unknown space.
+ */
+BMAP_API void bmp_color_from_bgr(uint8_t* dst, const Pixel* src, int count, BMPColorSpace space);
+
+/**
+ * @brief Converts count interleaved c0, c1, c2 triples back to pixels.
+ * dst may alias src.
+ */
+BMAP_API void bmp_color_to_bgr(Pixel* dst, const uint8_t* src, int count, BMPColorSpace space);
+
+/**
+ * @brief Converts count pixels into three planes of count bytes each.
+ */
+BMAP_API void bmp_color_from_bgr_planar(uint8_t* c0, uint8_t* c1, uint8_t* c2, const Pixel* src, int count,
+                                        BMPColorSpace space);
+
+/**
+ * @brief Converts three planes of count bytes back to count pixels.
+ */
+BMAP_API void bmp_color_to_bgr_planar(Pixel* dst, const uint8_t* c0, const uint8_t* c1, const uint8_t* c2,
+                                      int count, BMPColorSpace space);
+
+/**
+ * @brief Converts every pixel of the image to space in place (see BMPColorSpace).
+ * @return BMP_SUCCESS, or BMP_ERR_INVALID_ARGUMENT for an unknown space.
+ */
+BMAP_API BMPError bmp_to_color_space(BMPImage* image, BMPColorSpace space);
+
+/**
+ * @brief Inverse of bmp_to_color_space(): converts c0, c1, c2 triples back to BGR.
+ * @return BMP_SUCCESS, or BMP_ERR_INVALID_ARGUMENT for an unknown space.
+ */
+BMAP_API BMPError bmp_from_color_space(BMPImage* image, BMPColorSpace space);
+
+
+/* ========================================================================= *
+ * YUV 4:2:0 FRAMES                              *
+ * ========================================================================= */
+
+/*
+ * Planar frames for video encoders and decoders. Planes are top-down (plane
+ * row 0 is the top image row, i.e. image row height - 1); the Y plane is
+ * width x height and each chroma plane (width + 1) / 2 x (height + 1) / 2,
+ * with every chroma sample covering a 2x2 block. space selects one of the
+ * four YCbCr matrices (video usually wants BMP_COLOR_YCBCR601_LIMITED or
+ * BMP_COLOR_YCBCR709_LIMITED). Strides are in bytes. The conversions walk
+ * the image two rows at a time and never allocate.
+ */
+
+/**
+ * @brief Writes the image as I420 (Y, then U = Cb and V = Cr planes).
+ * Chroma is the rounded mean of each 2x2 block; edge pixels repeat for odd sizes.
+ * @return BMP_SUCCESS, or BMP_ERR_INVALID_ARGUMENT for a NULL plane, a stride
+ *         narrower than its plane or a space other than YCbCr.
+ */
+BMAP_API BMPError bmp_to_i420(const BMPImage* image, BMPColorSpace space, uint8_t* y, int y_stride,
+                              uint8_t* u, int u_stride, uint8_t* v, int v_stride);
+
+/**
+ * @brief Writes the image as NV12: a Y plane and one interleaved Cb, Cr plane.
+ * @param uv_stride At least 2 * ((width + 1) / 2) bytes.
+ */
+BMAP_API BMPError bmp_to_nv12(const BMPImage* image, BMPColorSpace space, uint8_t* y, int y_stride,
+                              uint8_t* uv, int uv_stride);
+
+/**
+ * @brief Fills an existing image from I420 planes of the image's size.
+ * Each chroma sample is repeated over its 2x2 block.
+ */
+BMAP_API BMPError bmp_from_i420(BMPImage* image, BMPColorSpace space, const uint8_t* y, int y_stride,
+                                const uint8_t* u, int u_stride, const uint8_t* v, int v_stride);
+
+/**
+ * @brief Fills an existing image from NV12 planes of the image's size.
+ */
+BMAP_API BMPError bmp_from_nv12(BMPImage* image, BMPColorSpace space, const uint8_t* y, int y_stride,
+                                const uint8_t* uv, int uv_stride);
+
+
+/* ========================================================================= *
+ * OPERATION CHAINS                               *
+ * ========================================================================= */
+
+/**
+ * @brief Applies a sequence of operations to the image in order.
+ * @param image Pointer to the image structure.
+ * @param ops Array of operations.
+ * @param op_count Number of entries in ops.
+ * @return BMP_SUCCESS, or BMP_ERR_INVALID_ARGUMENT for an unknown operation.
+ */
+BMAP_API BMPError bmp_apply_operations(BMPImage* image, const BMPOperation* ops, int op_count);
+
+
+/* ========================================================================= *
+ * IMAGE COMPARISON                               *
+ * ========================================================================= */
+
+/** Maximum number of threads used by bmp_compare(). */
+#define BMP_COMPARE_MAX_THREADS 64
+
+/** Flags for bmp_compare(). */
+typedef enum {
+    BMP_COMPARE_SSIM = 1 << 0,     /**< Also compute SSIM */
+    BMP_COMPARE_EXACT = 1 << 1     /**< Stop at the first differing pixel (exact-match tests) */
+} BMPCompareFlags;
+
+/** Result of bmp_compare(). */
+typedef struct {
+    int max_abs_diff;              /**< Largest per-channel difference (0..255) */
+    double mse;                    /**< Mean squared error over all channels */
+    double psnr;                   /**< Peak signal-to-noise ratio in dB; INFINITY if identical */
+    double ssim;                   /**< Mean luma SSIM over 8x8 windows; NAN unless requested */
+    int first_x;                   /**< First differing pixel in data order, or -1 */
+    int first_y;
+} BMPCompareResult;
+
+/**
+ * @brief Compares two images of the same size.
+ * The difference pass is vectorized and split across threads by rows.
+ * With BMP_COMPARE_EXACT the scan stops at the first difference; only
+ * max_abs_diff (of that pixel) and first_x/first_y are filled, the other
+ * metrics are NAN and diff is left untouched.
+ * @param flags Bitwise OR of BMPCompareFlags values (0 for MSE and PSNR only).
+ * @param threads Number of threads to use (clamped to 1..BMP_COMPARE_MAX_THREADS).
+ * @param diff Optional image of the same size that receives |a - b| per channel (can be NULL).
+ * @param result Receives the metrics.
+ * @return BMP_SUCCESS, BMP_ERR_INVALID_ARGUMENT if the sizes differ, or
+ *         BMP_ERR_MALLOC_FAILED.
+ */
+BMAP_API BMPError bmp_compare(const BMPImage* a, const BMPImage* b, int flags, int threads,
+                              BMPImage* diff, BMPCompareResult* result);
+
+
+/* ========================================================================= *
+ * PERCEPTUAL HASHING                              *
+ * ========================================================================= */
+
+/** Maximum number of threads used by bmp_perceptual_hash_batch(). */
+#define BMP_PERCEPTUAL_MAX_THREADS 64
+
+/** Hash functions selectable for bmp_perceptual_hash_batch(). */
+typedef enum {
+    BMP_PERCEPTUAL_AHASH = 0,      /**< bmp_ahash() */
+    BMP_PERCEPTUAL_DHASH = 1,      /**< bmp_dhash() */
+    BMP_PERCEPTUAL_PHASH = 2       /**< bmp_phash() */
+} BMPPerceptualHash;
+
+/**
+ * @brief Average hash: 8x8 luma grid, one bit per cell brighter than the mean.
+ * Grid cells average a fixed number of evenly spaced samples, so large
+ * images hash in roughly constant time.
+ * @return 64-bit hash, or 0 for an empty image.
+ */
+BMAP_API uint64_t bmp_ahash(const BMPImage* image);
+
+/**
+ * @brief Difference hash: 9x8 luma grid, one bit per horizontal gradient sign.
+ * @return 64-bit hash, or 0 for an empty image.
+ */
+BMAP_API uint64_t bmp_dhash(const BMPImage* image);
+
+/**
+ * @brief Perceptual hash: the 8x8 lowest frequencies of a 32x32 luma DCT,
+ * one bit per coefficient above their median. Most robust of the three to
+ * scaling, compression and small edits.
+ * @return 64-bit hash, or 0 for an empty image.
+ */
+BMAP_API uint64_t bmp_phash(const BMPImage* image);
+
+/**
+ * @brief Hashes many images, split across threads.
+ * @param hashes Receives count hashes, in the order of images.
+ * @return BMP_SUCCESS, or BMP_ERR_INVALID_ARGUMENT.
+ */
+BMAP_API BMPError bmp_perceptual_hash_batch(const BMPImage* const* images, int count, BMPPerceptualHash kind,
+                                            int threads, uint64_t* hashes);
+
+/**
+ * @brief Returns the number of differing bits between two hashes (0..64).
+ * Near-duplicates typically differ in fewer than 10 bits.
+ */
+BMAP_API int bmp_hamming_distance(uint64_t a, uint64_t b);
+
+
+/* ========================================================================= *
+ * CONTENT HASHING                                *
+ * ========================================================================= */
+
+/** 128-bit content hash. */
+typedef struct {
+    uint64_t low;
+    uint64_t high;
+} BMPHash128;
+
+/**
+ * @brief Exact 64-bit hash of the pixel data, for deduplication and caching.
+ * XXH3 (seed 0) over the packed BGR rows, bottom row first; file padding
+ * and headers do not contribute, so the same pixels always hash the same.
+ * Matches XXH3_64bits() over image->data.
+ * @return Hash of the pixels (an empty image hashes as zero bytes).
+ */
+BMAP_API uint64_t bmp_hash(const BMPImage* image);
+
+/**
+ * @brief 128-bit variant of bmp_hash(); matches XXH3_128bits() over image->data.
+ */
+BMAP_API BMPHash128 bmp_hash128(const BMPImage* image);
+
+/**
+ * @brief Loads a BMP and hashes its pixels while each row is still in cache.
+ * Equivalent to bmp_load() followed by bmp_hash() / bmp_hash128(), without
+ * the second pass over memory.
+ * @param hash_out Receives the 64-bit hash (may be NULL).
+ * @param hash128_out Receives the 128-bit hash (may be NULL).
+ * @return Pointer to the loaded image, or NULL on failure.
+ */
+BMAP_API BMPImage* bmp_load_hashed(const char* filename, uint64_t* hash_out, BMPHash128* hash128_out,
+                                   BMPError* err_out);
+
+
+/* ========================================================================= *
+ * TILE CACHE                                   *
+ * ========================================================================= */
+
+/** Maximum length of an operation chain stored in a cache key. */
+#define BMP_CACHE_MAX_OPS 16
+
+/**
+ * @brief Configures the process-wide tile cache.
+ * Changing the tile size drops every cached tile; lowering the budget evicts
+ * least recently used tiles until the cache fits.
+ * @param budget_bytes Maximum number of pixel bytes kept in memory.
+ * @param tile_size Edge length of a square tile in pixels.
+ * @return BMP_SUCCESS, or BMP_ERR_INVALID_ARGUMENT if tile_size <= 0.
+ */
+BMAP_API BMPError bmp_cache_configure(size_t budget_bytes, int tile_size);
+
+/**
+ * @brief Returns a copy of one tile of a BMP file with the operations applied.
+ * Tiles are keyed by file identity (device, inode, size and modification
+ * time to the nanosecond), tile coordinates and operation chain, so a
+ * rewritten or replaced file is not served from stale entries; a same-size
+ * rewrite is only missed on file systems that keep coarser timestamps.
+ * Misses are read like bmp_load_region(), from the same open file the key was
+ * taken from. Edge tiles are clipped to the image.
+ * @param filename Path to the BMP file.
+ * @param tile_x Tile column (pixel x = tile_x * tile_size).
+ * @param tile_y Tile row (pixel y = tile_y * tile_size).
+ * @param ops Operations applied to the tile after loading (can be NULL).
+ * @param op_count Number of entries in ops (at most BMP_CACHE_MAX_OPS).
+ * @param err_out Pointer to store error status (can be NULL).
+ * @return Newly allocated tile owned by the caller (free with bmp_free()),
+ *         or NULL on failure.
+ */
+BMAP_API BMPImage* bmp_cache_get_tile(const char* filename, int tile_x, int tile_y,
+                                      const BMPOperation* ops, int op_count, BMPError* err_out);
+
+/**
+ * @brief Drops every cached tile and releases its memory.
+ */
+BMAP_API void bmp_cache_clear(void);
+
+/**
+ * @brief Returns the number of pixel bytes currently held by the tile cache.
+ */
+BMAP_API size_t bmp_cache_usage(void);
+
+
+/* ========================================================================= *
+ * DAEMON & CLIENT                               *
+ * ========================================================================= */
+
+/** Socket path used when NULL is passed to bmp_daemon_run() or bmp_client_connect(). */
+#define BMP_DAEMON_SOCKET "/tmp/bmapd.sock"
+
+/**
+ * @brief Serves operation chains to local clients until bmp_daemon_stop().
+ * Listens on a UNIX domain socket with one fixed pool of worker threads, so
+ * many processes share one set of cores instead of each spinning up its own.
+ * Pixels are never sent over the socket: clients pass a descriptor of the
+ * shared memory holding the image and the workers process it in place.
+ * @param socket_path Socket to create (NULL for BMP_DAEMON_SOCKET); a stale
+ *                    socket left by a previous run is replaced.
+ * @param threads Worker threads (<= 0 for the number of online CPUs).
+ * @return BMP_SUCCESS after a clean stop, or BMP_ERR_IO if the socket could
+ *         not be set up.
+ */
+BMAP_API BMPError bmp_daemon_run(const char* socket_path, int threads);
+
+/**
+ * @brief Makes a running bmp_daemon_run() return. Async-signal-safe.
+ */
+BMAP_API void bmp_daemon_stop(void);
+
+/** Opaque connection to a bmap daemon. */
+typedef struct BMPClient BMPClient;
+
+/**
+ * @brief Connects to a daemon started with bmp_daemon_run().
+ * One connection may be shared between threads; requests on it are serialized.
+ * @param socket_path Daemon socket (NULL for BMP_DAEMON_SOCKET).
+ * @param err_out Pointer to store error status (can be NULL).
+ * @return New connection (close with bmp_client_close()), or NULL on failure.
+ */
+BMAP_API BMPClient* bmp_client_connect(const char* socket_path, BMPError* err_out);
+
+/**
+ * @brief Closes a daemon connection.
+ */
+BMAP_API void bmp_client_close(BMPClient* client);
+
+/**
+ * @brief Same as bmp_create(), but the pixels live in shared memory the
+ * daemon can map directly. Free with bmp_free().
+ */
+BMAP_API BMPImage* bmp_client_create(int width, int height, BMPError* err_out);
+
+/**
+ * @brief Same as bmp_load(), but loads into shared memory the daemon can map
+ * directly. Free with bmp_free().
+ */
+BMAP_API BMPImage* bmp_client_load(const char* filename, BMPError* err_out);
+
+/**
+ * @brief Runs bmp_apply_operations() in the daemon.
+ * Images from bmp_client_load() and bmp_client_create() are processed in
+ * place without copying; heap and bmp_load_mapped() images are copied into
+ * shared memory for the duration of the call, because the daemon only maps
+ * buffers whose size is sealed.
+ * @return BMP_SUCCESS, BMP_ERR_INVALID_ARGUMENT for a bad image or operation,
+ *         or BMP_ERR_IO if the daemon could not be reached.
+ */
+BMAP_API BMPError bmp_client_apply_operations(BMPClient* client, BMPImage* image,
+                                              const BMPOperation* ops, int op_count);
+
+/** bmp_grayscale() in the daemon. */
+BMAP_API BMPError bmp_client_grayscale(BMPClient* client, BMPImage* image);
+
+/** bmp_invert() in the daemon. */
+BMAP_API BMPError bmp_client_invert(BMPClient* client, BMPImage* image);
+
+/** bmp_flip_horizontal() in the daemon. */
+BMAP_API BMPError bmp_client_flip_horizontal(BMPClient* client, BMPImage* image);
+
+/** bmp_rotate_right() in the daemon. */
+BMAP_API BMPError bmp_client_rotate_right(BMPClient* client, BMPImage* image);
+
+
+/* ========================================================================= *
+ * CPU DISPATCH                                 *
+ * ========================================================================= */
+
+/**
+ * @brief Returns the instruction set used by the pixel kernels.
+ * One of "scalar", "sse4.1", "avx2" or "avx512". Chosen once from the CPU
+ * features; the BMAP_FORCE_ISA environment variable caps the choice.
+ */
+BMAP_API const char* bmp_active_isa(void);
+
+
+/* ========================================================================= *
+ * LOOKUP TABLES & COEFFICIENTS                        *
+ * ========================================================================= */
+
+/** BT.601 luma weights in 16.16 fixed point (sum to 65536). */
+#define BMP_LUMA601_R 19595
+#define BMP_LUMA601_G 38470
+#define BMP_LUMA601_B 7471
+
+/** BT.709 luma weights in 16.16 fixed point (sum to 65536). */
+#define BMP_LUMA709_R 13933
+#define BMP_LUMA709_G 46871
+#define BMP_LUMA709_B 4732
+
+/**
+ * @brief sRGB-encoded 8-bit value to 16-bit linear light (0..65535).
+ */
+BMAP_API extern const uint16_t bmp_srgb_to_linear16[256];
+
+/**
+ * @brief 12-bit linear light to sRGB-encoded 8-bit value.
+ * Index with (linear16 >> 4); round-trips every 8-bit value exactly.
+ */
+BMAP_API extern const uint8_t bmp_linear12_to_srgb[4096];
+
+/**
+ * @brief CIELAB companding f(t) (cube root, linear near black) in 16-bit.
+ * Index with (t16 >> 4), where t16 is a white-normalized X, Y or Z in 16-bit
+ * linear light; entries are round(65535 * f) at the bucket centre.
+ */
+BMAP_API extern const uint16_t bmp_lab_f16[4096];
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif // BMAP_H
\ No newline at end of file
@@ -0,0 +1,336 @@
+/**
+ * @file bmap.hpp
+ * @brief Header-only C++17 layer over the bmap C API.
+ * Provides a move-only owning Image, non-owning views and row iteration that
+ * compiles down to plain pointer loops. No extra library needs to be linked.
+ * @author Arda Aksu
+ * @date 2026
+ */
+
+#ifndef BMAP_HPP
+#define BMAP_HPP
+
+#include "bmap.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace bmap {
+
+/* ========================================================================= *
+ * ERRORS                                     *
+ * ========================================================================= */
+
+/**
+ * @brief Exception carrying the BMPError reported by the C library.
+ */
+class Error : public std::runtime_error {
+public:
+    Error(BMPError code, const std::string& what)
+        : std::runtime_error(what + " (BMPError " + std::to_string(static_cast<int>(code)) + ")"),
+          code_(code) {}
+
+    BMPError code() const noexcept { return code_; }
+
+private:
+    BMPError code_;
+};
+
+
+/* ========================================================================= *
+ * VIEWS                                      *
+ * ========================================================================= */
+
+/**
+ * @brief Non-owning contiguous range of pixels (a minimal C++17 span).
+ */
+template <class T>
+class Span {
+public:
+    using value_type = std::remove_const_t<T>;
+    using iterator = T*;
+
+    constexpr Span() noexcept = default;
+    constexpr Span(T* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr std::size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr T* begin() const noexcept { return data_; }
+    constexpr T* end() const noexcept { return data_ + size_; }
+    constexpr T& operator[](std::size_t i) const noexcept { return data_[i]; }
+
+private:
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/**
+ * @brief Non-owning 2D window into pixel memory.
+ * The stride is measured in pixels, so a view can describe a sub-rectangle of
+ * a larger image without copying. Accessors do no bounds checking.
+ */
+template <class T>
+class BasicImageView {
+public:
+    /** Random-access iterator over the rows of a view; dereferences to a Span. */
+    class RowIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Span<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Span<T>;
+
+        constexpr RowIterator() noexcept = default;
+        constexpr RowIterator(T* row, int width, std::ptrdiff_t stride) noexcept
+            : row_(row), width_(width), stride_(stride) {}
+
+        constexpr Span<T> operator*() const noexcept { return Span<T>(row_, static_cast<std::size_t>(width_)); }
+        constexpr Span<T> operator[](difference_type n) const noexcept { return *(*this + n); }
+
+        constexpr RowIterator& operator++() noexcept { row_ += stride_; return *this; }
+        constexpr RowIterator operator++(int) noexcept { RowIterator t = *this; ++*this; return t; }
+        constexpr RowIterator& operator--() noexcept { row_ -= stride_; return *this; }
+        constexpr RowIterator operator--(int) noexcept { RowIterator t = *this; --*this; return t; }
+        constexpr RowIterator& operator+=(difference_type n) noexcept { row_ += n * stride_; return *this; }
+        constexpr RowIterator& operator-=(difference_type n) noexcept { row_ -= n * stride_; return *this; }
+
+        friend constexpr RowIterator operator+(RowIterator it, difference_type n) noexcept { return it += n; }
+        friend constexpr RowIterator operator+(difference_type n, RowIterator it) noexcept { return it += n; }
+        friend constexpr RowIterator operator-(RowIterator it, difference_type n) noexcept { return it -= n; }
+        friend constexpr difference_type operator-(const RowIterator& a, const RowIterator& b) noexcept {
+            return a.stride_ ? (a.row_ - b.row_) / a.stride_ : 0;
+        }
+
+        friend constexpr bool operator==(const RowIterator& a, const RowIterator& b) noexcept { return a.row_ == b.row_; }
+        friend constexpr bool operator!=(const RowIterator& a, const RowIterator& b) noexcept { return a.row_ != b.row_; }
+        friend constexpr bool operator<(const RowIterator& a, const RowIterator& b) noexcept { return a.row_ < b.row_; }
+        friend constexpr bool operator>(const RowIterator& a, const RowIterator& b) noexcept { return a.row_ > b.row_; }
+        friend constexpr bool operator<=(const RowIterator& a, const RowIterator& b) noexcept { return a.row_ <= b.row_; }
+        friend constexpr bool operator>=(const RowIterator& a, const RowIterator& b) noexcept { return a.row_ >= b.row_; }
+
+    private:
+        T* row_ = nullptr;
+        int width_ = 0;
+        std::ptrdiff_t stride_ = 0;
+    };
+
+    /** Lightweight range object returned by rows(). */
+    struct Rows {
+        RowIterator first, last;
+        constexpr RowIterator begin() const noexcept { return first; }
+        constexpr RowIterator end() const noexcept { return last; }
+    };
+
+    constexpr BasicImageView() noexcept = default;
+    constexpr BasicImageView(T* data, int width, int height, std::ptrdiff_t stride) noexcept
+        : data_(data), width_(width), height_(height), stride_(stride) {}
+    constexpr BasicImageView(T* data, int width, int height) noexcept
+        : BasicImageView(data, width, height, width) {}
+
+    /** Mutable views convert implicitly to const views. */
+    template <class U, class = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+    constexpr BasicImageView(const BasicImageView<U>& other) noexcept
+        : data_(other.data()), width_(other.width()), height_(other.height()), stride_(other.stride()) {}
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr int width() const noexcept { return width_; }
+    constexpr int height() const noexcept { return height_; }
+    constexpr std::ptrdiff_t stride() const noexcept { return stride_; }
+    constexpr bool empty() const noexcept { return !data_ || width_ <= 0 || height_ <= 0; }
+    /** True when rows are back to back, i.e. the pixels form one flat array. */
+    constexpr bool contiguous() const noexcept { return stride_ == width_; }
+
+    constexpr T* row_ptr(int y) const noexcept { return data_ + y * stride_; }
+    constexpr Span<T> row(int y) const noexcept { return Span<T>(row_ptr(y), static_cast<std::size_t>(width_)); }
+    constexpr T& operator()(int x, int y) const noexcept { return row_ptr(y)[x]; }
+
+    constexpr Rows rows() const noexcept {
+        return Rows{RowIterator(data_, width_, stride_), RowIterator(data_ + height_ * stride_, width_, stride_)};
+    }
+
+    /**
+     * @brief Returns a view of a sub-rectangle, clipped to this view.
+     */
+    constexpr BasicImageView subview(int x, int y, int w, int h) const noexcept {
+        int x0 = x < 0 ? 0 : x, y0 = y < 0 ? 0 : y;
+        int x1 = (w > width_ - x) ? width_ : x + w;
+        int y1 = (h > height_ - y) ? height_ : y + h;
+        if (x0 >= x1 || y0 >= y1) return BasicImageView();
+        return BasicImageView(row_ptr(y0) + x0, x1 - x0, y1 - y0, stride_);
+    }
+
+private:
+    T* data_ = nullptr;
+    int width_ = 0;
+    int height_ = 0;
+    std::ptrdiff_t stride_ = 0;
+};
+
+using ImageView = BasicImageView<Pixel>;
+using ConstImageView = BasicImageView<const Pixel>;
+
+/**
+ * @brief Marker base of lazily evaluated pixel expressions (see bmap_expr.hpp).
+ * Expressions provide evaluate_into(ImageView), which Image assignment calls.
+ */
+struct ExpressionBase {};
+
+template <class E>
+constexpr bool is_expression_v = std::is_base_of_v<ExpressionBase, E>;
+
+
+/* ========================================================================= *
+ * OWNING IMAGE                                 *
+ * ========================================================================= */
+
+/**
+ * @brief Move-only owner of a BMPImage; bmp_free() runs on destruction.
+ * Copies must be requested explicitly with clone(), so accidental deep copies
+ * cannot happen. Transform methods return *this for chaining.
+ */
+class Image {
+public:
+    Image() noexcept = default;
+
+    /** Takes ownership of an image allocated by the C API. */
+    explicit Image(BMPImage* owned) noexcept : img_(owned) {}
+
+    /** Allocates an image with uninitialized pixels. */
+    Image(int width, int height) : img_(create(width, height)) {}
+
+    Image(const Image&) = delete;
+    Image& operator=(const Image&) = delete;
+
+    Image(Image&& other) noexcept : img_(std::exchange(other.img_, nullptr)) {}
+    Image& operator=(Image&& other) noexcept {
+        if (this != &other) reset(std::exchange(other.img_, nullptr));
+        return *this;
+    }
+
+    /**
+     * @brief Evaluates a point expression into this image in one fused pass.
+     * The expression may read this image itself (e.g. img = invert(img)).
+     */
+    template <class E, class = std::enable_if_t<is_expression_v<E>>>
+    Image& operator=(const E& expr) {
+        expr.evaluate_into(view());
+        return *this;
+    }
+
+    ~Image() { bmp_free(img_); }
+
+    static Image load(const std::string& filename) {
+        BMPError err = BMP_SUCCESS;
+        BMPImage* img = bmp_load(filename.c_str(), &err);
+        return Image(check(img, err, "bmp_load: " + filename));
+    }
+
+    static Image load_mapped(const std::string& filename) {
+        BMPError err = BMP_SUCCESS;
+        BMPImage* img = bmp_load_mapped(filename.c_str(), &err);
+        return Image(check(img, err, "bmp_load_mapped: " + filename));
+    }
+
+    static Image load_region(const std::string& filename, int x, int y, int w, int h, int threads = 1) {
+        BMPError err = BMP_SUCCESS;
+        BMPImage* img = bmp_load_region_parallel(filename.c_str(), x, y, w, h, threads, &err);
+        return Image(check(img, err, "bmp_load_region: " + filename));
+    }
+
+    void save(const std::string& filename) const {
+        BMPError err = img_ ? bmp_save(img_, filename.c_str()) : BMP_ERR_INVALID_ARGUMENT;
+        if (err != BMP_SUCCESS) throw Error(err, "bmp_save: " + filename);
+    }
+
+    /** Explicit deep copy. */
+    Image clone() const {
+        BMPError err = BMP_SUCCESS;
+        BMPImage* img = bmp_clone(img_, &err);
+        return Image(check(img, err, "bmp_clone"));
+    }
+
+    /* --- Ownership --- */
+
+    BMPImage* get() const noexcept { return img_; }
+    BMPImage* release() noexcept { return std::exchange(img_, nullptr); }
+    void reset(BMPImage* owned = nullptr) noexcept {
+        bmp_free(std::exchange(img_, owned));
+    }
+    explicit operator bool() const noexcept { return img_ != nullptr && img_->data != nullptr; }
+
+    /* --- Geometry & Access --- */
+
+    int width() const noexcept { return img_ ? img_->width : 0; }
+    int height() const noexcept { return img_ ? img_->height : 0; }
+    Pixel* data() noexcept { return img_ ? img_->data : nullptr; }
+    const Pixel* data() const noexcept { return img_ ? img_->data : nullptr; }
+
+    ImageView view() noexcept { return ImageView(data(), width(), height()); }
+    ConstImageView view() const noexcept { return ConstImageView(data(), width(), height()); }
+    operator ImageView() noexcept { return view(); }
+    operator ConstImageView() const noexcept { return view(); }
+
+    Span<Pixel> row(int y) noexcept { return view().row(y); }
+    Span<const Pixel> row(int y) const noexcept { return view().row(y); }
+    ImageView::Rows rows() noexcept { return view().rows(); }
+    ConstImageView::Rows rows() const noexcept { return view().rows(); }
+
+    Pixel& operator()(int x, int y) noexcept { return img_->data[static_cast<std::size_t>(y) * img_->width + x]; }
+    const Pixel& operator()(int x, int y) const noexcept { return img_->data[static_cast<std::size_t>(y) * img_->width + x]; }
+
+    /* --- Operations --- */
+
+    Image& grayscale() noexcept { bmp_grayscale(img_); return *this; }
+    Image& invert() noexcept { bmp_invert(img_); return *this; }
+    Image& rotate_right() noexcept { bmp_rotate_right(img_); return *this; }
+    Image& flip_horizontal() noexcept { bmp_flip_horizontal(img_); return *this; }
+
+private:
+    static BMPImage* create(int width, int height) {
+        BMPError err = BMP_SUCCESS;
+        BMPImage* img = bmp_create(width, height, &err);
+        return check(img, err, "bmp_create");
+    }
+
+    static BMPImage* check(BMPImage* img, BMPError err, const std::string& what) {
+        if (!img) throw Error(err, what);
+        return img;
+    }
+
+    BMPImage* img_ = nullptr;
+};
+
+
+/* ========================================================================= *
+ * COMPOSITING                                  *
+ * ========================================================================= */
+
+/**
+ * @brief Blends src into dst row by row; both views may have any stride, so
+ * subviews composite only their own window.
+ * @param alpha Optional per-pixel coverage, alpha_stride bytes per row
+ *              (0 means src.width()), scaled by opacity.
+ * @param flags Bitwise OR of BMPMixFlags values, e.g. BMP_MIX_LINEAR_LIGHT.
+ */
+inline void composite(ImageView dst, ConstImageView src, BMPBlendMode mode, std::uint8_t opacity = 255,
+                      const std::uint8_t* alpha = nullptr, std::ptrdiff_t alpha_stride = 0, int flags = 0) {
+    if (dst.width() != src.width() || dst.height() != src.height()) {
+        throw Error(BMP_ERR_INVALID_ARGUMENT, "composite: view sizes differ");
+    }
+    if (alpha_stride == 0) alpha_stride = src.width();
+    for (int y = 0; y < dst.height(); y++) {
+        bmp_blend_row(dst.row_ptr(y), src.row_ptr(y), alpha ? alpha + y * alpha_stride : nullptr,
+                      dst.width(), opacity, mode, flags);
+    }
+}
+
+} // namespace bmap
+
+#endif // BMAP_HPP
@@ -0,0 +1,288 @@
+/**
+ * @file bmap_expr.hpp
+ * @brief Expression templates for fused point operations in the C++ layer.
+ * Writing img = invert(gray(img)) * contrast + bias builds a small expression
+ * tree at compile time; nothing is computed until the assignment, which runs a
+ * single loop over the pixels with every operator inlined into its body.
+ * @author Arda Aksu
+ * @date 2026
+ */
+
+#ifndef BMAP_EXPR_HPP
+#define BMAP_EXPR_HPP
+
+#include "bmap.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+namespace bmap {
+
+/* ========================================================================= *
+ * EXPRESSION NODES                              *
+ * ========================================================================= */
+
+/**
+ * @brief Intermediate per-pixel value; channels are unclamped until stored.
+ */
+struct Color {
+    float blue;
+    float green;
+    float red;
+};
+
+/** Channel identifiers for channel<>(). */
+enum class Channel { Blue, Green, Red };
+
+/**
+ * @brief CRTP base of every expression node.
+ * Nodes implement at(x, y) returning a Color and fits(w, h) reporting whether
+ * the images they read have the given size.
+ */
+template <class Derived>
+struct Expr : ExpressionBase {
+    const Derived& self() const noexcept { return static_cast<const Derived&>(*this); }
+
+    /**
+     * @brief Runs the fused loop: one read of every source, one clamped store.
+     * Point expressions only read the pixel they write, so dst may alias a source.
+     * @throws Error with BMP_ERR_INVALID_ARGUMENT if a source size differs from dst.
+     */
+    void evaluate_into(ImageView dst) const {
+        const Derived& expr = self();
+        if (!expr.fits(dst.width(), dst.height())) {
+            throw Error(BMP_ERR_INVALID_ARGUMENT, "expression size does not match destination");
+        }
+
+        for (int y = 0; y < dst.height(); y++) {
+            Pixel* out = dst.row_ptr(y);
+            for (int x = 0; x < dst.width(); x++) {
+                Color c = expr.at(x, y);
+                out[x].blue = store(c.blue);
+                out[x].green = store(c.green);
+                out[x].red = store(c.red);
+            }
+        }
+    }
+
+private:
+    /* NaN (e.g. 0 / 0) fails every comparison, so it is caught by the first test */
+    static std::uint8_t store(float v) noexcept {
+        v = !(v >= 0.0f) ? 0.0f : (v > 255.0f ? 255.0f : v);
+        return static_cast<std::uint8_t>(v + 0.5f);
+    }
+};
+
+/** Leaf node reading pixels from a view. */
+class Source : public Expr<Source> {
+public:
+    explicit Source(ConstImageView view) noexcept : view_(view) {}
+
+    Color at(int x, int y) const noexcept {
+        const Pixel& p = view_.row_ptr(y)[x];
+        return Color{static_cast<float>(p.blue), static_cast<float>(p.green), static_cast<float>(p.red)};
+    }
+    bool fits(int w, int h) const noexcept { return view_.width() == w && view_.height() == h; }
+
+private:
+    ConstImageView view_;
+};
+
+/** Leaf node producing the same value for every channel of every pixel. */
+class Constant : public Expr<Constant> {
+public:
+    explicit Constant(float value) noexcept : value_(value) {}
+
+    Color at(int, int) const noexcept { return Color{value_, value_, value_}; }
+    bool fits(int, int) const noexcept { return true; }
+
+private:
+    float value_;
+};
+
+namespace detail {
+
+/* Images and views become Source leaves, numbers become Constant leaves */
+inline Source as_expr(const Image& img) noexcept { return Source(img.view()); }
+inline Source as_expr(ConstImageView view) noexcept { return Source(view); }
+inline Source as_expr(ImageView view) noexcept { return Source(view); }
+template <class T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
+Constant as_expr(T value) noexcept { return Constant(static_cast<float>(value)); }
+template <class E>
+const E& as_expr(const Expr<E>& expr) noexcept { return expr.self(); }
+
+template <class T>
+using expr_t = std::decay_t<decltype(as_expr(std::declval<const T&>()))>;
+
+template <class T>
+constexpr bool is_operand_v = is_expression_v<T> || std::is_arithmetic_v<T> ||
+                              std::is_same_v<T, Image> || std::is_same_v<T, ImageView> ||
+                              std::is_same_v<T, ConstImageView>;
+
+/* At least one side of a binary operator must already be an expression or image */
+template <class L, class R>
+constexpr bool is_binary_v = is_operand_v<L> && is_operand_v<R> &&
+                             !(std::is_arithmetic_v<L> && std::is_arithmetic_v<R>);
+
+struct Add { static float apply(float a, float b) noexcept { return a + b; } };
+struct Sub { static float apply(float a, float b) noexcept { return a - b; } };
+struct Mul { static float apply(float a, float b) noexcept { return a * b; } };
+struct Div { static float apply(float a, float b) noexcept { return a / b; } };
+
+} // namespace detail
+
+/** Channel-wise arithmetic between two nodes. */
+template <class Op, class L, class R>
+class Binary : public Expr<Binary<Op, L, R>> {
+public:
+    Binary(const L& lhs, const R& rhs) noexcept : lhs_(lhs), rhs_(rhs) {}
+
+    Color at(int x, int y) const noexcept {
+        Color a = lhs_.at(x, y);
+        Color b = rhs_.at(x, y);
+        return Color{Op::apply(a.blue, b.blue), Op::apply(a.green, b.green), Op::apply(a.red, b.red)};
+    }
+    bool fits(int w, int h) const noexcept { return lhs_.fits(w, h) && rhs_.fits(w, h); }
+
+private:
+    L lhs_;
+    R rhs_;
+};
+
+/** Channel average, matching bmp_grayscale(). */
+template <class E>
+class Gray : public Expr<Gray<E>> {
+public:
+    explicit Gray(const E& inner) noexcept : inner_(inner) {}
+
+    Color at(int x, int y) const noexcept {
+        Color c = inner_.at(x, y);
+        float avg = std::floor((c.blue + c.green + c.red) / 3.0f);
+        return Color{avg, avg, avg};
+    }
+    bool fits(int w, int h) const noexcept { return inner_.fits(w, h); }
+
+private:
+    E inner_;
+};
+
+/** Negative, matching bmp_invert(). */
+template <class E>
+class Invert : public Expr<Invert<E>> {
+public:
+    explicit Invert(const E& inner) noexcept : inner_(inner) {}
+
+    Color at(int x, int y) const noexcept {
+        Color c = inner_.at(x, y);
+        return Color{255.0f - c.blue, 255.0f - c.green, 255.0f - c.red};
+    }
+    bool fits(int w, int h) const noexcept { return inner_.fits(w, h); }
+
+private:
+    E inner_;
+};
+
+/** Clamps every channel to [lo, hi] before further arithmetic. */
+template <class E>
+class Clamp : public Expr<Clamp<E>> {
+public:
+    Clamp(const E& inner, float lo, float hi) noexcept : inner_(inner), lo_(lo), hi_(hi) {}
+
+    Color at(int x, int y) const noexcept {
+        Color c = inner_.at(x, y);
+        return Color{limit(c.blue), limit(c.green), limit(c.red)};
+    }
+    bool fits(int w, int h) const noexcept { return inner_.fits(w, h); }
+
+private:
+    float limit(float v) const noexcept { return v < lo_ ? lo_ : (v > hi_ ? hi_ : v); }
+
+    E inner_;
+    float lo_, hi_;
+};
+
+/** Broadcasts one channel to all three. */
+template <Channel C, class E>
+class ChannelSelect : public Expr<ChannelSelect<C, E>> {
+public:
+    explicit ChannelSelect(const E& inner) noexcept : inner_(inner) {}
+
+    Color at(int x, int y) const noexcept {
+        Color c = inner_.at(x, y);
+        float v = (C == Channel::Blue) ? c.blue : (C == Channel::Green) ? c.green : c.red;
+        return Color{v, v, v};
+    }
+    bool fits(int w, int h) const noexcept { return inner_.fits(w, h); }
+
+private:
+    E inner_;
+};
+
+/** Builds a pixel from the blue of one node, the green of another and the red of a third. */
+template <class B, class G, class R>
+class Merge : public Expr<Merge<B, G, R>> {
+public:
+    Merge(const B& b, const G& g, const R& r) noexcept : b_(b), g_(g), r_(r) {}
+
+    Color at(int x, int y) const noexcept {
+        return Color{b_.at(x, y).blue, g_.at(x, y).green, r_.at(x, y).red};
+    }
+    bool fits(int w, int h) const noexcept { return b_.fits(w, h) && g_.fits(w, h) && r_.fits(w, h); }
+
+private:
+    B b_;
+    G g_;
+    R r_;
+};
+
+
+/* ========================================================================= *
+ * OPERATORS & FUNCTIONS                           *
+ * ========================================================================= */
+
+#define BMAP_EXPR_BINARY_OPERATOR(op, Tag)                                                   \
+    template <class L, class R, class = std::enable_if_t<detail::is_binary_v<L, R>>>         \
+    Binary<detail::Tag, detail::expr_t<L>, detail::expr_t<R>> operator op(const L& lhs,    \
+                                                                          const R& rhs) {  \
+        return {detail::as_expr(lhs), detail::as_expr(rhs)};                                \
+    }
+
+BMAP_EXPR_BINARY_OPERATOR(+, Add)
+BMAP_EXPR_BINARY_OPERATOR(-, Sub)
+BMAP_EXPR_BINARY_OPERATOR(*, Mul)
+BMAP_EXPR_BINARY_OPERATOR(/, Div)
+
+#undef BMAP_EXPR_BINARY_OPERATOR
+
+template <class T, class = std::enable_if_t<detail::is_operand_v<T>>>
+Gray<detail::expr_t<T>> gray(const T& src) { return Gray<detail::expr_t<T>>(detail::as_expr(src)); }
+
+template <class T, class = std::enable_if_t<detail::is_operand_v<T>>>
+Invert<detail::expr_t<T>> invert(const T& src) { return Invert<detail::expr_t<T>>(detail::as_expr(src)); }
+
+template <class T, class = std::enable_if_t<detail::is_operand_v<T>>>
+Clamp<detail::expr_t<T>> clamp(const T& src, float lo = 0.0f, float hi = 255.0f) {
+    return Clamp<detail::expr_t<T>>(detail::as_expr(src), lo, hi);
+}
+
+template <Channel C, class T, class = std::enable_if_t<detail::is_operand_v<T>>>
+ChannelSelect<C, detail::expr_t<T>> channel(const T& src) {
+    return ChannelSelect<C, detail::expr_t<T>>(detail::as_expr(src));
+}
+
+template <class B, class G, class R>
+Merge<detail::expr_t<B>, detail::expr_t<G>, detail::expr_t<R>> merge(const B& b, const G& g, const R& r) {
+    return {detail::as_expr(b), detail::as_expr(g), detail::as_expr(r)};
+}
+
+/**
+ * @brief Evaluates an expression into any view (e.g. a subview ROI).
+ */
+template <class E>
+void assign(ImageView dst, const Expr<E>& expr) {
+    expr.evaluate_into(dst);
+}
+
+} // namespace bmap
+
+#endif // BMAP_EXPR_HPP
@@ -0,0 +1,220 @@
+/**
+ * @file bmap_formats.hpp
+ * @brief Pixel-format templated kernels for the C++ layer.
+ * Each filter and transform is instantiated per format, so channel layout is
+ * resolved at compile time and inner loops carry no format switches. Code
+ * holding a runtime format picks the instantiation once with dispatch().
+ * @author Arda Aksu
+ * @date 2026
+ */
+
+#ifndef BMAP_FORMATS_HPP
+#define BMAP_FORMATS_HPP
+
+#include "bmap.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+namespace bmap {
+
+/* ========================================================================= *
+ * PIXEL FORMATS                                *
+ * ========================================================================= */
+
+/**
+ * @brief Runtime tag for the supported memory layouts.
+ */
+enum class PixelFormat {
+    BGR24,      /**< Packed B, G, R bytes (the BMPImage layout) */
+    BGRA32,     /**< Packed B, G, R, A bytes */
+    Gray8,      /**< One luminance byte per pixel */
+    Planar      /**< Three separate B, G and R byte planes */
+};
+
+#pragma pack(push, 1)
+/**
+ * @brief Packed 32-bit pixel with alpha, in BMP channel order.
+ */
+struct PixelBGRA {
+    std::uint8_t blue;
+    std::uint8_t green;
+    std::uint8_t red;
+    std::uint8_t alpha;
+};
+#pragma pack(pop)
+
+/**
+ * @brief Three equally sized byte planes holding B, G and R.
+ */
+struct PlanarView {
+    BasicImageView<std::uint8_t> blue;
+    BasicImageView<std::uint8_t> green;
+    BasicImageView<std::uint8_t> red;
+
+    int width() const noexcept { return blue.width(); }
+    int height() const noexcept { return blue.height(); }
+};
+
+/** Compile-time format descriptors; view_type is what the kernels operate on. */
+namespace formats {
+
+struct BGR24 {
+    using pixel_type = Pixel;
+    using view_type = BasicImageView<Pixel>;
+    static constexpr PixelFormat id = PixelFormat::BGR24;
+};
+
+struct BGRA32 {
+    using pixel_type = PixelBGRA;
+    using view_type = BasicImageView<PixelBGRA>;
+    static constexpr PixelFormat id = PixelFormat::BGRA32;
+};
+
+struct Gray8 {
+    using pixel_type = std::uint8_t;
+    using view_type = BasicImageView<std::uint8_t>;
+    static constexpr PixelFormat id = PixelFormat::Gray8;
+};
+
+struct Planar {
+    using pixel_type = std::uint8_t;
+    using view_type = PlanarView;
+    static constexpr PixelFormat id = PixelFormat::Planar;
+};
+
+} // namespace formats
+
+/**
+ * @brief Calls fn with the format tag matching a runtime PixelFormat.
+ * This is the single per-call branch; everything inside fn is specialized.
+ */
+template <class Fn>
+decltype(auto) dispatch(PixelFormat format, Fn&& fn) {
+    switch (format) {
+        case PixelFormat::BGRA32: return fn(formats::BGRA32{});
+        case PixelFormat::Gray8:  return fn(formats::Gray8{});
+        case PixelFormat::Planar: return fn(formats::Planar{});
+        case PixelFormat::BGR24:
+        default:                  return fn(formats::BGR24{});
+    }
+}
+
+
+/* ========================================================================= *
+ * KERNELS                                    *
+ * ========================================================================= */
+
+namespace kernels {
+
+namespace detail {
+
+template <class T>
+constexpr bool is_packed_color_v = std::is_same_v<T, Pixel> || std::is_same_v<T, PixelBGRA>;
+
+/* Same rounding as bmp_grayscale(): plain channel average */
+constexpr std::uint8_t average(unsigned b, unsigned g, unsigned r) noexcept {
+    return static_cast<std::uint8_t>((b + g + r) / 3);
+}
+
+template <class T>
+void flip_rows(BasicImageView<T> view) noexcept {
+    for (auto row : view.rows()) std::reverse(row.begin(), row.end());
+}
+
+template <class T>
+void rotate_into(BasicImageView<const T> src, BasicImageView<T> dst) noexcept {
+    const int h = src.height();
+    for (int i = 0; i < h; i++) {
+        const T* in = src.row_ptr(i);
+        for (int j = 0; j < src.width(); j++) dst(h - 1 - i, j) = in[j];
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Inverts color channels in place; alpha is left untouched.
+ */
+template <class F>
+void invert(typename F::view_type view) noexcept {
+    if constexpr (std::is_same_v<F, formats::Planar>) {
+        invert<formats::Gray8>(view.blue);
+        invert<formats::Gray8>(view.green);
+        invert<formats::Gray8>(view.red);
+    } else {
+        for (auto row : view.rows()) {
+            for (auto& p : row) {
+                if constexpr (std::is_same_v<F, formats::Gray8>) {
+                    p = static_cast<std::uint8_t>(255 - p);
+                } else {
+                    p.blue = static_cast<std::uint8_t>(255 - p.blue);
+                    p.green = static_cast<std::uint8_t>(255 - p.green);
+                    p.red = static_cast<std::uint8_t>(255 - p.red);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Converts to grayscale in place (no-op for Gray8).
+ */
+template <class F>
+void grayscale(typename F::view_type view) noexcept {
+    if constexpr (std::is_same_v<F, formats::Gray8>) {
+        (void)view;
+    } else if constexpr (std::is_same_v<F, formats::Planar>) {
+        for (int y = 0; y < view.height(); y++) {
+            std::uint8_t* b = view.blue.row_ptr(y);
+            std::uint8_t* g = view.green.row_ptr(y);
+            std::uint8_t* r = view.red.row_ptr(y);
+            for (int x = 0; x < view.width(); x++) {
+                b[x] = g[x] = r[x] = detail::average(b[x], g[x], r[x]);
+            }
+        }
+    } else {
+        static_assert(detail::is_packed_color_v<typename F::pixel_type>, "unsupported format");
+        for (auto row : view.rows()) {
+            for (auto& p : row) {
+                p.blue = p.green = p.red = detail::average(p.blue, p.green, p.red);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Mirrors the view horizontally in place.
+ */
+template <class F>
+void flip_horizontal(typename F::view_type view) noexcept {
+    if constexpr (std::is_same_v<F, formats::Planar>) {
+        detail::flip_rows(view.blue);
+        detail::flip_rows(view.green);
+        detail::flip_rows(view.red);
+    } else {
+        detail::flip_rows(view);
+    }
+}
+
+/**
+ * @brief Writes src rotated 90 degrees clockwise into dst.
+ * dst must be src.height() pixels wide and src.width() pixels high.
+ */
+template <class F>
+void rotate_right(typename F::view_type src, typename F::view_type dst) noexcept {
+    if constexpr (std::is_same_v<F, formats::Planar>) {
+        detail::rotate_into<std::uint8_t>(src.blue, dst.blue);
+        detail::rotate_into<std::uint8_t>(src.green, dst.green);
+        detail::rotate_into<std::uint8_t>(src.red, dst.red);
+    } else {
+        detail::rotate_into<typename F::pixel_type>(src, dst);
+    }
+}
+
+} // namespace kernels
+
+} // namespace bmap
+
+#endif // BMAP_FORMATS_HPP
@@ -0,0 +1,235 @@
+/**
+ * @file bmap_tables.hpp
+ * @brief Compile-time lookup tables and filter coefficients for the C++ layer.
+ * Everything here is constexpr: gamma curves, sRGB transfer tables, luma
+ * weights and fixed-size resampling phases are computed by the compiler and
+ * emitted as read-only data, so no table is built at startup or on first use.
+ * @author Arda Aksu
+ * @date 2026
+ */
+
+#ifndef BMAP_TABLES_HPP
+#define BMAP_TABLES_HPP
+
+#include "bmap.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace bmap {
+
+/* ========================================================================= *
+ * CONSTEXPR MATH                                *
+ * ========================================================================= */
+
+namespace cmath {
+
+constexpr double ln2 = 0.69314718055994530942;
+
+/** Natural logarithm for x > 0, accurate to a few ulp. */
+constexpr double log(double x) {
+    int k = 0;
+    while (x >= 2.0) { x /= 2.0; k++; }
+    while (x < 1.0) { x *= 2.0; k--; }
+    /* ln(x) = 2 atanh((x - 1) / (x + 1)) converges quickly for x in [1, 2) */
+    double t = (x - 1.0) / (x + 1.0);
+    double t2 = t * t;
+    double term = t, sum = 0.0;
+    for (int n = 1; n < 60; n += 2) {
+        sum += term / n;
+        term *= t2;
+    }
+    return 2.0 * sum + k * ln2;
+}
+
+/** e^x, accurate to a few ulp over the ranges used by the tables. */
+constexpr double exp(double x) {
+    int k = static_cast<int>(x / ln2);
+    double r = x - k * ln2;
+    double term = 1.0, sum = 1.0;
+    for (int n = 1; n < 30; n++) {
+        term *= r / n;
+        sum += term;
+    }
+    for (; k > 0; k--) sum *= 2.0;
+    for (; k < 0; k++) sum /= 2.0;
+    return sum;
+}
+
+/** x^y for x >= 0. */
+constexpr double pow(double x, double y) {
+    return x <= 0.0 ? 0.0 : exp(y * log(x));
+}
+
+constexpr long floor(double x) {
+    long i = static_cast<long>(x);
+    return (x < 0.0 && static_cast<double>(i) != x) ? i - 1 : i;
+}
+
+constexpr long round(double x) {
+    return x < 0.0 ? -static_cast<long>(-x + 0.5) : static_cast<long>(x + 0.5);
+}
+
+} // namespace cmath
+
+
+/* ========================================================================= *
+ * TRANSFER CURVES                               *
+ * ========================================================================= */
+
+constexpr double srgb_decode(double c) {
+    return c <= 0.04045 ? c / 12.92 : cmath::pow((c + 0.055) / 1.055, 2.4);
+}
+
+constexpr double srgb_encode(double l) {
+    return l <= 0.0031308 ? 12.92 * l : 1.055 * cmath::pow(l, 1.0 / 2.4) - 0.055;
+}
+
+/** Same contents as bmp_srgb_to_linear16. */
+constexpr std::array<std::uint16_t, 256> make_srgb_to_linear16() {
+    std::array<std::uint16_t, 256> lut{};
+    for (int i = 0; i < 256; i++) {
+        lut[i] = static_cast<std::uint16_t>(cmath::round(65535.0 * srgb_decode(i / 255.0)));
+    }
+    return lut;
+}
+
+/** Same contents as bmp_linear12_to_srgb; index with linear16 >> 4. */
+constexpr std::array<std::uint8_t, 4096> make_linear12_to_srgb() {
+    std::array<std::uint8_t, 4096> lut{};
+    for (int j = 0; j < 4096; j++) {
+        long v = cmath::round(255.0 * srgb_encode((j + 0.5) * 16.0 / 65535.0));
+        lut[j] = static_cast<std::uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+    }
+    return lut;
+}
+
+/**
+ * @brief 8-bit to 8-bit power curve out = 255 * (in / 255)^gamma.
+ * Use as constexpr auto lut = make_gamma_lut(2.2); to bake a fixed gamma.
+ */
+constexpr std::array<std::uint8_t, 256> make_gamma_lut(double gamma) {
+    std::array<std::uint8_t, 256> lut{};
+    for (int i = 0; i < 256; i++) {
+        lut[i] = static_cast<std::uint8_t>(cmath::round(255.0 * cmath::pow(i / 255.0, gamma)));
+    }
+    return lut;
+}
+
+/** Same contents as bmp_lab_f16; index with t16 >> 4. */
+constexpr std::array<std::uint16_t, 4096> make_lab_f16() {
+    std::array<std::uint16_t, 4096> lut{};
+    constexpr double delta = 6.0 / 29.0;
+    for (int j = 0; j < 4096; j++) {
+        double t = (j + 0.5) * 16.0 / 65535.0;
+        double f = t > delta * delta * delta ? cmath::pow(t, 1.0 / 3.0) : t / (3.0 * delta * delta) + 4.0 / 29.0;
+        lut[j] = static_cast<std::uint16_t>(cmath::round(65535.0 * f));
+    }
+    return lut;
+}
+
+inline constexpr auto srgb_to_linear16 = make_srgb_to_linear16();
+inline constexpr auto linear12_to_srgb = make_linear12_to_srgb();
+inline constexpr auto lab_f16 = make_lab_f16();
+
+static_assert(srgb_to_linear16[0] == 0 && srgb_to_linear16[255] == 65535, "sRGB decode endpoints");
+static_assert(linear12_to_srgb[0] == 0 && linear12_to_srgb[4095] == 255, "sRGB encode endpoints");
+
+
+/* ========================================================================= *
+ * LUMA WEIGHTS                                 *
+ * ========================================================================= */
+
+/** Fixed-point luma weights; r + g + b == 1 << 16. */
+struct LumaWeights {
+    std::uint32_t r, g, b;
+
+    constexpr std::uint8_t apply(const Pixel& p) const {
+        return static_cast<std::uint8_t>((r * p.red + g * p.green + b * p.blue + 32768u) >> 16);
+    }
+};
+
+inline constexpr LumaWeights luma601{BMP_LUMA601_R, BMP_LUMA601_G, BMP_LUMA601_B};
+inline constexpr LumaWeights luma709{BMP_LUMA709_R, BMP_LUMA709_G, BMP_LUMA709_B};
+
+static_assert(luma601.r + luma601.g + luma601.b == 65536, "BT.601 weights must sum to 1.0");
+static_assert(luma709.r + luma709.g + luma709.b == 65536, "BT.709 weights must sum to 1.0");
+
+
+/* ========================================================================= *
+ * RESAMPLING COEFFICIENTS                           *
+ * ========================================================================= */
+
+/** Filter shapes usable in constant expressions. */
+namespace filters {
+
+struct Triangle {
+    static constexpr double radius = 1.0;
+    constexpr double operator()(double x) const {
+        x = x < 0 ? -x : x;
+        return x < 1.0 ? 1.0 - x : 0.0;
+    }
+};
+
+/** Catmull-Rom cubic (Keys, a = -0.5). */
+struct CatmullRom {
+    static constexpr double radius = 2.0;
+    constexpr double operator()(double x) const {
+        x = x < 0 ? -x : x;
+        if (x < 1.0) return 1.5 * x * x * x - 2.5 * x * x + 1.0;
+        if (x < 2.0) return -0.5 * x * x * x + 2.5 * x * x - 4.0 * x + 2.0;
+        return 0.0;
+    }
+};
+
+} // namespace filters
+
+/**
+ * @brief Polyphase weights for resampling by the fixed ratio Src:Dst.
+ * Output pixel o maps to source centre (o + 0.5) * Src / Dst - 0.5; its taps
+ * start at first[o % Dst] + (o / Dst) * Src and use weights[o % Dst], scaled
+ * to sum exactly to 1 << 14. Tap indices can fall outside the image at the
+ * borders; callers clamp them.
+ */
+template <int Src, int Dst, int Taps>
+struct ResamplePhases {
+    std::array<int, Dst> first{};
+    std::array<std::array<std::int16_t, Taps>, Dst> weights{};
+};
+
+template <int Src, int Dst, class Filter>
+constexpr auto make_resample_phases(Filter filter = Filter{}) {
+    static_assert(Src > 0 && Dst > 0, "ratio must be positive");
+    /* Downscaling stretches the filter to cover every contributing source pixel */
+    constexpr double scale = Src > Dst ? static_cast<double>(Src) / Dst : 1.0;
+    constexpr int taps = static_cast<int>(2.0 * Filter::radius * scale + 0.999999);
+
+    ResamplePhases<Src, Dst, taps> phases{};
+    for (int o = 0; o < Dst; o++) {
+        double centre = (o + 0.5) * Src / Dst - 0.5;
+        int first = static_cast<int>(cmath::floor(centre - Filter::radius * scale)) + 1;
+        phases.first[o] = first;
+
+        double raw[taps] = {};
+        double total = 0.0;
+        for (int t = 0; t < taps; t++) {
+            raw[t] = filter((first + t - centre) / scale);
+            total += raw[t];
+        }
+
+        /* Quantize, then put the rounding error on the largest tap */
+        int sum = 0, largest = 0;
+        for (int t = 0; t < taps; t++) {
+            phases.weights[o][t] = static_cast<std::int16_t>(cmath::round(raw[t] / total * 16384.0));
+            sum += phases.weights[o][t];
+            if (raw[t] > raw[largest]) largest = t;
+        }
+        phases.weights[o][largest] = static_cast<std::int16_t>(phases.weights[o][largest] + 16384 - sum);
+    }
+    return phases;
+}
+
+} // namespace bmap
+
+#endif // BMAP_TABLES_HPP
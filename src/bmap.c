@@ -9,10 +9,27 @@
  * @see bmap.h for function prototypes and error definitions.
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include "bmap.h"
+#include "bmap_internal.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
 
 #define BINARY_READ "rb"
 #define BINARY_WRITE "wb"
@@ -46,55 +63,164 @@ static int calculate_padding(int width) {
 
 /* --- Save and Load Methods --- */
 
-BMPImage* bmp_load(const char* filename, BMPError* err_out){
-    FILE *filepath = fopen(filename, BINARY_READ);
-    if(!filepath) {
-        if(err_out) *err_out = BMP_ERR_FILE_NOT_FOUND;
+BMPImage* bmap_image_create(int width, int height, int kind, BMPError* err_out) {
+    BMPImage* img = (BMPImage*)malloc(sizeof(BMPImage));
+    if(!img) {
+        if(err_out) *err_out = BMP_ERR_MALLOC_FAILED;
+        return NULL;
     }
-    
-    BMPFileHeader fh;
-    BMPInfoHeader ih;
+    img -> width  = width;
+    img -> height = height;
+    img -> data = bmap_pixels_alloc((size_t)width * height, kind, &img->storage);
 
-    fread(&fh, sizeof(BMPFileHeader), 1, filepath);
-    fread(&ih, sizeof(BMPInfoHeader), 1, filepath);
+    if(!img->data) {
+        if(err_out) *err_out = BMP_ERR_MALLOC_FAILED;
+        free(img);
+        return NULL;
+    }
+    return img;
+}
 
-    if(fh.type != 0x4D42 || ih.bit_count != 24) {
-        if(err_out) *err_out = BMP_ERR_INVALID_FORMAT;
-        fclose(filepath);
+BMPImage* bmp_create(int width, int height, BMPError* err_out) {
+    if(width <= 0 || height <= 0) {
+        if(err_out) *err_out = BMP_ERR_INVALID_ARGUMENT;
         return NULL;
     }
+    BMPImage* img = bmap_image_create(width, height, BMAP_STORAGE_HEAP, err_out);
+    if(img && err_out) *err_out = BMP_SUCCESS;
+    return img;
+}
 
-    BMPImage* img = (BMPImage*)malloc(sizeof(BMPImage));
-    img -> height = abs(ih.height);
-    img -> width  = ih.width;
-    img -> data = (Pixel*)malloc(img->height * img->width * sizeof(Pixel));
+BMPImage* bmp_clone(const BMPImage* image, BMPError* err_out) {
+    if(!image || !image->data) {
+        if(err_out) *err_out = BMP_ERR_INVALID_ARGUMENT;
+        return NULL;
+    }
+    BMPImage* copy = bmp_create(image->width, image->height, err_out);
+    if(copy) memcpy(copy->data, image->data, (size_t)image->width * image->height * sizeof(Pixel));
+    return copy;
+}
 
-    if(!img->data) {
-        if(err_out) *err_out = BMP_ERR_MALLOC_FAILED;
-        free(img);
+/* Width must be positive; height is signed (negative means top-down) but never 0 or INT32_MIN */
+static int header_size_valid(const BMPInfoHeader* ih) {
+    return ih->width > 0 && ih->height != 0 && ih->height != INT32_MIN;
+}
+
+/* Opens a 24-bit BMP and reads its headers; the stream is left after the headers */
+static FILE* open_bmp(const char* filename, BMPFileHeader* fh, BMPInfoHeader* ih, BMPError* err_out) {
+    FILE *filepath = filename ? fopen(filename, BINARY_READ) : NULL;
+    if(!filepath) {
+        if(err_out) *err_out = BMP_ERR_FILE_NOT_FOUND;
+        return NULL;
+    }
+
+    if(fread(fh, sizeof(BMPFileHeader), 1, filepath) != 1 ||
+       fread(ih, sizeof(BMPInfoHeader), 1, filepath) != 1 ||
+       fh->type != 0x4D42 || ih->bit_count != 24 || !header_size_valid(ih)) {
+        if(err_out) *err_out = BMP_ERR_INVALID_FORMAT;
         fclose(filepath);
         return NULL;
     }
+    return filepath;
+}
 
+/* Reads rows in file order; with a hash state, each row is hashed right after it lands.
+ * A file that ends before the last row is BMP_ERR_INVALID_FORMAT. */
+static BMPError read_pixel_rows(FILE* filepath, const BMPFileHeader* fh, BMPImage* img, BmapHashState* hash) {
     int padding = calculate_padding(img->width);
-    fseek(filepath, fh.offset, SEEK_SET);
+    fseek(filepath, fh->offset, SEEK_SET);
 
     for(int i = 0; i < img->height; i++) {
-        fread(&img->data[i * img->width], sizeof(Pixel), img->width, filepath);
+        Pixel* row = &img->data[(size_t)i * img->width];
+        if(fread(row, sizeof(Pixel), img->width, filepath) != (size_t)img->width) return BMP_ERR_INVALID_FORMAT;
+        if(hash) bmap_hash_update(hash, row, (size_t)img->width * sizeof(Pixel));
         fseek(filepath, padding, SEEK_CUR);
     }
-    
+    return BMP_SUCCESS;
+}
+
+BMPImage* bmap_image_load(const char* filename, int kind, BmapHashState* hash, BMPError* err_out) {
+    BMPFileHeader fh;
+    BMPInfoHeader ih;
+
+    FILE* filepath = open_bmp(filename, &fh, &ih, err_out);
+    if(!filepath) return NULL;
+
+    BMPImage* img = bmap_image_create(ih.width, ih.height < 0 ? -ih.height : ih.height, kind, err_out);
+    if(!img) {
+        fclose(filepath);
+        return NULL;
+    }
+
+    BMPError err = read_pixel_rows(filepath, &fh, img, hash);
     fclose(filepath);
-    if(err_out) *err_out = BMP_SUCCESS;
+    if(err != BMP_SUCCESS) {
+        bmp_free(img);
+        img = NULL;
+    }
+    if(err_out) *err_out = err;
+    return img;
+}
+
+BMPImage* bmp_load(const char* filename, BMPError* err_out){
+    return bmap_image_load(filename, BMAP_STORAGE_HEAP, NULL, err_out);
+}
+
+BMPImage* bmp_load_hashed(const char* filename, uint64_t* hash_out, BMPHash128* hash128_out, BMPError* err_out) {
+    BmapHashState hash;
+    bmap_hash_init(&hash);
+    BMPImage* img = bmap_image_load(filename, BMAP_STORAGE_HEAP, &hash, err_out);
+    if(!img) return NULL;
+
+    if(hash_out) *hash_out = bmap_hash_digest64(&hash);
+    if(hash128_out) *hash128_out = bmap_hash_digest128(&hash);
     return img;
 }
 
+BMPImage* bmp_load_mapped(const char* filename, BMPError* err_out) {
+    return bmap_image_load(filename, BMAP_STORAGE_SCRATCH, NULL, err_out);
+}
+
+BMPError bmp_load_into(BMPImage* image, const char* filename) {
+    if(!image) return BMP_ERR_INVALID_ARGUMENT;
+
+    BMPFileHeader fh;
+    BMPInfoHeader ih;
+    BMPError err;
+
+    FILE* filepath = open_bmp(filename, &fh, &ih, &err);
+    if(!filepath) return err;
+
+    int height = ih.height < 0 ? -ih.height : ih.height;
+    size_t count = (size_t)ih.width * height;
+    if(image->storage) {
+        /* Scratch mappings are sized exactly; swap in heap memory instead */
+        bmap_pixels_free(image->data, image->storage);
+        image->data = NULL;
+        image->storage = NULL;
+    }
+
+    /* realloc keeps the block in place whenever it is already large enough; count is never 0 */
+    Pixel* data = (Pixel*)realloc(image->data, count * sizeof(Pixel));
+    if(!data) {
+        fclose(filepath);
+        return BMP_ERR_MALLOC_FAILED;
+    }
+    image->data = data;
+    image->width = ih.width;
+    image->height = height;
+
+    err = read_pixel_rows(filepath, &fh, image, NULL);
+    fclose(filepath);
+    return err;
+}
+
 BMPError bmp_save(const BMPImage* image, const char* filename) {
     FILE* filepath = fopen(filename, BINARY_WRITE);
     if(!filepath) return BMP_ERR_FILE_NOT_FOUND;
 
     int padding = calculate_padding(image->width);
-    uint32_t image_size = (image->width * sizeof(Pixel) + padding) * image->height;
+    uint32_t image_size = (uint32_t)(((size_t)image->width * sizeof(Pixel) + padding) * image->height);
 
     BMPFileHeader fh = {0x4D42, sizeof(BMPFileHeader) + sizeof(BMPInfoHeader) + image_size, 0, 0, 54};
     BMPInfoHeader ih = {40, image->width, image->height, 1, 24, 0, image_size, 2835, 2835, 0, 0};
@@ -104,7 +230,7 @@ BMPError bmp_save(const BMPImage* image, const char* filename) {
 
     uint8_t padding_bytes[3] = {0, 0, 0};
     for (int i = 0; i < image->height; i++) {
-        fwrite(&image->data[i * image->width], sizeof(Pixel), image->width, filepath);
+        fwrite(&image->data[(size_t)i * image->width], sizeof(Pixel), image->width, filepath);
         fwrite(padding_bytes, 1, padding, filepath);
     }
 
@@ -112,41 +238,343 @@ BMPError bmp_save(const BMPImage* image, const char* filename) {
     return BMP_SUCCESS;
 }
 
+/* --- Region Loading --- */
+
+typedef struct {
+    int fd;
+    BMPImage* img;
+    uint64_t first_row_offset;  /* File offset of the first requested pixel */
+    uint64_t stride;            /* Bytes per file row, padding included */
+    int contiguous;             /* Rows are back to back: one read per block */
+    int row_begin, row_end;
+    int failed;
+} RegionJob;
+
+int bmap_read_at(int fd, void* buf, size_t len, uint64_t offset) {
+    uint8_t* dst = (uint8_t*)buf;
+    while (len > 0) {
+#ifdef _WIN32
+        /* Each request carries its own offset, so concurrent reads never race on a shared
+         * position; synchronous handles still move the file pointer, so it is not preserved */
+        HANDLE handle = (HANDLE)_get_osfhandle(fd);
+        OVERLAPPED at;
+        DWORD read_bytes = 0;
+        memset(&at, 0, sizeof(at));
+        at.Offset = (DWORD)offset;
+        at.OffsetHigh = (DWORD)(offset >> 32);
+        if (handle == INVALID_HANDLE_VALUE ||
+            !ReadFile(handle, dst, len > 0x40000000u ? 0x40000000u : (DWORD)len, &read_bytes, &at)) {
+            return -1;
+        }
+        ssize_t got = (ssize_t)read_bytes;
+#else
+        ssize_t got = pread(fd, dst, len, (off_t)offset);
+        if (got < 0 && errno == EINTR) continue;
+#endif
+        if (got <= 0) return -1;
+        dst += got;
+        len -= (size_t)got;
+        offset += (uint64_t)got;
+    }
+    return 0;
+}
+
+static void* region_read_rows(void* arg) {
+    RegionJob* job = (RegionJob*)arg;
+    size_t row_bytes = (size_t)job->img->width * sizeof(Pixel);
+
+    if (job->contiguous) {
+        job->failed = bmap_read_at(job->fd, &job->img->data[(size_t)job->row_begin * job->img->width],
+                                   row_bytes * (job->row_end - job->row_begin),
+                                   job->first_row_offset + job->row_begin * job->stride);
+        return NULL;
+    }
+
+    for (int i = job->row_begin; i < job->row_end; i++) {
+        if (bmap_read_at(job->fd, &job->img->data[(size_t)i * job->img->width], row_bytes,
+                         job->first_row_offset + i * job->stride) != 0) {
+            job->failed = 1;
+            return NULL;
+        }
+    }
+    return NULL;
+}
+
+BMPImage* bmp_load_region(const char* filename, int x, int y, int w, int h, BMPError* err_out) {
+    return bmp_load_region_parallel(filename, x, y, w, h, 1, err_out);
+}
+
+BMPImage* bmp_load_region_parallel(const char* filename, int x, int y, int w, int h,
+                                   int threads, BMPError* err_out) {
+    int fd = filename ? open(filename, O_RDONLY | O_BINARY) : -1;
+    if(fd < 0) {
+        if(err_out) *err_out = BMP_ERR_FILE_NOT_FOUND;
+        return NULL;
+    }
+
+    BMPImage* img = bmap_load_region_fd(fd, x, y, w, h, threads, err_out);
+    close(fd);
+    return img;
+}
+
+BMPImage* bmap_load_region_fd(int fd, int x, int y, int w, int h, int threads, BMPError* err_out) {
+    BMPFileHeader fh;
+    BMPInfoHeader ih;
+
+    if(bmap_read_at(fd, &fh, sizeof(BMPFileHeader), 0) != 0 ||
+       bmap_read_at(fd, &ih, sizeof(BMPInfoHeader), sizeof(BMPFileHeader)) != 0 ||
+       fh.type != 0x4D42 || ih.bit_count != 24 || !header_size_valid(&ih)) {
+        if(err_out) *err_out = BMP_ERR_INVALID_FORMAT;
+        return NULL;
+    }
+
+    /* Clip the requested rectangle to the image bounds */
+    int img_width = ih.width;
+    int img_height = ih.height < 0 ? -ih.height : ih.height;
+    int64_t right = (int64_t)x + w, top = (int64_t)y + h;
+    int x0 = x < 0 ? 0 : x;
+    int y0 = y < 0 ? 0 : y;
+    int x1 = right > img_width ? img_width : (int)right;
+    int y1 = top > img_height ? img_height : (int)top;
+
+    if(w <= 0 || h <= 0 || x0 >= x1 || y0 >= y1) {
+        if(err_out) *err_out = BMP_ERR_INVALID_ARGUMENT;
+        return NULL;
+    }
+
+    BMPImage* img = bmap_image_create(x1 - x0, y1 - y0, BMAP_STORAGE_HEAP, err_out);
+    if(!img) return NULL;
+
+    /*
+     * Rows sit at fh.offset + row * stride in storage order, whether the file
+     * is bottom-up (positive height) or top-down (negative height). bmp_load()
+     * keeps that order in memory, so the same mapping applies to both layouts.
+     */
+    int padding = calculate_padding(img_width);
+    RegionJob base;
+    base.fd = fd;
+    base.img = img;
+    base.stride = (uint64_t)img_width * sizeof(Pixel) + padding;
+    base.first_row_offset = fh.offset + (uint64_t)y0 * base.stride + (uint64_t)x0 * sizeof(Pixel);
+    base.contiguous = (padding == 0 && img->width == img_width);
+    base.failed = 0;
+
+    if(threads > img->height) threads = img->height;
+    if(threads > BMP_REGION_MAX_THREADS) threads = BMP_REGION_MAX_THREADS;
+    if(threads < 1) threads = 1;
+
+    RegionJob jobs[BMP_REGION_MAX_THREADS];
+    pthread_t workers[BMP_REGION_MAX_THREADS];
+    int started[BMP_REGION_MAX_THREADS] = {0};
+
+    for(int t = 0; t < threads; t++) {
+        jobs[t] = base;
+        jobs[t].row_begin = (int)((int64_t)img->height * t / threads);
+        jobs[t].row_end = (int)((int64_t)img->height * (t + 1) / threads);
+        /* The calling thread takes the first block itself */
+        if(t > 0) started[t] = pthread_create(&workers[t], NULL, region_read_rows, &jobs[t]) == 0;
+    }
+    region_read_rows(&jobs[0]);
+
+    int failed = jobs[0].failed;
+    for(int t = 1; t < threads; t++) {
+        if(started[t]) pthread_join(workers[t], NULL);
+        else region_read_rows(&jobs[t]);
+        failed |= jobs[t].failed;
+    }
+
+    if(failed) {
+        if(err_out) *err_out = BMP_ERR_INVALID_FORMAT;
+        bmp_free(img);
+        return NULL;
+    }
+
+    if(err_out) *err_out = BMP_SUCCESS;
+    return img;
+}
+
 void bmp_free(BMPImage* image) {
     if (image) {
-        if (image->data) free(image->data);
+        if (image->data) bmap_pixels_free(image->data, image->storage);
         free(image);
     }
 }
 
 /* --- Pixel Access Methods --- */
 
-Pixel bmp_get_pixel(const BMPImage* image, int x, int y) {
-    if (image == NULL || image->data == NULL || 
-        x < 0 || x >= image->width || 
-        y < 0 || y >= image->height) {
+/* Unsigned compares fold the negative and upper bound checks into one */
+static int pixel_in_bounds(const BMPImage* image, int x, int y) {
+    return image != NULL && image->data != NULL &&
+           (unsigned)x < (unsigned)image->width && (unsigned)y < (unsigned)image->height;
+}
 
+Pixel bmp_get_pixel(const BMPImage* image, int x, int y) {
+    if (!pixel_in_bounds(image, x, y)) {
         Pixel black = {0, 0, 0};
         return black;
     }
-
-    int index = (y * image->width) + x;
-    return image->data[index];
+    return bmp_pixel(image, x, y);
 }
 
 void bmp_set_pixel(BMPImage* image, int x, int y, Pixel color) {
-    if (image == NULL || image->data == NULL || 
-        x < 0 || x >= image->width || 
-        y < 0 || y >= image->height) {
-        return; 
+    if (pixel_in_bounds(image, x, y)) bmp_put_pixel(image, x, y, color);
+}
+
+BMPError bmp_visit_rows(BMPImage* image, int x, int y, int w, int h, BMPRowVisitor visit, void* user) {
+    if (!image || !image->data || !visit || w <= 0 || h <= 0 || x < 0 || y < 0 ||
+        x > image->width - w || y > image->height - h) {
+        return BMP_ERR_INVALID_ARGUMENT;
+    }
+    for (int row = y; row < y + h; row++) visit(bmp_row(image, row) + x, w, x, row, user);
+    return BMP_SUCCESS;
+}
+
+/* --- Bulk Pixel Access --- */
+
+/* Intersects x, y, w, h with the image; returns 0 if nothing is left */
+static int clip_rect(const BMPImage* image, int x, int y, int w, int h, int* x0, int* y0, int* x1, int* y1) {
+    int64_t right = (int64_t)x + w, top = (int64_t)y + h;
+    *x0 = x < 0 ? 0 : x;
+    *y0 = y < 0 ? 0 : y;
+    *x1 = right > image->width ? image->width : (int)right;
+    *y1 = top > image->height ? image->height : (int)top;
+    return *x0 < *x1 && *y0 < *y1;
+}
+
+/* Copies one row between the image and an external buffer, swizzling for RGB */
+static void copy_row(uint8_t* dst, const uint8_t* src, int count, BMPChannelOrder order) {
+    if (order == BMP_ORDER_RGB) bmap_kernels()->swap_rb(dst, src, (size_t)count);
+    else memcpy(dst, src, (size_t)count * sizeof(Pixel));
+}
+
+BMPError bmp_read_rect(const BMPImage* image, int x, int y, int w, int h,
+                       void* dst, size_t dst_stride, BMPChannelOrder order) {
+    size_t row_bytes = (size_t)w * sizeof(Pixel);
+    if (!image || !image->data || !dst || w <= 0 || h <= 0 || x < 0 || y < 0 ||
+        x > image->width - w || y > image->height - h || (dst_stride && dst_stride < row_bytes)) {
+        return BMP_ERR_INVALID_ARGUMENT;
+    }
+    if (!dst_stride) dst_stride = row_bytes;
+
+    uint8_t* out = (uint8_t*)dst;
+    for (int row = 0; row < h; row++, out += dst_stride) {
+        copy_row(out, (const uint8_t*)(bmp_row(image, y + row) + x), w, order);
+    }
+    return BMP_SUCCESS;
+}
+
+BMPError bmp_write_rect(BMPImage* image, int x, int y, int w, int h,
+                        const void* src, size_t src_stride, BMPChannelOrder order) {
+    size_t row_bytes = (size_t)(w > 0 ? w : 0) * sizeof(Pixel);
+    if (!image || !image->data || !src || (src_stride && src_stride < row_bytes)) return BMP_ERR_INVALID_ARGUMENT;
+    if (!src_stride) src_stride = row_bytes;
+
+    /* Clip once, moving the buffer origin along with the rectangle */
+    int x0, y0, x1, y1;
+    if (!clip_rect(image, x, y, w, h, &x0, &y0, &x1, &y1)) return BMP_SUCCESS;
+
+    const uint8_t* in = (const uint8_t*)src + (size_t)((int64_t)y0 - y) * src_stride +
+                         (size_t)((int64_t)x0 - x) * sizeof(Pixel);
+    for (int row = y0; row < y1; row++, in += src_stride) {
+        copy_row((uint8_t*)(bmp_row(image, row) + x0), in, x1 - x0, order);
+    }
+    return BMP_SUCCESS;
+}
+
+#define FILL_BLOCK 64      /* Pattern pixels: 192 bytes, a multiple of every vector width */
+#define FILL_NARROW 8      /* Up to this width rows are filled with plain stores */
+
+/* Replicates a pattern block of one color over count pixels with memcpy() */
+static void fill_from_block(Pixel* dst, const Pixel* block, size_t count) {
+    size_t i = 0;
+    for (; i + FILL_BLOCK <= count; i += FILL_BLOCK) memcpy(dst + i, block, FILL_BLOCK * sizeof(Pixel));
+    memcpy(dst + i, block, (count - i) * sizeof(Pixel));
+}
+
+void bmp_fill_rect(BMPImage* image, int x, int y, int w, int h, Pixel color) {
+    int x0, y0, x1, y1;
+    if (!image || !image->data || !clip_rect(image, x, y, w, h, &x0, &y0, &x1, &y1)) return;
+
+    /* Narrow rectangles (box edges, short spans) gain nothing from the block */
+    int span = x1 - x0;
+    if (span <= FILL_NARROW) {
+        Pixel* p = bmp_row(image, y0) + x0;
+        for (int row = y0; row < y1; row++, p += image->width) {
+            for (int k = 0; k < span; k++) p[k] = color;
+        }
+        return;
     }
 
-    int index = (y * image->width) + x;
-    image->data[index] = color;
+    /* Only as much of the block as one row can use */
+    Pixel block[FILL_BLOCK];
+    int fill = span < FILL_BLOCK && span != image->width ? span : FILL_BLOCK;
+    for (int k = 0; k < fill; k++) block[k] = color;
+
+    /* Full-width rectangles are contiguous */
+    if (span == image->width) {
+        fill_from_block(bmp_row(image, y0), block, (size_t)(y1 - y0) * image->width);
+        return;
+    }
+    for (int row = y0; row < y1; row++) fill_from_block(bmp_row(image, row) + x0, block, (size_t)span);
+}
+
+void bmp_fill_span(BMPImage* image, int x, int y, int count, Pixel color) {
+    bmp_fill_rect(image, x, y, count, 1, color);
 }
 
 /* --- Image Rotations --- */
 
+/*
+ * Rotation walks the output in bands of ROTATE_BAND rows (input columns) and
+ * turns ROTATE_TILE x ROTATE_TILE tiles inside each band with the rotate_tile
+ * kernel (a per-lane SIMD transpose where available), so both sides are
+ * accessed in short contiguous runs. For scratch-backed images the finished
+ * output band and the source pages it has used up are released after every
+ * band, which keeps the resident set bounded however large the image is.
+ */
+#define ROTATE_TILE 64
+#define ROTATE_BAND 1024
+
+/* Tiled transpose-and-mirror; dst is src->height pixels wide */
+static void rotate_into(const BMPImage* src, Pixel* new_data, void* new_storage) {
+    int new_width = src->height;
+    void (*rotate_tile)(Pixel*, size_t, const Pixel*, size_t, int, int) = bmap_kernels()->rotate_tile;
+
+    for(int jb = 0; jb < src->width; jb += ROTATE_BAND) {
+        int jb_end = (jb + ROTATE_BAND < src->width) ? jb + ROTATE_BAND : src->width;
+
+        for(int it = 0; it < src->height; it += ROTATE_TILE) {
+            int it_end = (it + ROTATE_TILE < src->height) ? it + ROTATE_TILE : src->height;
+
+            for(int jt = jb; jt < jb_end; jt += ROTATE_TILE) {
+                int jt_end = (jt + ROTATE_TILE < jb_end) ? jt + ROTATE_TILE : jb_end;
+
+                /* Source row i lands in output column height - 1 - i */
+                rotate_tile(&new_data[(size_t)jt * new_width + (src->height - it_end)], (size_t)new_width,
+                            &src->data[(size_t)it * src->width + jt], (size_t)src->width,
+                            it_end - it, jt_end - jt);
+            }
+        }
+
+        bmap_pixels_evict(new_storage, &new_data[(size_t)jb * new_width],
+                          (size_t)(jb_end - jb) * new_width * sizeof(Pixel));
+
+        /*
+         * Columns below jb_end of every source row are done. Pages inside a
+         * row go now; pages shared with the rest of a row or with the next row
+         * stay until the last band, so later bands never fault them back in.
+         */
+        if (!src->storage) continue;
+        if (jb_end == src->width) {
+            bmap_pixels_evict(src->storage, src->data, (size_t)src->width * src->height * sizeof(Pixel));
+            continue;
+        }
+        for (int i = 0; i < src->height; i++) {
+            bmap_pixels_evict(src->storage, &src->data[(size_t)i * src->width], (size_t)jb_end * sizeof(Pixel));
+        }
+    }
+}
+
 void bmp_rotate_right(BMPImage* image) {
     if (image == NULL || image->data == NULL) {
         return;
@@ -155,67 +583,172 @@ void bmp_rotate_right(BMPImage* image) {
     int new_height = image -> width;
     int new_width = image -> height;
 
-    Pixel* new_data = (Pixel*)malloc(new_width * new_height * sizeof(Pixel));
+    void* new_storage;
+    Pixel* new_data = bmap_pixels_alloc((size_t)new_width * new_height,
+                                        bmap_pixels_kind(image->storage), &new_storage);
     if (!new_data) return; 
-    
-    for(int i = 0; i < image->height; i++) {
-        for(int j = 0; j < image->width; j++) {
-            int new_index = (j * new_width) + (image->height - 1 - i);
-            int old_index = (i * image->width) + j;
-            
-            new_data[new_index] = image->data[old_index];
-        }
-    }
 
-    free(image->data);
+    rotate_into(image, new_data, new_storage);
+
+    bmap_pixels_free(image->data, image->storage);
     image->data = new_data;
+    image->storage = new_storage;
     image->width = new_width;
     image->height = new_height;
 }
 
+BMPError bmp_rotate_right_into(const BMPImage* src, BMPImage* dst) {
+    if (!src || !src->data || !dst || !dst->data || dst->data == src->data ||
+        dst->width != src->height || dst->height != src->width) {
+        return BMP_ERR_INVALID_ARGUMENT;
+    }
+    rotate_into(src, dst->data, dst->storage);
+    return BMP_SUCCESS;
+}
+
 void bmp_flip_horizontal(BMPImage* image) {
     if (!image || !image->data) return;
 
-    Pixel* new_data = (Pixel*)malloc(image->width * image->height * sizeof(Pixel));
-    if(!new_data) return;
-
+    /* Mirror each row in place: no second buffer, one sequential pass */
+    void (*flip_row)(Pixel*, int) = bmap_kernels()->flip_row;
     for(int i = 0; i < image->height; i++) {
-        for(int j = 0; j < image->width; j++) {
-            int new_index = (i * image->width) + (image->width - 1 - j);
-            int old_index = (i * image->width) + j;
+        flip_row(&image->data[(size_t)i * image->width], image->width);
+    }
+}
+
+/* Bilinear resample of src into new_data, new_width x new_height pixels, in linear light if asked */
+static BMPError resize_into(const BMPImage* image, Pixel* new_data, int new_width, int new_height, int linear) {
+    int* col_index = (int*)malloc(new_width * sizeof(int));
+    int* col_weight = (int*)malloc(new_width * sizeof(int));
+    if (!col_index || !col_weight) {
+        free(col_index);
+        free(col_weight);
+        return BMP_ERR_MALLOC_FAILED;
+    }
+
+    /*
+     * Bilinear sampling at pixel centres. Source positions are 16.16 fixed
+     * point; weights keep 8 fractional bits so the blend fits in 32 bits.
+     */
+    for (int x = 0; x < new_width; x++) {
+        int64_t pos = ((2 * (int64_t)x + 1) * image->width * 65536) / (2 * (int64_t)new_width) - 32768;
+        if (pos < 0) pos = 0;
+        col_index[x] = (int)(pos >> 16);
+        col_weight[x] = (int)((pos >> 8) & 255);
+        if (col_index[x] >= image->width - 1) {
+            col_index[x] = image->width - 1;
+            col_weight[x] = 0;
+        }
+    }
+
+    for (int y = 0; y < new_height; y++) {
+        int64_t pos = ((2 * (int64_t)y + 1) * image->height * 65536) / (2 * (int64_t)new_height) - 32768;
+        if (pos < 0) pos = 0;
+        int row = (int)(pos >> 16);
+        int wy = (int)((pos >> 8) & 255);
+        if (row >= image->height - 1) {
+            row = image->height - 1;
+            wy = 0;
+        }
+
+        const Pixel* r0 = &image->data[(size_t)row * image->width];
+        const Pixel* r1 = wy ? r0 + image->width : r0;
+        Pixel* out = &new_data[(size_t)y * new_width];
+
+        if (linear) {
+            /* Same weights on 16-bit linear light: 65535 * 256 * 256 still fits in 32 bits */
+            const uint16_t* lin = bmp_srgb_to_linear16;
+            for (int x = 0; x < new_width; x++) {
+                int i = col_index[x], wx = col_weight[x];
+                int j = wx ? i + 1 : i;
+
+#define BLEND(ch) bmp_linear12_to_srgb[((((uint32_t)lin[r0[i].ch] * (256 - wx) + (uint32_t)lin[r0[j].ch] * wx) * \
+                                         (256 - wy) + ((uint32_t)lin[r1[i].ch] * (256 - wx) +                    \
+                                         (uint32_t)lin[r1[j].ch] * wx) * wy) + 32768) >> 20]
+                out[x].blue = BLEND(blue);
+                out[x].green = BLEND(green);
+                out[x].red = BLEND(red);
+#undef BLEND
+            }
+            continue;
+        }
+
+        for (int x = 0; x < new_width; x++) {
+            int i = col_index[x], wx = col_weight[x];
+            int j = wx ? i + 1 : i;
 
-            new_data[new_index] = image->data[old_index];
+#define BLEND(ch) (uint8_t)((((r0[i].ch * (256 - wx) + r0[j].ch * wx) * (256 - wy) + \
+                              (r1[i].ch * (256 - wx) + r1[j].ch * wx) * wy) + 32768) >> 16)
+            out[x].blue = BLEND(blue);
+            out[x].green = BLEND(green);
+            out[x].red = BLEND(red);
+#undef BLEND
         }
     }
-    free(image->data);
+
+    free(col_index);
+    free(col_weight);
+    return BMP_SUCCESS;
+}
+
+void bmp_resize(BMPImage* image, int new_width, int new_height) {
+    if (!image || !image->data || new_width <= 0 || new_height <= 0) return;
+
+    void* new_storage;
+    Pixel* new_data = bmap_pixels_alloc((size_t)new_width * new_height,
+                                        bmap_pixels_kind(image->storage), &new_storage);
+    if (!new_data) return;
+    if (resize_into(image, new_data, new_width, new_height, 0) != BMP_SUCCESS) {
+        bmap_pixels_free(new_data, new_storage);
+        return;
+    }
+
+    bmap_pixels_free(image->data, image->storage);
     image->data = new_data;
+    image->storage = new_storage;
+    image->width = new_width;
+    image->height = new_height;
+}
+
+BMPError bmp_resize_into(const BMPImage* src, BMPImage* dst, int flags) {
+    if (!src || !src->data || !dst || !dst->data || dst->data == src->data ||
+        dst->width <= 0 || dst->height <= 0) {
+        return BMP_ERR_INVALID_ARGUMENT;
+    }
+    return resize_into(src, dst->data, dst->width, dst->height, (flags & BMP_MIX_LINEAR_LIGHT) != 0);
 }
 
+
 /* --- Image Fılters --- */
 
 void bmp_grayscale(BMPImage* image) {
     if (!image || !image->data) return;
 
-    for(int i = 0; i < image->height * image->width; i++) {
-        uint8_t avg = (image->data[i].red + image->data[i].green + image->data[i].blue) / 3;
-        
-        image->data[i].red = avg;
-        image->data[i].green = avg;
-        image->data[i].blue = avg;
-    }
+    bmap_kernels()->grayscale(image->data, (size_t)image->height * image->width);
 }
 
 
 void bmp_invert(BMPImage* image) {
     if (!image || !image->data) return;
 
-    for(int i = 0; i < image->height; i++) {
-        for(int j = 0; j < image->width; j++) {
-            int index = (i * image->width) + j;
+    bmap_kernels()->invert(image->data, (size_t)image->height * image->width);
+}
+
+/* --- Operation Chains --- */
+
+BMPError bmp_apply_operations(BMPImage* image, const BMPOperation* ops, int op_count) {
+    if (!image || !image->data || op_count < 0 || (op_count > 0 && !ops)) {
+        return BMP_ERR_INVALID_ARGUMENT;
+    }
 
-            image->data[index].blue= (255 - image->data[index].blue);
-            image->data[index].red= (255 - image->data[index].red);
-            image->data[index].green= (255 - image->data[index].green);
+    for (int i = 0; i < op_count; i++) {
+        switch (ops[i]) {
+            case BMP_OP_GRAYSCALE:       bmp_grayscale(image);       break;
+            case BMP_OP_INVERT:          bmp_invert(image);          break;
+            case BMP_OP_FLIP_HORIZONTAL: bmp_flip_horizontal(image); break;
+            case BMP_OP_ROTATE_RIGHT:    bmp_rotate_right(image);    break;
+            default: return BMP_ERR_INVALID_ARGUMENT;
         }
     }
-}
\ No newline at end of file
+    return BMP_SUCCESS;
+}
@@ -0,0 +1,277 @@
+/**
+ * @file bmap_cache.c
+ * @brief Process-wide LRU tile cache for repeated region access.
+ * * Tiles are read with bmp_load_region(), run through an operation chain and
+ * kept in memory under a configurable byte budget. Entries are keyed by file
+ * identity (device, inode, size, nanosecond mtime), tile coordinates and the
+ * operation chain, so panning over the same image is served without touching
+ * the disk. A miss stats and reads the same open descriptor, so a file that
+ * is replaced in between is never cached under the old identity.
+ * @author Arda Aksu
+ * @date 2026
+ * @see bmap.h for the public cache API.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bmap.h"
+#include "bmap_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+#define CACHE_BUCKETS 4096
+#define CACHE_DEFAULT_BUDGET ((size_t)256 * 1024 * 1024)
+#define CACHE_DEFAULT_TILE 256
+
+typedef struct {
+    uint64_t dev;
+    uint64_t ino;
+    uint64_t size;
+    int64_t  mtime;
+    int64_t  mtime_nsec;
+    uint64_t path_hash;         /* Only used when the platform has no inodes */
+    int tile_x, tile_y, tile_size;
+    int op_count;
+    uint8_t ops[BMP_CACHE_MAX_OPS];
+} CacheKey;
+
+typedef struct CacheEntry {
+    CacheKey key;
+    uint64_t hash;
+    BMPImage* tile;
+    size_t bytes;
+    struct CacheEntry* lru_prev;    /* Towards most recently used */
+    struct CacheEntry* lru_next;    /* Towards least recently used */
+    struct CacheEntry* bucket_next;
+} CacheEntry;
+
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static CacheEntry* buckets[CACHE_BUCKETS];
+static CacheEntry* lru_head;
+static CacheEntry* lru_tail;
+static size_t cache_bytes;
+static size_t cache_budget = CACHE_DEFAULT_BUDGET;
+static int cache_tile_size = CACHE_DEFAULT_TILE;
+
+/* --- Helpers --- */
+
+static uint64_t fnv1a(uint64_t hash, const void* data, size_t len) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+/* Sub-second part of the modification time, where the platform records one */
+static int64_t mtime_nsec(const struct stat* st) {
+#if defined(__APPLE__)
+    return (int64_t)st->st_mtimespec.tv_nsec;
+#elif defined(_WIN32)
+    (void)st;
+    return 0;
+#else
+    return (int64_t)st->st_mtim.tv_nsec;
+#endif
+}
+
+static uint64_t key_hash(const CacheKey* key) {
+    return fnv1a(0xCBF29CE484222325ULL, key, sizeof(CacheKey));
+}
+
+/* All of the following expect cache_lock to be held */
+
+static void lru_unlink(CacheEntry* entry) {
+    if (entry->lru_prev) entry->lru_prev->lru_next = entry->lru_next;
+    else lru_head = entry->lru_next;
+    if (entry->lru_next) entry->lru_next->lru_prev = entry->lru_prev;
+    else lru_tail = entry->lru_prev;
+    entry->lru_prev = entry->lru_next = NULL;
+}
+
+static void lru_push_front(CacheEntry* entry) {
+    entry->lru_prev = NULL;
+    entry->lru_next = lru_head;
+    if (lru_head) lru_head->lru_prev = entry;
+    lru_head = entry;
+    if (!lru_tail) lru_tail = entry;
+}
+
+static CacheEntry* cache_find(const CacheKey* key, uint64_t hash) {
+    for (CacheEntry* e = buckets[hash % CACHE_BUCKETS]; e; e = e->bucket_next) {
+        if (e->hash == hash && memcmp(&e->key, key, sizeof(CacheKey)) == 0) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+static void cache_remove(CacheEntry* entry) {
+    CacheEntry** link = &buckets[entry->hash % CACHE_BUCKETS];
+    while (*link != entry) link = &(*link)->bucket_next;
+    *link = entry->bucket_next;
+
+    lru_unlink(entry);
+    cache_bytes -= entry->bytes;
+    bmp_free(entry->tile);
+    free(entry);
+}
+
+static void cache_evict_to(size_t budget) {
+    while (lru_tail && cache_bytes > budget) {
+        cache_remove(lru_tail);
+    }
+}
+
+static void cache_drop_all(void) {
+    while (lru_tail) cache_remove(lru_tail);
+}
+
+/* --- Public API --- */
+
+BMPError bmp_cache_configure(size_t budget_bytes, int tile_size) {
+    if (tile_size <= 0) return BMP_ERR_INVALID_ARGUMENT;
+
+    pthread_mutex_lock(&cache_lock);
+    if (tile_size != cache_tile_size) {
+        cache_drop_all();
+        cache_tile_size = tile_size;
+    }
+    cache_budget = budget_bytes;
+    cache_evict_to(cache_budget);
+    pthread_mutex_unlock(&cache_lock);
+    return BMP_SUCCESS;
+}
+
+BMPImage* bmp_cache_get_tile(const char* filename, int tile_x, int tile_y,
+                             const BMPOperation* ops, int op_count, BMPError* err_out) {
+    if (!filename || tile_x < 0 || tile_y < 0 || op_count < 0 ||
+        op_count > BMP_CACHE_MAX_OPS || (op_count > 0 && !ops)) {
+        if (err_out) *err_out = BMP_ERR_INVALID_ARGUMENT;
+        return NULL;
+    }
+    for (int i = 0; i < op_count; i++) {
+        /* Keys store each op in a byte, so out-of-range ids must not reach them */
+        if ((int)ops[i] < BMP_OP_GRAYSCALE || ops[i] > BMP_OP_ROTATE_RIGHT) {
+            if (err_out) *err_out = BMP_ERR_INVALID_ARGUMENT;
+            return NULL;
+        }
+    }
+
+    /* The key and, on a miss, the pixels both come from this one descriptor */
+    int fd = open(filename, O_RDONLY | O_BINARY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        if (fd >= 0) close(fd);
+        if (err_out) *err_out = BMP_ERR_FILE_NOT_FOUND;
+        return NULL;
+    }
+
+    CacheKey key;
+    memset(&key, 0, sizeof(key));  /* Keys are hashed and compared bytewise */
+    key.dev = (uint64_t)st.st_dev;
+    key.ino = (uint64_t)st.st_ino;
+    key.size = (uint64_t)st.st_size;
+    key.mtime = (int64_t)st.st_mtime;
+    key.mtime_nsec = mtime_nsec(&st);
+    if (key.ino == 0) {
+        key.path_hash = fnv1a(0xCBF29CE484222325ULL, filename, strlen(filename));
+    }
+    key.tile_x = tile_x;
+    key.tile_y = tile_y;
+    key.op_count = op_count;
+    for (int i = 0; i < op_count; i++) key.ops[i] = (uint8_t)ops[i];
+
+    pthread_mutex_lock(&cache_lock);
+    int tile_size = cache_tile_size;
+    key.tile_size = tile_size;
+    uint64_t hash = key_hash(&key);
+
+    CacheEntry* entry = cache_find(&key, hash);
+    if (entry) {
+        lru_unlink(entry);
+        lru_push_front(entry);
+        BMPImage* copy = bmp_clone(entry->tile, NULL);
+        pthread_mutex_unlock(&cache_lock);
+        close(fd);
+        if (err_out) *err_out = copy ? BMP_SUCCESS : BMP_ERR_MALLOC_FAILED;
+        return copy;
+    }
+    pthread_mutex_unlock(&cache_lock);
+
+    /* Miss: read from disk without holding the lock */
+    if (tile_x > (int)(INT32_MAX / tile_size) || tile_y > (int)(INT32_MAX / tile_size)) {
+        close(fd);
+        if (err_out) *err_out = BMP_ERR_INVALID_ARGUMENT;
+        return NULL;
+    }
+    BMPImage* tile = bmap_load_region_fd(fd, tile_x * tile_size, tile_y * tile_size,
+                                         tile_size, tile_size, 1, err_out);
+    close(fd);
+    if (!tile) return NULL;
+
+    BMPError op_err = bmp_apply_operations(tile, ops, op_count);
+    if (op_err != BMP_SUCCESS) {
+        bmp_free(tile);
+        if (err_out) *err_out = op_err;
+        return NULL;
+    }
+
+    BMPImage* result = bmp_clone(tile, NULL);
+    if (!result) {
+        bmp_free(tile);
+        if (err_out) *err_out = BMP_ERR_MALLOC_FAILED;
+        return NULL;
+    }
+
+    size_t bytes = (size_t)tile->width * tile->height * sizeof(Pixel);
+    entry = (CacheEntry*)calloc(1, sizeof(CacheEntry));
+
+    pthread_mutex_lock(&cache_lock);
+    /* Another thread may have inserted the same tile, or the configuration changed */
+    if (!entry || bytes > cache_budget || tile_size != cache_tile_size || cache_find(&key, hash)) {
+        pthread_mutex_unlock(&cache_lock);
+        free(entry);
+        bmp_free(tile);
+    } else {
+        entry->key = key;
+        entry->hash = hash;
+        entry->tile = tile;
+        entry->bytes = bytes;
+        entry->bucket_next = buckets[hash % CACHE_BUCKETS];
+        buckets[hash % CACHE_BUCKETS] = entry;
+        lru_push_front(entry);
+        cache_bytes += bytes;
+        cache_evict_to(cache_budget);
+        pthread_mutex_unlock(&cache_lock);
+    }
+
+    if (err_out) *err_out = BMP_SUCCESS;
+    return result;
+}
+
+void bmp_cache_clear(void) {
+    pthread_mutex_lock(&cache_lock);
+    cache_drop_all();
+    pthread_mutex_unlock(&cache_lock);
+}
+
+size_t bmp_cache_usage(void) {
+    pthread_mutex_lock(&cache_lock);
+    size_t bytes = cache_bytes;
+    pthread_mutex_unlock(&cache_lock);
+    return bytes;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file bmap_client.c
+ * @brief Client side of the bmap daemon: bmp_* calls executed remotely.
+ * * Images are shared with the daemon by descriptor. Pixels allocated by
+ * bmp_client_load()/bmp_client_create() live in a size-sealed memfd and are
+ * never copied; heap images and scratch-file images, whose size could still
+ * change under the daemon, are staged through a temporary shared buffer.
+ * @author Arda Aksu
+ * @date 2026
+ * @see bmap_protocol.h for the wire format.
+ */
+
+#define _GNU_SOURCE  /* MSG_CMSG_CLOEXEC */
+
+#include "bmap_internal.h"
+#include "bmap_protocol.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+struct BMPClient {
+    int fd;
+    pthread_mutex_t lock;   /* One request in flight per connection */
+};
+
+BMPClient* bmp_client_connect(const char* socket_path, BMPError* err_out) {
+    struct sockaddr_un addr;
+    if (!socket_path) socket_path = BMP_DAEMON_SOCKET;
+    if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+        if (err_out) *err_out = BMP_ERR_INVALID_ARGUMENT;
+        return NULL;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, socket_path);
+
+    BMPClient* client = (BMPClient*)malloc(sizeof(BMPClient));
+    if (!client) {
+        if (err_out) *err_out = BMP_ERR_MALLOC_FAILED;
+        return NULL;
+    }
+
+    client->fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (client->fd < 0 || connect(client->fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        if (client->fd >= 0) close(client->fd);
+        free(client);
+        if (err_out) *err_out = BMP_ERR_IO;
+        return NULL;
+    }
+
+    pthread_mutex_init(&client->lock, NULL);
+    if (err_out) *err_out = BMP_SUCCESS;
+    return client;
+}
+
+void bmp_client_close(BMPClient* client) {
+    if (!client) return;
+    close(client->fd);
+    pthread_mutex_destroy(&client->lock);
+    free(client);
+}
+
+/* One round trip; updates the image size from the reply */
+static BMPError client_call(BMPClient* client, int shm_fd, BMPImage* image,
+                            const BMPOperation* ops, int op_count) {
+    BmapdRequest req;
+    memset(&req, 0, sizeof(req));
+    req.magic = BMAPD_MAGIC;
+    req.width = image->width;
+    req.height = image->height;
+    req.op_count = op_count;
+    for (int i = 0; i < op_count; i++) req.ops[i] = (int32_t)ops[i];
+
+    union {
+        char buf[CMSG_SPACE(sizeof(int))];
+        struct cmsghdr align;
+    } control;
+    memset(&control, 0, sizeof(control));
+
+    struct iovec iov = { &req, sizeof(req) };
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+
+    struct cmsghdr* c = CMSG_FIRSTHDR(&msg);
+    c->cmsg_level = SOL_SOCKET;
+    c->cmsg_type = SCM_RIGHTS;
+    c->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(c), &shm_fd, sizeof(int));
+
+    BmapdReply reply;
+    pthread_mutex_lock(&client->lock);
+    int ok = sendmsg(client->fd, &msg, MSG_NOSIGNAL) == (ssize_t)sizeof(req) &&
+             recv(client->fd, &reply, sizeof(reply), 0) == (ssize_t)sizeof(reply);
+    pthread_mutex_unlock(&client->lock);
+
+    if (!ok || reply.magic != BMAPD_MAGIC) return BMP_ERR_IO;
+    if (reply.status == BMP_SUCCESS) {
+        image->width = reply.width;
+        image->height = reply.height;
+    }
+    return (BMPError)reply.status;
+}
+
+BMPError bmp_client_apply_operations(BMPClient* client, BMPImage* image,
+                                     const BMPOperation* ops, int op_count) {
+    if (!client || !image || !image->data || op_count < 0 || (op_count > 0 && !ops)) {
+        return BMP_ERR_INVALID_ARGUMENT;
+    }
+    if (op_count == 0) return BMP_SUCCESS;
+
+    BMPImage* target = image;
+    BMPImage* staged = NULL;
+    size_t bytes = (size_t)image->width * image->height * sizeof(Pixel);
+    if (!bmap_fd_size_sealed(bmap_pixels_fd(image->storage))) {
+        BMPError err;
+        staged = bmap_image_create(image->width, image->height, BMAP_STORAGE_SHARED, &err);
+        if (!staged) return err;
+        memcpy(staged->data, image->data, bytes);
+        target = staged;
+    }
+
+    BMPError status = BMP_SUCCESS;
+    for (int done = 0; done < op_count && status == BMP_SUCCESS; done += BMAPD_MAX_OPS) {
+        int n = op_count - done < BMAPD_MAX_OPS ? op_count - done : BMAPD_MAX_OPS;
+        status = client_call(client, bmap_pixels_fd(target->storage), target, ops + done, n);
+    }
+
+    if (staged) {
+        /* Every operation keeps the pixel count, so the original buffer still fits */
+        if (status == BMP_SUCCESS) {
+            memcpy(image->data, staged->data, bytes);
+            image->width = staged->width;
+            image->height = staged->height;
+        }
+        bmp_free(staged);
+    }
+    return status;
+}
+
+#else
+
+BMPClient* bmp_client_connect(const char* socket_path, BMPError* err_out) {
+    (void)socket_path;
+    if (err_out) *err_out = BMP_ERR_IO;
+    return NULL;
+}
+
+void bmp_client_close(BMPClient* client) {
+    (void)client;
+}
+
+BMPError bmp_client_apply_operations(BMPClient* client, BMPImage* image,
+                                     const BMPOperation* ops, int op_count) {
+    (void)client;
+    (void)image;
+    (void)ops;
+    (void)op_count;
+    return BMP_ERR_IO;
+}
+
+#endif
+
+BMPImage* bmp_client_create(int width, int height, BMPError* err_out) {
+    if (width <= 0 || height <= 0) {
+        if (err_out) *err_out = BMP_ERR_INVALID_ARGUMENT;
+        return NULL;
+    }
+    BMPImage* img = bmap_image_create(width, height, BMAP_STORAGE_SHARED, err_out);
+    if (img && err_out) *err_out = BMP_SUCCESS;
+    return img;
+}
+
+BMPImage* bmp_client_load(const char* filename, BMPError* err_out) {
+    return bmap_image_load(filename, BMAP_STORAGE_SHARED, NULL, err_out);
+}
+
+BMPError bmp_client_grayscale(BMPClient* client, BMPImage* image) {
+    BMPOperation op = BMP_OP_GRAYSCALE;
+    return bmp_client_apply_operations(client, image, &op, 1);
+}
+
+BMPError bmp_client_invert(BMPClient* client, BMPImage* image) {
+    BMPOperation op = BMP_OP_INVERT;
+    return bmp_client_apply_operations(client, image, &op, 1);
+}
+
+BMPError bmp_client_flip_horizontal(BMPClient* client, BMPImage* image) {
+    BMPOperation op = BMP_OP_FLIP_HORIZONTAL;
+    return bmp_client_apply_operations(client, image, &op, 1);
+}
+
+BMPError bmp_client_rotate_right(BMPClient* client, BMPImage* image) {
+    BMPOperation op = BMP_OP_ROTATE_RIGHT;
+    return bmp_client_apply_operations(client, image, &op, 1);
+}
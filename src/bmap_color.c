@@ -0,0 +1,397 @@
+/**
+ * @file bmap_color.c
+ * @brief Conversions between packed BGR and HSV, HSL, YCbCr and CIELAB,
+ * and to and from I420/NV12 frames.
+ * * YCbCr is affine, so all four variants are fixed-point matrices run by the
+ * dispatched matrix3 kernel. HSV and HSL need a per-pixel max/min and
+ * division and stay in integer scalar code; Lab decodes sRGB and applies
+ * the cube root through lookup tables and keeps the rest in integers.
+ * Planar variants convert in small stack chunks and split or merge the
+ * channels with the same shuffles the filters use, so no call allocates.
+ * 4:2:0 frames reuse the YCbCr matrices two image rows at a time and
+ * average chroma 2x2 with a dispatched kernel.
+ * @author Arda Aksu
+ * @date 2026
+ * @see bmap.h for the public color space API.
+ */
+
+#include "bmap_internal.h"
+#include <string.h>
+
+#define COLOR_CHUNK 256     /* Pixels per planar conversion chunk */
+
+/* ========================================================================= *
+ * YCBCR MATRICES                               *
+ * ========================================================================= */
+
+#define FIX(x) ((int16_t)((x) * (1 << BMAP_MATRIX_BITS) + ((x) < 0 ? -0.5 : 0.5)))
+
+/* Inputs are bytes B, G, R; ys and cs compress luma and chroma to studio range */
+#define YCBCR_FORWARD(kr, kb, ys, cs, y0)                                                          \
+    { { { FIX((kb) * (ys)), FIX((1.0 - (kr) - (kb)) * (ys)), FIX((kr) * (ys)) },                    \
+        { FIX(0.5 * (cs)), FIX(-(1.0 - (kr) - (kb)) / (2.0 * (1.0 - (kb))) * (cs)),                 \
+          FIX(-(kr) / (2.0 * (1.0 - (kb))) * (cs)) },                                               \
+        { FIX(-(kb) / (2.0 * (1.0 - (kr))) * (cs)), FIX(-(1.0 - (kr) - (kb)) / (2.0 * (1.0 - (kr))) * (cs)), \
+          FIX(0.5 * (cs)) } },                                                                      \
+      { 0, 0, 0 }, { y0, 128, 128 } }
+
+/* Inputs are bytes Y, Cb, Cr; outputs B, G, R */
+#define YCBCR_INVERSE(kr, kb, ys, cs, y0)                                                          \
+    { { { FIX(1.0 / (ys)), FIX(2.0 * (1.0 - (kb)) / (cs)), 0 },                                     \
+        { FIX(1.0 / (ys)), FIX(-2.0 * (kb) * (1.0 - (kb)) / ((1.0 - (kr) - (kb)) * (cs))),          \
+          FIX(-2.0 * (kr) * (1.0 - (kr)) / ((1.0 - (kr) - (kb)) * (cs))) },                         \
+        { FIX(1.0 / (ys)), 0, FIX(2.0 * (1.0 - (kr)) / (cs)) } },                                   \
+      { y0, 128, 128 }, { 0, 0, 0 } }
+
+#define STUDIO_Y (219.0 / 255.0)
+#define STUDIO_C (224.0 / 255.0)
+
+/* Indexed by space - BMP_COLOR_YCBCR601 */
+static const BmapColorMatrix ycbcr_forward[4] = {
+    YCBCR_FORWARD(0.299, 0.114, 1.0, 1.0, 0),
+    YCBCR_FORWARD(0.299, 0.114, STUDIO_Y, STUDIO_C, 16),
+    YCBCR_FORWARD(0.2126, 0.0722, 1.0, 1.0, 0),
+    YCBCR_FORWARD(0.2126, 0.0722, STUDIO_Y, STUDIO_C, 16),
+};
+
+static const BmapColorMatrix ycbcr_inverse[4] = {
+    YCBCR_INVERSE(0.299, 0.114, 1.0, 1.0, 0),
+    YCBCR_INVERSE(0.299, 0.114, STUDIO_Y, STUDIO_C, 16),
+    YCBCR_INVERSE(0.2126, 0.0722, 1.0, 1.0, 0),
+    YCBCR_INVERSE(0.2126, 0.0722, STUDIO_Y, STUDIO_C, 16),
+};
+
+
+/* ========================================================================= *
+ * HSV & HSL                                   *
+ * ========================================================================= */
+
+/* Hue 0..255 (one turn) of a pixel whose channels span max - min = delta > 0 */
+static uint8_t hue_of(int b, int g, int r, int max, int delta) {
+    int n;
+    if (max == r) n = g >= b ? g - b : 6 * delta + g - b;
+    else if (max == g) n = 2 * delta + b - r;
+    else n = 4 * delta + r - g;
+    return (uint8_t)((256 * n + 3 * delta) / (6 * delta));
+}
+
+/*
+ * Writes B, G, R for hue h given chroma c and minimum m, both scaled by
+ * scale; the result is rounded back to 0..255.
+ */
+static void hue_to_bgr(uint8_t* dst, int h, int c, int m, int scale) {
+    int hh = h * 6, sector = hh >> 8;
+    int ramp = hh & 511;
+    int x = (c * (ramp < 256 ? ramp : 512 - ramp) + 128) >> 8;
+    int r, g, b;
+    switch (sector) {
+    case 0: r = c; g = x; b = 0; break;
+    case 1: r = x; g = c; b = 0; break;
+    case 2: r = 0; g = c; b = x; break;
+    case 3: r = 0; g = x; b = c; break;
+    case 4: r = x; g = 0; b = c; break;
+    default: r = c; g = 0; b = x; break;
+    }
+    dst[0] = (uint8_t)((b + m + scale / 2) / scale);
+    dst[1] = (uint8_t)((g + m + scale / 2) / scale);
+    dst[2] = (uint8_t)((r + m + scale / 2) / scale);
+}
+
+static void bgr_to_hsv(uint8_t* dst, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; i++, src += 3, dst += 3) {
+        int b = src[0], g = src[1], r = src[2];
+        int max = b > g ? b : g, min = b < g ? b : g;
+        max = r > max ? r : max;
+        min = r < min ? r : min;
+        int delta = max - min;
+        dst[0] = delta ? hue_of(b, g, r, max, delta) : 0;
+        dst[1] = (uint8_t)(max ? (255 * delta + max / 2) / max : 0);
+        dst[2] = (uint8_t)max;
+    }
+}
+
+static void hsv_to_bgr(uint8_t* dst, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; i++, src += 3, dst += 3) {
+        int h = src[0], s = src[1], v = src[2];
+        int c = v * s;
+        hue_to_bgr(dst, h, c, v * 255 - c, 255);
+    }
+}
+
+static void bgr_to_hsl(uint8_t* dst, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; i++, src += 3, dst += 3) {
+        int b = src[0], g = src[1], r = src[2];
+        int max = b > g ? b : g, min = b < g ? b : g;
+        max = r > max ? r : max;
+        min = r < min ? r : min;
+        int delta = max - min, sum = max + min;
+        int range = sum <= 255 ? sum : 510 - sum;
+        dst[0] = delta ? hue_of(b, g, r, max, delta) : 0;
+        dst[1] = (uint8_t)(delta ? (255 * delta + range / 2) / range : 0);
+        dst[2] = (uint8_t)((sum + 1) / 2);
+    }
+}
+
+static void hsl_to_bgr(uint8_t* dst, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; i++, src += 3, dst += 3) {
+        int h = src[0], s = src[1], l = src[2];
+        int range = 255 - (2 * l > 255 ? 2 * l - 255 : 255 - 2 * l);
+        int c = 2 * range * s;  /* chroma scaled by 510 */
+        hue_to_bgr(dst, h, c, 510 * l - c / 2, 510);
+    }
+}
+
+
+/* ========================================================================= *
+ * CIELAB                                    *
+ * ========================================================================= */
+
+/* sRGB (D65) linear light to white-normalized XYZ, 15 fraction bits */
+#define XYZ_FIX(x) ((uint32_t)((x) * 32768.0 + 0.5))
+static const uint32_t rgb_to_xyz[3][3] = {
+    { XYZ_FIX(0.4124564 / 0.95047), XYZ_FIX(0.3575761 / 0.95047), XYZ_FIX(0.1804375 / 0.95047) },
+    { XYZ_FIX(0.2126729), XYZ_FIX(0.7151522), XYZ_FIX(0.0721750) },
+    { XYZ_FIX(0.0193339 / 1.08883), XYZ_FIX(0.1191920 / 1.08883), XYZ_FIX(0.9503041 / 1.08883) },
+};
+
+/* White-normalized XYZ back to linear R, G, B, 14 fraction bits */
+#define RGB_FIX(x) ((int32_t)((x) * 16384.0 + ((x) < 0 ? -0.5 : 0.5)))
+static const int32_t xyz_to_rgb[3][3] = {
+    { RGB_FIX(3.2404542 * 0.95047), RGB_FIX(-1.5371385), RGB_FIX(-0.4985314 * 1.08883) },
+    { RGB_FIX(-0.9692660 * 0.95047), RGB_FIX(1.8760108), RGB_FIX(0.0415560 * 1.08883) },
+    { RGB_FIX(0.0556434 * 0.95047), RGB_FIX(-0.2040259), RGB_FIX(1.0572252 * 1.08883) },
+};
+
+/* n / d rounded half away from zero, d > 0 */
+static int64_t div_round(int64_t n, int64_t d) {
+    return n >= 0 ? (n + d / 2) / d : -((-n + d / 2) / d);
+}
+
+static uint8_t clamp8(int64_t v) {
+    return (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+/* Inverse of the Lab companding for f scaled by 65535; may leave 0..65535 */
+static int64_t lab_f_inverse(int64_t f) {
+    if (29 * f > 6 * 65535) return f * f / 65535 * f / 65535;
+    return div_round((29 * f - 4 * 65535) * 108, 24389);
+}
+
+static void bgr_to_lab(uint8_t* dst, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; i++, src += 3, dst += 3) {
+        uint32_t rgb[3] = { bmp_srgb_to_linear16[src[2]], bmp_srgb_to_linear16[src[1]],
+                            bmp_srgb_to_linear16[src[0]] };
+        int64_t f[3];
+        for (int k = 0; k < 3; k++) {
+            uint32_t t = (rgb_to_xyz[k][0] * rgb[0] + rgb_to_xyz[k][1] * rgb[1] + rgb_to_xyz[k][2] * rgb[2] +
+                          16384) >> 15;
+            f[k] = bmp_lab_f16[(t > 65535 ? 65535 : t) >> 4];
+        }
+        dst[0] = clamp8(div_round((116 * f[1] - 16 * 65535) * 255, 100 * 65535));
+        dst[1] = clamp8(128 + div_round(500 * (f[0] - f[1]), 65535));
+        dst[2] = clamp8(128 + div_round(200 * (f[1] - f[2]), 65535));
+    }
+}
+
+static void lab_to_bgr(uint8_t* dst, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; i++, src += 3, dst += 3) {
+        int64_t fy = div_round((int64_t)src[0] * 100 * 65535 + 16 * 65535 * 255, 116 * 255);
+        int64_t fx = fy + div_round((int64_t)(src[1] - 128) * 65535, 500);
+        int64_t fz = fy - div_round((int64_t)(src[2] - 128) * 65535, 200);
+        int64_t xyz[3] = { lab_f_inverse(fx), lab_f_inverse(fy), lab_f_inverse(fz) };
+        for (int k = 0; k < 3; k++) {
+            int64_t l = (xyz_to_rgb[k][0] * xyz[0] + xyz_to_rgb[k][1] * xyz[1] + xyz_to_rgb[k][2] * xyz[2] + 8192) >> 14;
+            dst[2 - k] = bmp_linear12_to_srgb[(l < 0 ? 0 : (l > 65535 ? 65535 : l)) >> 4];
+        }
+    }
+}
+
+
+/* ========================================================================= *
+ * CONVERSION API                                *
+ * ========================================================================= */
+
+static int valid_space(BMPColorSpace space) {
+    return space >= BMP_COLOR_HSV && space <= BMP_COLOR_LAB;
+}
+
+/* Both directions allow dst == src: every pixel is read before it is written */
+static void convert_from_bgr(uint8_t* dst, const uint8_t* src, size_t count, BMPColorSpace space) {
+    switch (space) {
+    case BMP_COLOR_HSV: bgr_to_hsv(dst, src, count); break;
+    case BMP_COLOR_HSL: bgr_to_hsl(dst, src, count); break;
+    case BMP_COLOR_LAB: bgr_to_lab(dst, src, count); break;
+    default: bmap_kernels()->matrix3(dst, src, count, &ycbcr_forward[space - BMP_COLOR_YCBCR601]); break;
+    }
+}
+
+static void convert_to_bgr(uint8_t* dst, const uint8_t* src, size_t count, BMPColorSpace space) {
+    switch (space) {
+    case BMP_COLOR_HSV: hsv_to_bgr(dst, src, count); break;
+    case BMP_COLOR_HSL: hsl_to_bgr(dst, src, count); break;
+    case BMP_COLOR_LAB: lab_to_bgr(dst, src, count); break;
+    default: bmap_kernels()->matrix3(dst, src, count, &ycbcr_inverse[space - BMP_COLOR_YCBCR601]); break;
+    }
+}
+
+void bmp_color_from_bgr(uint8_t* dst, const Pixel* src, int count, BMPColorSpace space) {
+    if (!dst || !src || count <= 0 || !valid_space(space)) return;
+    convert_from_bgr(dst, (const uint8_t*)src, (size_t)count, space);
+}
+
+void bmp_color_to_bgr(Pixel* dst, const uint8_t* src, int count, BMPColorSpace space) {
+    if (!dst || !src || count <= 0 || !valid_space(space)) return;
+    convert_to_bgr((uint8_t*)dst, src, (size_t)count, space);
+}
+
+void bmp_color_from_bgr_planar(uint8_t* c0, uint8_t* c1, uint8_t* c2, const Pixel* src, int count,
+                               BMPColorSpace space) {
+    if (!c0 || !c1 || !c2 || !src || count <= 0 || !valid_space(space)) return;
+    const BmapKernels* kernels = bmap_kernels();
+    uint8_t chunk[COLOR_CHUNK * 3];
+    for (int i = 0; i < count; i += COLOR_CHUNK) {
+        int n = count - i < COLOR_CHUNK ? count - i : COLOR_CHUNK;
+        convert_from_bgr(chunk, (const uint8_t*)(src + i), (size_t)n, space);
+        kernels->split3(c0 + i, c1 + i, c2 + i, chunk, (size_t)n);
+    }
+}
+
+void bmp_color_to_bgr_planar(Pixel* dst, const uint8_t* c0, const uint8_t* c1, const uint8_t* c2,
+                             int count, BMPColorSpace space) {
+    if (!dst || !c0 || !c1 || !c2 || count <= 0 || !valid_space(space)) return;
+    bmap_kernels()->merge3((uint8_t*)dst, c0, c1, c2, (size_t)count);
+    convert_to_bgr((uint8_t*)dst, (const uint8_t*)dst, (size_t)count, space);
+}
+
+BMPError bmp_to_color_space(BMPImage* image, BMPColorSpace space) {
+    if (!image || !image->data || !valid_space(space)) return BMP_ERR_INVALID_ARGUMENT;
+    uint8_t* p = (uint8_t*)image->data;
+    convert_from_bgr(p, p, (size_t)image->width * image->height, space);
+    return BMP_SUCCESS;
+}
+
+BMPError bmp_from_color_space(BMPImage* image, BMPColorSpace space) {
+    if (!image || !image->data || !valid_space(space)) return BMP_ERR_INVALID_ARGUMENT;
+    uint8_t* p = (uint8_t*)image->data;
+    convert_to_bgr(p, p, (size_t)image->width * image->height, space);
+    return BMP_SUCCESS;
+}
+
+
+/* ========================================================================= *
+ * YUV 4:2:0 FRAMES                              *
+ * ========================================================================= */
+
+static int ycbcr_space(BMPColorSpace space) {
+    return space >= BMP_COLOR_YCBCR601 && space <= BMP_COLOR_YCBCR709_LIMITED;
+}
+
+static int frame_args_ok(const BMPImage* image, BMPColorSpace space, const uint8_t* y, int y_stride,
+                         const uint8_t* u, int u_stride, const uint8_t* v, int v_stride, int step) {
+    if (!image || !image->data || !y || !u || !v || !ycbcr_space(space)) return 0;
+    int chroma_width = (image->width + 1) / 2;
+    return y_stride >= image->width && u_stride >= chroma_width * step && v_stride >= chroma_width * step;
+}
+
+/*
+ * Converts plane rows row and row + 1 (image rows height - 1 - row and the
+ * one below) per chunk: both rows go through the matrix, Y goes straight to
+ * its plane and the chroma of the pair is averaged down. step is 1 for
+ * separate U and V planes and 2 for NV12, where v == u + 1.
+ */
+static BMPError frame_to_yuv(const BMPImage* image, BMPColorSpace space, uint8_t* y, int y_stride,
+                             uint8_t* u, int u_stride, uint8_t* v, int v_stride, int step) {
+    if (!frame_args_ok(image, space, y, y_stride, u, u_stride, v, v_stride, step)) return BMP_ERR_INVALID_ARGUMENT;
+    const BmapKernels* kernels = bmap_kernels();
+    const BmapColorMatrix* m = &ycbcr_forward[space - BMP_COLOR_YCBCR601];
+    int w = image->width, h = image->height;
+
+    uint8_t ycc[COLOR_CHUNK * 3];
+    uint8_t cb[2][COLOR_CHUNK + 1], cr[2][COLOR_CHUNK + 1];     /* + 1 repeats the edge of odd widths */
+    uint8_t half_cb[COLOR_CHUNK / 2], half_cr[COLOR_CHUNK / 2];
+    for (int row = 0; row < h; row += 2) {
+        int pair = row + 1 < h ? 2 : 1;
+        uint8_t* u_row = u + (size_t)(row / 2) * u_stride;
+        uint8_t* v_row = v + (size_t)(row / 2) * v_stride;
+
+        for (int x = 0; x < w; x += COLOR_CHUNK) {
+            int n = w - x < COLOR_CHUNK ? w - x : COLOR_CHUNK, half = (n + 1) / 2;
+            for (int k = 0; k < pair; k++) {
+                const Pixel* src = image->data + (size_t)(h - 1 - row - k) * w + x;
+                kernels->matrix3(ycc, (const uint8_t*)src, (size_t)n, m);
+                kernels->split3(y + (size_t)(row + k) * y_stride + x, cb[k], cr[k], ycc, (size_t)n);
+            }
+            if (pair == 1) {
+                memcpy(cb[1], cb[0], (size_t)n);
+                memcpy(cr[1], cr[0], (size_t)n);
+            }
+            for (int k = 0; k < 2; k++) {
+                cb[k][n] = cb[k][n - 1];
+                cr[k][n] = cr[k][n - 1];
+            }
+
+            if (step == 1) {
+                kernels->average2x2(u_row + x / 2, cb[0], cb[1], (size_t)half);
+                kernels->average2x2(v_row + x / 2, cr[0], cr[1], (size_t)half);
+                continue;
+            }
+            kernels->average2x2(half_cb, cb[0], cb[1], (size_t)half);
+            kernels->average2x2(half_cr, cr[0], cr[1], (size_t)half);
+            for (int i = 0; i < half; i++) {
+                u_row[(x / 2 + i) * step] = half_cb[i];
+                v_row[(x / 2 + i) * step] = half_cr[i];
+            }
+        }
+    }
+    return BMP_SUCCESS;
+}
+
+/* Inverse of frame_to_yuv(): each chroma chunk is widened once and shared by the row pair */
+static BMPError yuv_to_frame(BMPImage* image, BMPColorSpace space, const uint8_t* y, int y_stride,
+                             const uint8_t* u, int u_stride, const uint8_t* v, int v_stride, int step) {
+    if (!frame_args_ok(image, space, y, y_stride, u, u_stride, v, v_stride, step)) return BMP_ERR_INVALID_ARGUMENT;
+    const BmapKernels* kernels = bmap_kernels();
+    const BmapColorMatrix* m = &ycbcr_inverse[space - BMP_COLOR_YCBCR601];
+    int w = image->width, h = image->height;
+
+    uint8_t cb[COLOR_CHUNK], cr[COLOR_CHUNK];
+    for (int row = 0; row < h; row += 2) {
+        int pair = row + 1 < h ? 2 : 1;
+        const uint8_t* u_row = u + (size_t)(row / 2) * u_stride;
+        const uint8_t* v_row = v + (size_t)(row / 2) * v_stride;
+
+        for (int x = 0; x < w; x += COLOR_CHUNK) {
+            int n = w - x < COLOR_CHUNK ? w - x : COLOR_CHUNK;
+            for (int i = 0; i < n; i++) {
+                cb[i] = u_row[((x + i) >> 1) * step];
+                cr[i] = v_row[((x + i) >> 1) * step];
+            }
+            for (int k = 0; k < pair; k++) {
+                uint8_t* dst = (uint8_t*)(image->data + (size_t)(h - 1 - row - k) * w + x);
+                kernels->merge3(dst, y + (size_t)(row + k) * y_stride + x, cb, cr, (size_t)n);
+                kernels->matrix3(dst, dst, (size_t)n, m);
+            }
+        }
+    }
+    return BMP_SUCCESS;
+}
+
+BMPError bmp_to_i420(const BMPImage* image, BMPColorSpace space, uint8_t* y, int y_stride,
+                     uint8_t* u, int u_stride, uint8_t* v, int v_stride) {
+    return frame_to_yuv(image, space, y, y_stride, u, u_stride, v, v_stride, 1);
+}
+
+BMPError bmp_to_nv12(const BMPImage* image, BMPColorSpace space, uint8_t* y, int y_stride,
+                     uint8_t* uv, int uv_stride) {
+    return frame_to_yuv(image, space, y, y_stride, uv, uv_stride, uv ? uv + 1 : NULL, uv_stride, 2);
+}
+
+BMPError bmp_from_i420(BMPImage* image, BMPColorSpace space, const uint8_t* y, int y_stride,
+                       const uint8_t* u, int u_stride, const uint8_t* v, int v_stride) {
+    return yuv_to_frame(image, space, y, y_stride, u, u_stride, v, v_stride, 1);
+}
+
+BMPError bmp_from_nv12(BMPImage* image, BMPColorSpace space, const uint8_t* y, int y_stride,
+                       const uint8_t* uv, int uv_stride) {
+    return yuv_to_frame(image, space, y, y_stride, uv, uv_stride, uv ? uv + 1 : NULL, uv_stride, 2);
+}
@@ -0,0 +1,249 @@
+/**
+ * @file bmap_compare.c
+ * @brief Image comparison: max difference, MSE, PSNR and SSIM.
+ * * Differences run through the dispatched abs_diff kernel one row at a
+ * time, split across threads by row blocks like bmp_load_region_parallel().
+ * * SSIM follows the usual integral approach: luma sums over 4x4 blocks are
+ * combined into overlapping 8x8 windows with a stride of 4, so every pixel
+ * is read once per image regardless of the window overlap.
+ * @author Arda Aksu
+ * @date 2026
+ * @see bmap.h for the public comparison API.
+ */
+
+#include "bmap_internal.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* (0.01 * 255)^2 and (0.03 * 255)^2 from the SSIM paper */
+#define SSIM_C1 6.5025
+#define SSIM_C2 58.5225
+
+/* Per 4x4 block (or window): sum a, sum b, sum a^2, sum b^2, sum a*b */
+typedef struct {
+    uint64_t a, b, aa, bb, ab;
+} SsimSums;
+
+typedef struct {
+    const BMPImage* a;
+    const BMPImage* b;
+    BMPImage* diff;
+    const BmapKernels* kernels;
+    int row_begin, row_end;         /* Rows for the difference pass */
+    int window_begin, window_end;   /* 8x8 window rows for SSIM */
+    int want_ssim;
+
+    uint64_t squared_sum;
+    uint8_t max_diff;
+    int first_row;                  /* First row with a difference, or -1 */
+    double ssim_sum;
+    int failed;
+} CompareJob;
+
+static uint8_t luma(Pixel p) {
+    return (uint8_t)((p.red * 77 + p.green * 150 + p.blue * 29 + 128) >> 8);
+}
+
+static double ssim_window(const SsimSums* s, double n) {
+    double mu_a = s->a / n, mu_b = s->b / n;
+    double var_a = s->aa / n - mu_a * mu_a;
+    double var_b = s->bb / n - mu_b * mu_b;
+    double cov = s->ab / n - mu_a * mu_b;
+    return ((2 * mu_a * mu_b + SSIM_C1) * (2 * cov + SSIM_C2)) /
+           ((mu_a * mu_a + mu_b * mu_b + SSIM_C1) * (var_a + var_b + SSIM_C2));
+}
+
+/* Accumulates luma sums of the block x0..x0+w, y0..y0+h */
+static void ssim_block(const BMPImage* a, const BMPImage* b, int x0, int y0, int w, int h, SsimSums* s) {
+    memset(s, 0, sizeof(*s));
+    for (int y = y0; y < y0 + h; y++) {
+        const Pixel* ra = &a->data[(size_t)y * a->width];
+        const Pixel* rb = &b->data[(size_t)y * b->width];
+        for (int x = x0; x < x0 + w; x++) {
+            uint32_t la = luma(ra[x]), lb = luma(rb[x]);
+            s->a += la;
+            s->b += lb;
+            s->aa += la * la;
+            s->bb += lb * lb;
+            s->ab += la * lb;
+        }
+    }
+}
+
+/* Sums of every 4x4 block in block row block_y, streaming the four pixel rows in order */
+static void ssim_block_row(const BMPImage* a, const BMPImage* b, int block_y, SsimSums* blocks) {
+    int blocks_x = a->width / 4;
+    memset(blocks, 0, (size_t)blocks_x * sizeof(SsimSums));
+    for (int y = block_y * 4; y < block_y * 4 + 4; y++) {
+        const Pixel* ra = &a->data[(size_t)y * a->width];
+        const Pixel* rb = &b->data[(size_t)y * b->width];
+        for (int bx = 0; bx < blocks_x; bx++, ra += 4, rb += 4) {
+            uint32_t sa = 0, sb = 0, saa = 0, sbb = 0, sab = 0;
+            for (int k = 0; k < 4; k++) {
+                uint32_t la = luma(ra[k]), lb = luma(rb[k]);
+                sa += la;
+                sb += lb;
+                saa += la * la;
+                sbb += lb * lb;
+                sab += la * lb;
+            }
+            blocks[bx].a += sa;
+            blocks[bx].b += sb;
+            blocks[bx].aa += saa;
+            blocks[bx].bb += sbb;
+            blocks[bx].ab += sab;
+        }
+    }
+}
+
+static void compare_ssim(CompareJob* job) {
+    int blocks_x = job->a->width / 4;
+    SsimSums* rows = (SsimSums*)malloc(2 * (size_t)blocks_x * sizeof(SsimSums));
+    if (!rows) {
+        job->failed = 1;
+        return;
+    }
+    SsimSums* top = rows;
+    SsimSums* bottom = rows + blocks_x;
+
+    /* Window row wy covers block rows wy and wy + 1 */
+    ssim_block_row(job->a, job->b, job->window_begin, top);
+    for (int wy = job->window_begin; wy < job->window_end; wy++) {
+        ssim_block_row(job->a, job->b, wy + 1, bottom);
+        for (int bx = 0; bx + 1 < blocks_x; bx++) {
+            SsimSums s;
+            s.a = top[bx].a + top[bx + 1].a + bottom[bx].a + bottom[bx + 1].a;
+            s.b = top[bx].b + top[bx + 1].b + bottom[bx].b + bottom[bx + 1].b;
+            s.aa = top[bx].aa + top[bx + 1].aa + bottom[bx].aa + bottom[bx + 1].aa;
+            s.bb = top[bx].bb + top[bx + 1].bb + bottom[bx].bb + bottom[bx + 1].bb;
+            s.ab = top[bx].ab + top[bx + 1].ab + bottom[bx].ab + bottom[bx + 1].ab;
+            job->ssim_sum += ssim_window(&s, 64.0);
+        }
+        SsimSums* t = top;
+        top = bottom;
+        bottom = t;
+    }
+    free(rows);
+}
+
+static void* compare_rows(void* arg) {
+    CompareJob* job = (CompareJob*)arg;
+    size_t row_bytes = (size_t)job->a->width * sizeof(Pixel);
+    for (int y = job->row_begin; y < job->row_end; y++) {
+        size_t offset = (size_t)y * job->a->width;
+        uint64_t sum = job->kernels->abs_diff(job->diff ? (uint8_t*)&job->diff->data[offset] : NULL,
+                                              (const uint8_t*)&job->a->data[offset],
+                                              (const uint8_t*)&job->b->data[offset],
+                                              row_bytes, &job->max_diff);
+        if (sum && job->first_row < 0) job->first_row = y;
+        job->squared_sum += sum;
+    }
+    if (job->want_ssim) compare_ssim(job);
+    return NULL;
+}
+
+/* First differing pixel of a row known to differ */
+static int first_column(const BMPImage* a, const BMPImage* b, int y) {
+    const Pixel* ra = &a->data[(size_t)y * a->width];
+    const Pixel* rb = &b->data[(size_t)y * b->width];
+    int x = 0;
+    while (x < a->width && memcmp(&ra[x], &rb[x], sizeof(Pixel)) == 0) x++;
+    return x;
+}
+
+static BMPError compare_exact(const BMPImage* a, const BMPImage* b, BMPCompareResult* result) {
+    size_t row_bytes = (size_t)a->width * sizeof(Pixel);
+    for (int y = 0; y < a->height; y++) {
+        if (memcmp(&a->data[(size_t)y * a->width], &b->data[(size_t)y * b->width], row_bytes) == 0) continue;
+
+        int x = first_column(a, b, y);
+        uint8_t max = 0;
+        bmap_kernels()->abs_diff(NULL, (const uint8_t*)&a->data[(size_t)y * a->width + x],
+                                 (const uint8_t*)&b->data[(size_t)y * b->width + x], sizeof(Pixel), &max);
+        result->max_abs_diff = max;
+        result->first_x = x;
+        result->first_y = y;
+        return BMP_SUCCESS;
+    }
+    return BMP_SUCCESS;
+}
+
+BMPError bmp_compare(const BMPImage* a, const BMPImage* b, int flags, int threads,
+                     BMPImage* diff, BMPCompareResult* result) {
+    if (!a || !a->data || !b || !b->data || !result ||
+        a->width != b->width || a->height != b->height ||
+        (diff && (!diff->data || diff->width != a->width || diff->height != a->height))) {
+        return BMP_ERR_INVALID_ARGUMENT;
+    }
+
+    memset(result, 0, sizeof(*result));
+    result->first_x = result->first_y = -1;
+    result->mse = NAN;
+    result->psnr = NAN;
+    result->ssim = NAN;
+    if (flags & BMP_COMPARE_EXACT) return compare_exact(a, b, result);
+
+    /* Window rows exist only for images of at least 8x8 */
+    int window_rows = a->width >= 8 && a->height >= 8 ? a->height / 4 - 1 : 0;
+    int want_ssim = (flags & BMP_COMPARE_SSIM) != 0;
+
+    if (threads > a->height) threads = a->height;
+    if (threads > BMP_COMPARE_MAX_THREADS) threads = BMP_COMPARE_MAX_THREADS;
+    if (threads < 1) threads = 1;
+
+    CompareJob jobs[BMP_COMPARE_MAX_THREADS];
+    pthread_t workers[BMP_COMPARE_MAX_THREADS];
+    int started[BMP_COMPARE_MAX_THREADS] = {0};
+
+    for (int t = 0; t < threads; t++) {
+        CompareJob* job = &jobs[t];
+        memset(job, 0, sizeof(*job));
+        job->a = a;
+        job->b = b;
+        job->diff = diff;
+        job->kernels = bmap_kernels();
+        job->row_begin = (int)((int64_t)a->height * t / threads);
+        job->row_end = (int)((int64_t)a->height * (t + 1) / threads);
+        job->window_begin = (int)((int64_t)window_rows * t / threads);
+        job->window_end = (int)((int64_t)window_rows * (t + 1) / threads);
+        job->want_ssim = want_ssim && job->window_begin < job->window_end;
+        job->first_row = -1;
+        /* The calling thread takes the first block itself */
+        if (t > 0) started[t] = pthread_create(&workers[t], NULL, compare_rows, job) == 0;
+    }
+    compare_rows(&jobs[0]);
+
+    uint64_t squared_sum = 0;
+    double ssim_sum = 0;
+    int failed = 0;
+    for (int t = 0; t < threads; t++) {
+        if (t > 0 && started[t]) pthread_join(workers[t], NULL);
+        else if (t > 0) compare_rows(&jobs[t]);
+
+        squared_sum += jobs[t].squared_sum;
+        ssim_sum += jobs[t].ssim_sum;
+        failed |= jobs[t].failed;
+        if (jobs[t].max_diff > result->max_abs_diff) result->max_abs_diff = jobs[t].max_diff;
+        if (result->first_y < 0 && jobs[t].first_row >= 0) {
+            result->first_y = jobs[t].first_row;
+            result->first_x = first_column(a, b, jobs[t].first_row);
+        }
+    }
+    if (failed) return BMP_ERR_MALLOC_FAILED;
+
+    result->mse = (double)squared_sum / ((double)a->width * a->height * 3);
+    result->psnr = squared_sum ? 10.0 * log10(255.0 * 255.0 / result->mse) : INFINITY;
+    if (want_ssim) {
+        if (window_rows > 0) {
+            result->ssim = ssim_sum / ((double)window_rows * (a->width / 4 - 1));
+        } else {
+            /* Too small for 8x8 windows: one window over the whole image */
+            SsimSums s;
+            ssim_block(a, b, 0, 0, a->width, a->height, &s);
+            result->ssim = ssim_window(&s, (double)a->width * a->height);
+        }
+    }
+    return BMP_SUCCESS;
+}
@@ -0,0 +1,376 @@
+/**
+ * @file bmap_daemon.c
+ * @brief Local image-processing daemon: one worker pool for many processes.
+ * * The calling thread polls the listening socket and every idle connection.
+ * A readable connection is handed to the worker pool, which serves exactly
+ * one request on it and passes it back through a pipe, so a few busy clients
+ * cannot starve the rest. Pixels arrive as a shared-memory descriptor, sealed
+ * against shrinking so the mapping cannot be cut short under the worker, and
+ * are processed in place; each worker keeps one reusable buffer for rotations.
+ * @author Arda Aksu
+ * @date 2026
+ * @see bmap_protocol.h for the wire format.
+ */
+
+#define _GNU_SOURCE  /* MSG_CMSG_CLOEXEC, pipe2() */
+
+#include "bmap_internal.h"
+#include "bmap_protocol.h"
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#endif
+
+#define DAEMON_MAX_CLIENTS 1024
+#define DAEMON_MAX_THREADS 256
+#define DAEMON_ACCEPT_RETRY_MS 100  /* Pause before accepting again after running out of descriptors */
+
+/* Write end of the running daemon's wake-up pipe, -1 when not running */
+static volatile sig_atomic_t daemon_wake_fd = -1;
+
+#ifndef _WIN32
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+    int fds[DAEMON_MAX_CLIENTS];    /* Ring of connections with a pending request */
+    int head, count;
+    int live;                       /* Open client connections, wherever they currently are */
+    int stopping;
+    int return_fd;                  /* Served connections go back to the poll loop here */
+} DaemonQueue;
+
+/* Per-worker rotation buffer, grown on demand and reused across requests */
+typedef struct {
+    Pixel* data;
+    size_t capacity;
+} WorkerBuffer;
+
+static BMPError run_operations(Pixel* pixels, BmapdRequest* req, WorkerBuffer* buffer) {
+    size_t bytes = (size_t)req->width * req->height * sizeof(Pixel);
+    BMPImage images[2] = {
+        { req->width, req->height, pixels, NULL },
+        { 0, 0, NULL, NULL }
+    };
+    int current = 0;
+
+    for (int i = 0; i < req->op_count; i++) {
+        if (req->ops[i] != BMP_OP_ROTATE_RIGHT) {
+            BMPOperation op = (BMPOperation)req->ops[i];
+            bmp_apply_operations(&images[current], &op, 1);
+            continue;
+        }
+
+        /* Rotation cannot run in place: ping-pong between the mapping and the buffer */
+        if (buffer->capacity < bytes) {
+            Pixel* grown = (Pixel*)realloc(buffer->data, bytes);
+            if (!grown) return BMP_ERR_MALLOC_FAILED;
+            buffer->data = grown;
+            buffer->capacity = bytes;
+        }
+        BMPImage* src = &images[current];
+        BMPImage* dst = &images[1 - current];
+        dst->data = current == 0 ? buffer->data : pixels;
+        dst->width = src->height;
+        dst->height = src->width;
+        bmp_rotate_right_into(src, dst);
+        current = 1 - current;
+    }
+
+    if (current == 1) memcpy(pixels, images[1].data, bytes);
+    req->width = images[current].width;
+    req->height = images[current].height;
+    return BMP_SUCCESS;
+}
+
+static BMPError serve_mapping(int shm_fd, BmapdRequest* req, WorkerBuffer* buffer) {
+    if (req->width <= 0 || req->height <= 0 || req->op_count < 0 || req->op_count > BMAPD_MAX_OPS) {
+        return BMP_ERR_INVALID_ARGUMENT;
+    }
+    for (int i = 0; i < req->op_count; i++) {
+        if (req->ops[i] < BMP_OP_GRAYSCALE || req->ops[i] > BMP_OP_ROTATE_RIGHT) {
+            return BMP_ERR_INVALID_ARGUMENT;
+        }
+    }
+
+    /* A mapping shorter than the claimed size would fault instead of failing;
+     * the seal keeps the client from shrinking the file after the size check */
+    size_t bytes = (size_t)req->width * req->height * sizeof(Pixel);
+    struct stat st;
+    if (!bmap_fd_size_sealed(shm_fd) ||
+        fstat(shm_fd, &st) != 0 || st.st_size < 0 || (size_t)st.st_size < bytes) {
+        return BMP_ERR_INVALID_ARGUMENT;
+    }
+
+    void* base = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+    if (base == MAP_FAILED) return BMP_ERR_IO;
+    BMPError status = run_operations((Pixel*)base, req, buffer);
+    munmap(base, bytes);
+    return status;
+}
+
+/* Serves one request; returns 0 once the connection should be closed */
+static int serve_request(int fd, WorkerBuffer* buffer) {
+    BmapdRequest req;
+    char control[CMSG_SPACE(sizeof(int))];
+    struct iovec iov = { &req, sizeof(req) };
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t n = recvmsg(fd, &msg, MSG_CMSG_CLOEXEC);
+    if (n <= 0) return 0;
+
+    int shm_fd = -1;
+    for (struct cmsghdr* c = CMSG_FIRSTHDR(&msg); c; c = CMSG_NXTHDR(&msg, c)) {
+        if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_RIGHTS &&
+            c->cmsg_len == CMSG_LEN(sizeof(int))) {
+            memcpy(&shm_fd, CMSG_DATA(c), sizeof(int));
+        }
+    }
+
+    BmapdReply reply = { BMAPD_MAGIC, BMP_ERR_INVALID_ARGUMENT, 0, 0 };
+    if (n == (ssize_t)sizeof(req) && req.magic == BMAPD_MAGIC && shm_fd >= 0 &&
+        !(msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))) {
+        reply.status = serve_mapping(shm_fd, &req, buffer);
+        reply.width = req.width;
+        reply.height = req.height;
+    }
+    if (shm_fd >= 0) close(shm_fd);
+
+    /* A client that stops reading replies is dropped; blocking here would park the worker past bmp_daemon_stop() */
+    return send(fd, &reply, sizeof(reply), MSG_NOSIGNAL | MSG_DONTWAIT) == (ssize_t)sizeof(reply);
+}
+
+static void daemon_close(DaemonQueue* queue, int fd) {
+    close(fd);
+    pthread_mutex_lock(&queue->lock);
+    queue->live--;
+    pthread_mutex_unlock(&queue->lock);
+}
+
+static void* daemon_worker(void* arg) {
+    DaemonQueue* queue = (DaemonQueue*)arg;
+    WorkerBuffer buffer = { NULL, 0 };
+
+    for (;;) {
+        pthread_mutex_lock(&queue->lock);
+        while (queue->count == 0 && !queue->stopping) pthread_cond_wait(&queue->ready, &queue->lock);
+        if (queue->stopping) {
+            pthread_mutex_unlock(&queue->lock);
+            break;
+        }
+        int fd = queue->fds[queue->head];
+        queue->head = (queue->head + 1) % DAEMON_MAX_CLIENTS;
+        queue->count--;
+        pthread_mutex_unlock(&queue->lock);
+
+        if (!serve_request(fd, &buffer) ||
+            write(queue->return_fd, &fd, sizeof(fd)) != (ssize_t)sizeof(fd)) {
+            daemon_close(queue, fd);
+        }
+    }
+
+    free(buffer.data);
+    return NULL;
+}
+
+/* Binds socket_path, replacing a socket nobody is listening on any more */
+static int daemon_listen(const char* socket_path) {
+    struct sockaddr_un addr;
+    if (strlen(socket_path) >= sizeof(addr.sun_path)) return -1;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        int probe = errno == EADDRINUSE ? socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0) : -1;
+        int alive = probe >= 0 && connect(probe, (struct sockaddr*)&addr, sizeof(addr)) == 0;
+        struct stat st;
+        int stale = probe >= 0 && !alive && lstat(socket_path, &st) == 0 && S_ISSOCK(st.st_mode);
+        if (probe >= 0) close(probe);
+
+        if (!stale || unlink(socket_path) != 0 ||
+            bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+            close(fd);
+            return -1;
+        }
+    }
+
+    if (listen(fd, 64) != 0) {
+        close(fd);
+        unlink(socket_path);
+        return -1;
+    }
+    return fd;
+}
+
+BMPError bmp_daemon_run(const char* socket_path, int threads) {
+    if (!socket_path) socket_path = BMP_DAEMON_SOCKET;
+    if (threads <= 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads < 1) threads = 1;
+    if (threads > DAEMON_MAX_THREADS) threads = DAEMON_MAX_THREADS;
+
+    int wake[2], returned[2];
+    if (pipe2(wake, O_CLOEXEC | O_NONBLOCK) != 0) return BMP_ERR_IO;
+    if (pipe2(returned, O_CLOEXEC) != 0) {
+        close(wake[0]);
+        close(wake[1]);
+        return BMP_ERR_IO;
+    }
+
+    daemon_wake_fd = wake[1];  /* A stop requested during setup is seen by the first poll */
+
+    int listen_fd = daemon_listen(socket_path);
+    if (listen_fd < 0) {
+        daemon_wake_fd = -1;
+        close(wake[0]);
+        close(wake[1]);
+        close(returned[0]);
+        close(returned[1]);
+        return BMP_ERR_IO;
+    }
+
+    DaemonQueue queue;
+    memset(&queue, 0, sizeof(queue));
+    pthread_mutex_init(&queue.lock, NULL);
+    pthread_cond_init(&queue.ready, NULL);
+    queue.return_fd = returned[1];
+
+    pthread_t workers[DAEMON_MAX_THREADS];
+    int started = 0;
+    while (started < threads && pthread_create(&workers[started], NULL, daemon_worker, &queue) == 0) {
+        started++;
+    }
+    BMPError status = started > 0 ? BMP_SUCCESS : BMP_ERR_IO;
+
+    /* Slots 0-2 are the wake pipe, the return pipe and the listener; idle clients follow */
+    struct pollfd fds[3 + DAEMON_MAX_CLIENTS];
+    int nfds = 3;
+    fds[0].fd = wake[0];
+    fds[1].fd = returned[0];
+    fds[2].fd = listen_fd;
+    for (int i = 0; i < 3; i++) fds[i].events = POLLIN;
+
+    while (status == BMP_SUCCESS) {
+        /* While accepting is paused the listener is left out and polled again after a delay */
+        int ready = poll(fds, nfds, fds[2].events ? -1 : DAEMON_ACCEPT_RETRY_MS);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            status = BMP_ERR_IO;
+            break;
+        }
+        if (ready == 0) fds[2].events = POLLIN;
+        if (fds[0].revents) break;
+
+        /* Hand every readable client to the pool, compacting the idle set */
+        int kept = 3;
+        for (int i = 3; i < nfds; i++) {
+            if (fds[i].revents) {
+                pthread_mutex_lock(&queue.lock);
+                queue.fds[(queue.head + queue.count) % DAEMON_MAX_CLIENTS] = fds[i].fd;
+                queue.count++;
+                pthread_cond_signal(&queue.ready);
+                pthread_mutex_unlock(&queue.lock);
+            } else {
+                fds[kept++] = fds[i];
+            }
+        }
+        nfds = kept;
+
+        if (fds[1].revents) {
+            int fd;
+            if (read(returned[0], &fd, sizeof(fd)) == (ssize_t)sizeof(fd)) {
+                fds[nfds].fd = fd;
+                fds[nfds].events = POLLIN;
+                fds[nfds].revents = 0;
+                nfds++;
+            }
+        }
+
+        if (fds[2].revents) {
+            int client = accept4(listen_fd, NULL, NULL, SOCK_CLOEXEC);
+            if (client >= 0) {
+                /* Every open connection is idle, queued, being served or in the return pipe,
+                 * so capping the live count keeps both the poll set and the ring in bounds */
+                pthread_mutex_lock(&queue.lock);
+                int admit = queue.live < DAEMON_MAX_CLIENTS;
+                if (admit) queue.live++;
+                pthread_mutex_unlock(&queue.lock);
+                if (!admit) {
+                    close(client);
+                } else {
+                    fds[nfds].fd = client;
+                    fds[nfds].events = POLLIN;
+                    fds[nfds].revents = 0;
+                    nfds++;
+                }
+            } else if (errno == EMFILE || errno == ENFILE) {
+                /* The pending connection stays readable; polling it now would spin */
+                fds[2].events = 0;
+            }
+        }
+    }
+
+    daemon_wake_fd = -1;
+    pthread_mutex_lock(&queue.lock);
+    queue.stopping = 1;
+    pthread_cond_broadcast(&queue.ready);
+    pthread_mutex_unlock(&queue.lock);
+    for (int i = 0; i < started; i++) pthread_join(workers[i], NULL);
+
+    /* Close idle clients, clients still queued and clients the workers returned */
+    for (int i = 3; i < nfds; i++) close(fds[i].fd);
+    for (int i = 0; i < queue.count; i++) close(queue.fds[(queue.head + i) % DAEMON_MAX_CLIENTS]);
+    close(returned[1]);
+    int fd;
+    while (read(returned[0], &fd, sizeof(fd)) == (ssize_t)sizeof(fd)) close(fd);
+
+    close(listen_fd);
+    unlink(socket_path);
+    close(wake[0]);
+    close(wake[1]);
+    close(returned[0]);
+    pthread_cond_destroy(&queue.ready);
+    pthread_mutex_destroy(&queue.lock);
+    return status;
+}
+
+void bmp_daemon_stop(void) {
+    int fd = daemon_wake_fd;
+    if (fd >= 0) {
+        char byte = 1;
+        ssize_t ignored = write(fd, &byte, 1);
+        (void)ignored;
+    }
+}
+
+#else
+
+BMPError bmp_daemon_run(const char* socket_path, int threads) {
+    (void)socket_path;
+    (void)threads;
+    return BMP_ERR_IO;
+}
+
+void bmp_daemon_stop(void) {
+}
+
+#endif
@@ -0,0 +1,286 @@
+/**
+ * @file bmap_draw.c
+ * @brief Drawing primitives: lines, rectangles, circles and polygons.
+ * * Every primitive clips against the image once up front and then writes
+ * straight through row pointers: lines compute the range of steps that land
+ * inside the image before stepping, and filled shapes are decomposed into
+ * horizontal spans handed to bmp_fill_span() / bmp_fill_rect().
+ * Coordinates are those of bmp_set_pixel(): x to the right, y = row index.
+ * @author Arda Aksu
+ * @date 2026
+ * @see bmap.h for the public drawing API.
+ */
+
+#include "bmap_internal.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define POLYGON_STACK_EDGES 64  /* Scanline crossings kept on the stack */
+
+/* --- Lines --- */
+
+/*
+ * A line is walked along its major axis: step i moves the major coordinate
+ * by one and the minor coordinate is n0 + round(i * |dn| / |dm|) in the
+ * direction of dn, which is exactly Bresenham's choice.
+ */
+typedef struct {
+    int64_t n0, adm, adn;
+    int sn;
+} LineSteps;
+
+/*
+ * Returns (2 * i * |dn| + |dm|) / (2 * |dm|), the rounded minor offset of step
+ * 0 <= i <= |dm|, and stores the remainder. Coordinates are ints, so i and
+ * |dn| are at most |dm| < 2^32 and i * |dn| fits in 64 unsigned bits; only the
+ * remainder of that product by |dm| is doubled.
+ */
+static int64_t minor_offset(const LineSteps* l, int64_t i, int64_t* remainder) {
+    uint64_t adm = (uint64_t)l->adm, p = (uint64_t)i * (uint64_t)l->adn;
+    uint64_t r = 2 * (p % adm) + adm;
+    if (remainder) *remainder = (int64_t)(r % (2 * adm));
+    return (int64_t)(p / adm + r / (2 * adm));
+}
+
+static int64_t minor_at(const LineSteps* l, int64_t i) {
+    if (l->adm == 0) return l->n0;
+    return l->n0 + l->sn * minor_offset(l, i, NULL);
+}
+
+/* First step in lo..hi whose minor coordinate has reached target, or hi + 1 */
+static int64_t first_reaching(const LineSteps* l, int64_t lo, int64_t hi, int64_t target) {
+    while (lo <= hi) {
+        int64_t mid = lo + (hi - lo) / 2;
+        if (l->sn * (minor_at(l, mid) - target) >= 0) hi = mid - 1;
+        else lo = mid + 1;
+    }
+    return lo;
+}
+
+void bmp_draw_line(BMPImage* image, int x0, int y0, int x1, int y1, Pixel color) {
+    if (!image || !image->data) return;
+
+    int64_t dx = (int64_t)x1 - x0, dy = (int64_t)y1 - y0;
+    int x_major = llabs(dx) >= llabs(dy);
+    int64_t m0 = x_major ? x0 : y0, dm = x_major ? dx : dy, dn = x_major ? dy : dx;
+    int64_t m_lim = x_major ? image->width : image->height;
+    int64_t n_lim = x_major ? image->height : image->width;
+    int sm = dm < 0 ? -1 : 1;
+    LineSteps l = { x_major ? y0 : x0, llabs(dm), llabs(dn), dn < 0 ? -1 : 1 };
+
+    /* Steps whose major coordinate is inside the image... */
+    int64_t lo = sm > 0 ? -m0 : m0 - (m_lim - 1);
+    int64_t hi = sm > 0 ? m_lim - 1 - m0 : m0;
+    if (lo < 0) lo = 0;
+    if (hi > l.adm) hi = l.adm;
+    if (lo > hi) return;
+
+    /* ...narrowed to those whose minor coordinate is too; it moves monotonically */
+    lo = first_reaching(&l, lo, hi, l.sn > 0 ? 0 : n_lim - 1);
+    hi = first_reaching(&l, lo, hi, l.sn > 0 ? n_lim : -1) - 1;
+    if (lo > hi) return;
+
+    int64_t m = m0 + sm * lo, n = minor_at(&l, lo);
+    Pixel* p = x_major ? bmp_row(image, (int)n) + m : bmp_row(image, (int)m) + n;
+    ptrdiff_t step_m = x_major ? sm : sm * (ptrdiff_t)image->width;
+    ptrdiff_t step_n = x_major ? l.sn * (ptrdiff_t)image->width : l.sn;
+
+    /* Remainder of 2 * i * |dn| + |dm| modulo 2 * |dm| decides each minor step */
+    int64_t twice_adm = 2 * l.adm;
+    int64_t r = 0;
+    if (l.adm) minor_offset(&l, lo, &r);
+    for (int64_t i = lo;; i++) {
+        *p = color;
+        if (i == hi) break;
+        p += step_m;
+        r += 2 * l.adn;
+        if (r >= twice_adm) {
+            r -= twice_adm;
+            p += step_n;
+        }
+    }
+}
+
+/* Blends color into the pixel at major m, minor n with coverage 0..1, if inside */
+static void plot_aa(BMPImage* image, int steep, double m, double n, double coverage, Pixel color) {
+    double x = steep ? n : m, y = steep ? m : n;
+    if (x < 0 || x >= image->width || y < 0 || y >= image->height || coverage <= 0) return;
+    uint32_t a = coverage >= 1 ? 255 : (uint32_t)(coverage * 255 + 0.5);
+    Pixel* p = bmp_row(image, (int)y) + (int)x;
+    p->blue = bmap_div255(color.blue * a + p->blue * (255 - a));
+    p->green = bmap_div255(color.green * a + p->green * (255 - a));
+    p->red = bmap_div255(color.red * a + p->red * (255 - a));
+}
+
+void bmp_draw_line_aa(BMPImage* image, float x0, float y0, float x1, float y1, Pixel color) {
+    if (!image || !image->data || !isfinite(x0) || !isfinite(y0) || !isfinite(x1) || !isfinite(y1)) return;
+
+    /* Xiaolin Wu's algorithm in (major, minor) coordinates, walking the major axis upwards */
+    int steep = fabs((double)y1 - y0) > fabs((double)x1 - x0);
+    double m0 = steep ? y0 : x0, n0 = steep ? x0 : y0;
+    double m1 = steep ? y1 : x1, n1 = steep ? x1 : y1;
+    if (m0 > m1) {
+        double t = m0; m0 = m1; m1 = t;
+        t = n0; n0 = n1; n1 = t;
+    }
+    double dm = m1 - m0;
+    double gradient = dm == 0 ? 1 : (n1 - n0) / dm;
+    double m_lim = steep ? image->height : image->width;
+
+    /* Endpoints get partial coverage along the major axis */
+    double start = floor(m0 + 0.5), end = floor(m1 + 0.5);
+    double n_start = n0 + gradient * (start - m0), n_end = n1 + gradient * (end - m1);
+    double gap = 1 - (m0 + 0.5 - floor(m0 + 0.5));
+    plot_aa(image, steep, start, floor(n_start), (1 - (n_start - floor(n_start))) * gap, color);
+    plot_aa(image, steep, start, floor(n_start) + 1, (n_start - floor(n_start)) * gap, color);
+    if (end != start) {
+        gap = m1 + 0.5 - floor(m1 + 0.5);
+        plot_aa(image, steep, end, floor(n_end), (1 - (n_end - floor(n_end))) * gap, color);
+        plot_aa(image, steep, end, floor(n_end) + 1, (n_end - floor(n_end)) * gap, color);
+    }
+
+    /* Interior steps, clipped to the image along the major axis once */
+    double first = start + 1 > 0 ? start + 1 : 0;
+    double last = end - 1 < m_lim - 1 ? end - 1 : m_lim - 1;
+    double n = n_start + gradient * (first - start);
+    for (double m = first; m <= last; m++, n += gradient) {
+        double base = floor(n), frac = n - base;
+        plot_aa(image, steep, m, base, 1 - frac, color);
+        plot_aa(image, steep, m, base + 1, frac, color);
+    }
+}
+
+/* --- Rectangles --- */
+
+void bmp_draw_rect(BMPImage* image, int x, int y, int w, int h, int thickness, Pixel color) {
+    if (!image || !image->data || w <= 0 || h <= 0 || thickness <= 0) return;
+    if (2 * (int64_t)thickness >= w || 2 * (int64_t)thickness >= h) {
+        bmp_fill_rect(image, x, y, w, h, color);
+        return;
+    }
+    int64_t right = (int64_t)x + w - thickness, top = (int64_t)y + h - thickness;
+    if (right > INT32_MAX || top > INT32_MAX) return;
+
+    bmp_fill_rect(image, x, y, w, thickness, color);
+    bmp_fill_rect(image, x, (int)top, w, thickness, color);
+    bmp_fill_rect(image, x, y + thickness, thickness, h - 2 * thickness, color);
+    bmp_fill_rect(image, (int)right, y + thickness, thickness, h - 2 * thickness, color);
+}
+
+/* --- Circles --- */
+
+/*
+ * Circles are the integer disc x^2 + y^2 <= r^2 + r around the center. Each
+ * row of it is one span, so fills write spans and outlines write the ends of
+ * each span not covered by the next row outwards.
+ */
+
+/* Half-width of the disc at row offset dy, or -1 if the row is outside it */
+static int64_t disc_half(int64_t limit, int64_t dy) {
+    int64_t rest = limit - dy * dy;
+    if (rest < 0) return -1;
+    int64_t half = (int64_t)sqrt((double)rest);
+    while (half * half > rest) half--;
+    while ((half + 1) * (half + 1) <= rest) half++;
+    return half;
+}
+
+/* Fills x0..x1 of row, clipped to the image */
+static void fill_clipped(BMPImage* image, int64_t x0, int64_t x1, int64_t row, Pixel color) {
+    if (x1 < 0 || x0 >= image->width) return;
+    if (x0 < 0) x0 = 0;
+    if (x1 > image->width - 1) x1 = image->width - 1;
+    bmp_fill_span(image, (int)x0, (int)row, (int)(x1 - x0 + 1), color);
+}
+
+/* Rows of the circle inside the image; returns 0 if there are none */
+static int circle_rows(const BMPImage* image, int cy, int radius, int64_t* first, int64_t* last) {
+    *first = (int64_t)cy - radius;
+    *last = (int64_t)cy + radius;
+    if (*first < 0) *first = 0;
+    if (*last > image->height - 1) *last = image->height - 1;
+    return *first <= *last;
+}
+
+void bmp_draw_circle(BMPImage* image, int cx, int cy, int radius, Pixel color) {
+    int64_t first, last;
+    if (!image || !image->data || radius < 0 || !circle_rows(image, cy, radius, &first, &last)) return;
+
+    int64_t limit = (int64_t)radius * radius + radius;
+    for (int64_t row = first; row <= last; row++) {
+        int64_t dy = row > cy ? row - cy : cy - row;
+        int64_t half = disc_half(limit, dy), outer = disc_half(limit, dy + 1);
+        int64_t inner = outer + 1 < half ? outer + 1 : half;
+        fill_clipped(image, (int64_t)cx + inner, (int64_t)cx + half, row, color);
+        fill_clipped(image, (int64_t)cx - half, (int64_t)cx - inner, row, color);
+    }
+}
+
+void bmp_fill_circle(BMPImage* image, int cx, int cy, int radius, Pixel color) {
+    int64_t first, last;
+    if (!image || !image->data || radius < 0 || !circle_rows(image, cy, radius, &first, &last)) return;
+
+    int64_t limit = (int64_t)radius * radius + radius;
+    for (int64_t row = first; row <= last; row++) {
+        int64_t half = disc_half(limit, row - cy);
+        fill_clipped(image, (int64_t)cx - half, (int64_t)cx + half, row, color);
+    }
+}
+
+/* --- Polygons --- */
+
+void bmp_draw_polygon(BMPImage* image, const int* points, int count, Pixel color) {
+    if (!image || !image->data || !points || count < 1) return;
+    for (int i = 0; i < count; i++) {
+        int j = i + 1 < count ? i + 1 : 0;
+        bmp_draw_line(image, points[2 * i], points[2 * i + 1], points[2 * j], points[2 * j + 1], color);
+    }
+}
+
+BMPError bmp_fill_polygon(BMPImage* image, const int* points, int count, Pixel color) {
+    if (!image || !image->data || !points || count < 3) return BMP_ERR_INVALID_ARGUMENT;
+
+    int64_t min_y = points[1], max_y = points[1];
+    for (int i = 1; i < count; i++) {
+        if (points[2 * i + 1] < min_y) min_y = points[2 * i + 1];
+        if (points[2 * i + 1] > max_y) max_y = points[2 * i + 1];
+    }
+    if (min_y < 0) min_y = 0;
+    if (max_y > image->height - 1) max_y = image->height - 1;
+    if (min_y > max_y) return BMP_SUCCESS;
+
+    double stack_crossings[POLYGON_STACK_EDGES];
+    double* crossings = count <= POLYGON_STACK_EDGES ? stack_crossings : (double*)malloc((size_t)count * sizeof(double));
+    if (!crossings) return BMP_ERR_MALLOC_FAILED;
+
+    /* Even-odd rule, sampling every scanline at pixel centers */
+    for (int64_t row = min_y; row <= max_y; row++) {
+        double center = (double)row + 0.5;
+        int n = 0;
+        for (int i = 0; i < count; i++) {
+            int j = i + 1 < count ? i + 1 : 0;
+            double ax = points[2 * i], ay = points[2 * i + 1], bx = points[2 * j], by = points[2 * j + 1];
+            if ((ay <= center) == (by <= center)) continue;
+            double x = ax + (center - ay) * (bx - ax) / (by - ay);
+
+            /* Insertion keeps the crossings sorted; scanlines cross few edges */
+            int k = n++;
+            while (k > 0 && crossings[k - 1] > x) {
+                crossings[k] = crossings[k - 1];
+                k--;
+            }
+            crossings[k] = x;
+        }
+
+        /* Pixels whose centers lie between a pair of crossings */
+        for (int k = 0; k + 1 < n; k += 2) {
+            double x0 = ceil(crossings[k] - 0.5), x1 = ceil(crossings[k + 1] - 0.5) - 1;
+            if (x0 < 0) x0 = 0;
+            if (x1 > image->width - 1) x1 = image->width - 1;
+            if (x0 <= x1) fill_clipped(image, (int64_t)x0, (int64_t)x1, row, color);
+        }
+    }
+
+    if (crossings != stack_crossings) free(crossings);
+    return BMP_SUCCESS;
+}
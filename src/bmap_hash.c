@@ -0,0 +1,349 @@
+/**
+ * @file bmap_hash.c
+ * @brief Exact content hashes of pixel data (XXH3, 64 and 128 bit).
+ * * Output is bit-identical to XXH3_64bits() and XXH3_128bits() with seed 0
+ * over the packed pixel bytes, so hashes can be reproduced with any xxHash
+ * implementation. Long inputs go through the dispatched hash_stripes kernel;
+ * the streaming state lets bmp_load_hashed() fold each row in while it is
+ * still in cache.
+ * @author Arda Aksu
+ * @date 2026
+ * @see bmap.h for the public hashing API.
+ */
+
+#include "bmap_internal.h"
+#include <string.h>
+
+#define HASH_SECRET_SIZE 192
+#define HASH_STRIPES_PER_BLOCK ((HASH_SECRET_SIZE - 64) / 8)
+#define HASH_MIDSIZE_MAX 240
+
+#define PRIME32_1 0x9E3779B1u
+#define PRIME32_2 0x85EBCA77u
+#define PRIME32_3 0xC2B2AE3Du
+#define PRIME64_1 0x9E3779B185EBCA87ull
+#define PRIME64_2 0xC2B2AE3D27D4EB4Full
+#define PRIME64_3 0x165667B19E3779F9ull
+#define PRIME64_4 0x85EBCA77C2B2AE63ull
+#define PRIME64_5 0x27D4EB2F165667C5ull
+#define PRIME_MX1 0x165667919E3779F9ull
+#define PRIME_MX2 0x9FB21C651E98DF25ull
+
+/* The XXH3 default secret */
+static const uint8_t hash_secret[HASH_SECRET_SIZE] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+/* --- Primitives --- */
+
+static uint32_t read32(const uint8_t* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint64_t read64(const uint8_t* p) {
+    return (uint64_t)read32(p) | (uint64_t)read32(p + 4) << 32;
+}
+
+static uint64_t rotl64(uint64_t v, int r) {
+    return v << r | v >> (64 - r);
+}
+
+static uint64_t swap64(uint64_t v) {
+    return __builtin_bswap64(v);
+}
+
+static BMPHash128 mul128(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 p = (unsigned __int128)a * b;
+    BMPHash128 r = { (uint64_t)p, (uint64_t)(p >> 64) };
+#else
+    /* Schoolbook 32x32 products, as in the reference XXH3 fallback */
+    uint64_t lo_lo = (a & 0xFFFFFFFFu) * (b & 0xFFFFFFFFu);
+    uint64_t hi_lo = (a >> 32) * (b & 0xFFFFFFFFu);
+    uint64_t lo_hi = (a & 0xFFFFFFFFu) * (b >> 32);
+    uint64_t hi_hi = (a >> 32) * (b >> 32);
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+    BMPHash128 r = { (cross << 32) | (lo_lo & 0xFFFFFFFFu), (hi_lo >> 32) + (cross >> 32) + hi_hi };
+#endif
+    return r;
+}
+
+static uint64_t mul128_fold64(uint64_t a, uint64_t b) {
+    BMPHash128 p = mul128(a, b);
+    return p.low ^ p.high;
+}
+
+static uint64_t xxh64_avalanche(uint64_t h) {
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    return h ^ (h >> 32);
+}
+
+static uint64_t avalanche(uint64_t h) {
+    h ^= h >> 37;
+    h *= PRIME_MX1;
+    return h ^ (h >> 32);
+}
+
+static uint64_t rrmxmx(uint64_t h, uint64_t len) {
+    h ^= rotl64(h, 49) ^ rotl64(h, 24);
+    h *= PRIME_MX2;
+    h ^= (h >> 35) + len;
+    h *= PRIME_MX2;
+    return h ^ (h >> 28);
+}
+
+static uint64_t mix16(const uint8_t* in, const uint8_t* secret) {
+    return mul128_fold64(read64(in) ^ read64(secret), read64(in + 8) ^ read64(secret + 8));
+}
+
+static BMPHash128 mix32(BMPHash128 acc, const uint8_t* in1, const uint8_t* in2, const uint8_t* secret) {
+    acc.low += mix16(in1, secret);
+    acc.low ^= read64(in2) + read64(in2 + 8);
+    acc.high += mix16(in2, secret + 16);
+    acc.high ^= read64(in1) + read64(in1 + 8);
+    return acc;
+}
+
+/* --- Short Inputs (up to 240 bytes) --- */
+
+static uint64_t hash64_short(const uint8_t* in, size_t len) {
+    const uint8_t* s = hash_secret;
+    if (len == 0) return xxh64_avalanche(read64(s + 56) ^ read64(s + 64));
+    if (len <= 3) {
+        uint32_t combined = (uint32_t)in[0] << 16 | (uint32_t)in[len >> 1] << 24 | in[len - 1] | (uint32_t)len << 8;
+        return xxh64_avalanche(combined ^ (uint64_t)(read32(s) ^ read32(s + 4)));
+    }
+    if (len <= 8) {
+        uint64_t input = read32(in + len - 4) + ((uint64_t)read32(in) << 32);
+        return rrmxmx(input ^ (read64(s + 8) ^ read64(s + 16)), len);
+    }
+    if (len <= 16) {
+        uint64_t lo = read64(in) ^ (read64(s + 24) ^ read64(s + 32));
+        uint64_t hi = read64(in + len - 8) ^ (read64(s + 40) ^ read64(s + 48));
+        return avalanche(len + swap64(lo) + hi + mul128_fold64(lo, hi));
+    }
+
+    uint64_t acc = len * PRIME64_1;
+    if (len <= 128) {
+        if (len > 32) {
+            if (len > 64) {
+                if (len > 96) acc += mix16(in + 48, s + 96) + mix16(in + len - 64, s + 112);
+                acc += mix16(in + 32, s + 64) + mix16(in + len - 48, s + 80);
+            }
+            acc += mix16(in + 16, s + 32) + mix16(in + len - 32, s + 48);
+        }
+        return avalanche(acc + mix16(in, s) + mix16(in + len - 16, s + 16));
+    }
+
+    for (int i = 0; i < 8; i++) acc += mix16(in + 16 * i, s + 16 * i);
+    uint64_t tail = mix16(in + len - 16, s + 136 - 17);
+    acc = avalanche(acc);
+    for (size_t i = 8; i < len / 16; i++) tail += mix16(in + 16 * i, s + 16 * (i - 8) + 3);
+    return avalanche(acc + tail);
+}
+
+static BMPHash128 hash128_short(const uint8_t* in, size_t len) {
+    const uint8_t* s = hash_secret;
+    BMPHash128 h;
+    if (len == 0) {
+        h.low = xxh64_avalanche(read64(s + 64) ^ read64(s + 72));
+        h.high = xxh64_avalanche(read64(s + 80) ^ read64(s + 88));
+        return h;
+    }
+    if (len <= 3) {
+        uint32_t lo = (uint32_t)in[0] << 16 | (uint32_t)in[len >> 1] << 24 | in[len - 1] | (uint32_t)len << 8;
+        uint32_t hi = __builtin_bswap32(lo);
+        hi = hi << 13 | hi >> 19;
+        h.low = xxh64_avalanche(lo ^ (uint64_t)(read32(s) ^ read32(s + 4)));
+        h.high = xxh64_avalanche(hi ^ (uint64_t)(read32(s + 8) ^ read32(s + 12)));
+        return h;
+    }
+    if (len <= 8) {
+        uint64_t input = read32(in) + ((uint64_t)read32(in + len - 4) << 32);
+        h = mul128(input ^ (read64(s + 16) ^ read64(s + 24)), PRIME64_1 + (len << 2));
+        h.high += h.low << 1;
+        h.low ^= h.high >> 3;
+        h.low ^= h.low >> 35;
+        h.low *= PRIME_MX2;
+        h.low ^= h.low >> 28;
+        h.high = avalanche(h.high);
+        return h;
+    }
+    if (len <= 16) {
+        uint64_t lo = read64(in), hi = read64(in + len - 8);
+        BMPHash128 m = mul128(lo ^ hi ^ (read64(s + 32) ^ read64(s + 40)), PRIME64_1);
+        m.low += (uint64_t)(len - 1) << 54;
+        hi ^= read64(s + 48) ^ read64(s + 56);
+        m.high += hi + (uint64_t)(uint32_t)hi * (PRIME32_2 - 1);
+        m.low ^= swap64(m.high);
+        h = mul128(m.low, PRIME64_2);
+        h.high += m.high * PRIME64_2;
+        h.low = avalanche(h.low);
+        h.high = avalanche(h.high);
+        return h;
+    }
+
+    BMPHash128 acc = { len * PRIME64_1, 0 };
+    if (len <= 128) {
+        if (len > 32) {
+            if (len > 64) {
+                if (len > 96) acc = mix32(acc, in + 48, in + len - 64, s + 96);
+                acc = mix32(acc, in + 32, in + len - 48, s + 64);
+            }
+            acc = mix32(acc, in + 16, in + len - 32, s + 32);
+        }
+        acc = mix32(acc, in, in + len - 16, s);
+    } else {
+        for (size_t i = 32; i < 160; i += 32) acc = mix32(acc, in + i - 32, in + i - 16, s + i - 32);
+        acc.low = avalanche(acc.low);
+        acc.high = avalanche(acc.high);
+        for (size_t i = 160; i <= len; i += 32) acc = mix32(acc, in + i - 32, in + i - 16, s + 3 + i - 160);
+        acc = mix32(acc, in + len - 16, in + len - 32, s + 136 - 17 - 16);
+    }
+    h.low = avalanche(acc.low + acc.high);
+    h.high = 0 - avalanche(acc.low * PRIME64_1 + acc.high * PRIME64_4 + len * PRIME64_2);
+    return h;
+}
+
+/* --- Streaming Long Inputs --- */
+
+static void scramble(uint64_t* acc) {
+    const uint8_t* key = hash_secret + HASH_SECRET_SIZE - 64;
+    for (int i = 0; i < 8; i++) {
+        uint64_t a = acc[i];
+        a ^= a >> 47;
+        a ^= read64(key + 8 * i);
+        acc[i] = a * PRIME32_1;
+    }
+}
+
+/* Accumulates whole stripes, scrambling at every block boundary */
+static void consume_stripes(uint64_t* acc, size_t* stripes_so_far, const uint8_t* in, size_t stripes) {
+    const BmapKernels* kernels = bmap_kernels();
+    while (stripes > 0) {
+        size_t room = HASH_STRIPES_PER_BLOCK - *stripes_so_far;
+        size_t n = stripes < room ? stripes : room;
+        kernels->hash_stripes(acc, in, hash_secret + *stripes_so_far * 8, n);
+        in += n * 64;
+        stripes -= n;
+        *stripes_so_far += n;
+        if (*stripes_so_far == HASH_STRIPES_PER_BLOCK) {
+            scramble(acc);
+            *stripes_so_far = 0;
+        }
+    }
+}
+
+void bmap_hash_init(BmapHashState* state) {
+    static const uint64_t init[8] = {
+        PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3, PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1
+    };
+    memcpy(state->acc, init, sizeof(init));
+    state->buffered = 0;
+    state->stripes = 0;
+    state->total = 0;
+}
+
+void bmap_hash_update(BmapHashState* state, const void* data, size_t len) {
+    const uint8_t* in = (const uint8_t*)data;
+    const uint8_t* end = in + len;
+    state->total += len;
+
+    if (state->buffered + len <= sizeof(state->buffer)) {
+        memcpy(state->buffer + state->buffered, in, len);
+        state->buffered += len;
+        return;
+    }
+
+    /* Input is only consumed while more follows, so the digest always has a tail to finish */
+    if (state->buffered) {
+        size_t fill = sizeof(state->buffer) - state->buffered;
+        memcpy(state->buffer + state->buffered, in, fill);
+        in += fill;
+        consume_stripes(state->acc, &state->stripes, state->buffer, sizeof(state->buffer) / 64);
+        state->buffered = 0;
+    }
+    if ((size_t)(end - in) > sizeof(state->buffer)) {
+        size_t stripes = (size_t)(end - in - 1) / 64;
+        consume_stripes(state->acc, &state->stripes, in, stripes);
+        in += stripes * 64;
+        memcpy(state->buffer + sizeof(state->buffer) - 64, in - 64, 64);
+    }
+    memcpy(state->buffer, in, (size_t)(end - in));
+    state->buffered = (size_t)(end - in);
+}
+
+/* Finishes the accumulators on a copy so the state can keep streaming */
+static void digest_acc(const BmapHashState* state, uint64_t* acc) {
+    memcpy(acc, state->acc, sizeof(state->acc));
+    size_t stripes = state->stripes;
+    uint8_t last[64];
+    if (state->buffered >= 64) {
+        consume_stripes(acc, &stripes, state->buffer, (state->buffered - 1) / 64);
+        memcpy(last, state->buffer + state->buffered - 64, 64);
+    } else {
+        /* Borrow the end of the previously consumed stripe */
+        size_t catchup = 64 - state->buffered;
+        memcpy(last, state->buffer + sizeof(state->buffer) - catchup, catchup);
+        memcpy(last + catchup, state->buffer, state->buffered);
+    }
+    bmap_kernels()->hash_stripes(acc, last, hash_secret + HASH_SECRET_SIZE - 64 - 7, 1);
+}
+
+static uint64_t merge_accs(const uint64_t* acc, const uint8_t* secret, uint64_t start) {
+    for (int i = 0; i < 4; i++) {
+        start += mul128_fold64(acc[2 * i] ^ read64(secret + 16 * i), acc[2 * i + 1] ^ read64(secret + 16 * i + 8));
+    }
+    return avalanche(start);
+}
+
+uint64_t bmap_hash_digest64(const BmapHashState* state) {
+    if (state->total <= HASH_MIDSIZE_MAX) return hash64_short(state->buffer, (size_t)state->total);
+    uint64_t acc[8];
+    digest_acc(state, acc);
+    return merge_accs(acc, hash_secret + 11, state->total * PRIME64_1);
+}
+
+BMPHash128 bmap_hash_digest128(const BmapHashState* state) {
+    if (state->total <= HASH_MIDSIZE_MAX) return hash128_short(state->buffer, (size_t)state->total);
+    uint64_t acc[8];
+    digest_acc(state, acc);
+    BMPHash128 h;
+    h.low = merge_accs(acc, hash_secret + 11, state->total * PRIME64_1);
+    h.high = merge_accs(acc, hash_secret + HASH_SECRET_SIZE - 64 - 11, ~(state->total * PRIME64_2));
+    return h;
+}
+
+/* --- Public API --- */
+
+uint64_t bmp_hash(const BMPImage* image) {
+    BmapHashState state;
+    bmap_hash_init(&state);
+    if (image && image->data) {
+        bmap_hash_update(&state, image->data, (size_t)image->width * image->height * sizeof(Pixel));
+    }
+    return bmap_hash_digest64(&state);
+}
+
+BMPHash128 bmp_hash128(const BMPImage* image) {
+    BmapHashState state;
+    bmap_hash_init(&state);
+    if (image && image->data) {
+        bmap_hash_update(&state, image->data, (size_t)image->width * image->height * sizeof(Pixel));
+    }
+    return bmap_hash_digest128(&state);
+}
@@ -0,0 +1,168 @@
+/**
+ * @file bmap_internal.h
+ * @brief Helpers shared between the library's translation units.
+ * Not installed and not part of the public API.
+ * @author Arda Aksu
+ * @date 2026
+ */
+
+#ifndef BMAP_INTERNAL_H
+#define BMAP_INTERNAL_H
+
+#include "bmap.h"
+
+/** Storage kinds accepted by bmap_pixels_alloc(). */
+#define BMAP_STORAGE_HEAP 0     /**< malloc(), spilling to scratch if configured */
+#define BMAP_STORAGE_SCRATCH 1  /**< Unlinked file in the scratch directory */
+#define BMAP_STORAGE_SHARED 2   /**< Anonymous shared memory (memfd) for the daemon */
+
+/**
+ * @brief Allocates pixel storage for count pixels.
+ * Heap storage falls back to a file-backed mapping when a scratch directory
+ * is configured and the heap allocation fails.
+ * @param kind One of the BMAP_STORAGE_* values.
+ * @param storage Receives the mapping handle (NULL for heap memory).
+ */
+Pixel* bmap_pixels_alloc(size_t count, int kind, void** storage);
+
+/**
+ * @brief Releases storage obtained from bmap_pixels_alloc().
+ */
+void bmap_pixels_free(Pixel* data, void* storage);
+
+/**
+ * @brief Drops resident pages of a mapped range; the data stays in the
+ * scratch file. No-op for heap storage.
+ */
+void bmap_pixels_evict(void* storage, const void* addr, size_t len);
+
+/**
+ * @brief Returns the kind storage was allocated as (BMAP_STORAGE_HEAP for
+ * heap memory and for heap allocations that spilled to scratch), so derived
+ * images can be allocated alike.
+ */
+int bmap_pixels_kind(const void* storage);
+
+/**
+ * @brief Returns the descriptor behind mapped storage, or -1 for heap memory.
+ * The mapping starts at offset 0 and spans exactly the pixel bytes.
+ */
+int bmap_pixels_fd(const void* storage);
+
+/**
+ * @brief Returns nonzero if fd cannot shrink any more, so a mapping of its
+ * current size stays valid whatever the other holders of fd do. Shared
+ * storage is sealed this way; scratch files cannot be. Where the platform
+ * has no file seals every valid descriptor counts as sealed.
+ */
+int bmap_fd_size_sealed(int fd);
+
+/**
+ * @brief Reads exactly len bytes at offset with positioned reads (pread, or
+ * ReadFile with an OVERLAPPED offset on Windows), retrying on short reads.
+ * Each read carries its own offset, so it is safe to call concurrently on one
+ * descriptor. The file position is untouched with pread() but not preserved
+ * on Windows, where ReadFile() on a synchronous handle moves it.
+ * @return 0 on success, -1 on error or end of file.
+ */
+int bmap_read_at(int fd, void* buf, size_t len, uint64_t offset);
+
+/**
+ * @brief bmp_load_region_parallel() on an already open descriptor, which is
+ * left open. Lets callers fstat() and load the very same file.
+ */
+BMPImage* bmap_load_region_fd(int fd, int x, int y, int w, int h, int threads, BMPError* err_out);
+
+/**
+ * @brief Allocates an image header plus pixels of the given storage kind.
+ */
+BMPImage* bmap_image_create(int width, int height, int kind, BMPError* err_out);
+
+/**
+ * @brief Streaming XXH3 state (seed 0, default secret) used by bmp_hash()
+ * and by loads that hash rows as they arrive.
+ */
+typedef struct {
+    uint64_t acc[8];
+    uint8_t buffer[256];    /**< Pending input; its last stripe is kept for the final catch-up */
+    size_t buffered;
+    size_t stripes;         /**< Stripes consumed in the current block */
+    uint64_t total;
+} BmapHashState;
+
+void bmap_hash_init(BmapHashState* state);
+void bmap_hash_update(BmapHashState* state, const void* data, size_t len);
+uint64_t bmap_hash_digest64(const BmapHashState* state);
+BMPHash128 bmap_hash_digest128(const BmapHashState* state);
+
+/**
+ * @brief bmp_load() into storage of the given kind, feeding each row to hash
+ * (may be NULL) as it is read.
+ */
+BMPImage* bmap_image_load(const char* filename, int kind, BmapHashState* hash, BMPError* err_out);
+
+/** Rounded x / 255, exact for x <= 255 * 255; shared by the scalar blend paths. */
+static inline uint8_t bmap_div255(uint32_t x) {
+    x += 128;
+    return (uint8_t)((x + (x >> 8)) >> 8);
+}
+
+/** Fraction bits of BmapColorMatrix coefficients. */
+#define BMAP_MATRIX_BITS 13
+
+/**
+ * @brief Affine 3x3 transform of byte triples for the matrix3 kernel:
+ * out[k] = clamp(((sum_j coeff[k][j] * (in[j] - in_offset[j]) + 2^12) >> 13) + out_offset[k]).
+ */
+typedef struct {
+    int16_t coeff[3][3];        /**< [output byte][input byte], BMAP_MATRIX_BITS fraction bits */
+    int16_t in_offset[3];
+    int16_t out_offset[3];
+} BmapColorMatrix;
+
+/**
+ * @brief Table of hot pixel kernels for one instruction set.
+ * Kernels operate on tightly packed pixels; callers loop over rows.
+ */
+typedef struct {
+    const char* name;                               /**< "scalar", "sse4.1", "avx2" or "avx512" */
+    void (*grayscale)(Pixel* px, size_t count);
+    void (*invert)(Pixel* px, size_t count);
+    void (*flip_row)(Pixel* row, int width);
+    /** Turns a rows x cols block a quarter clockwise: dst[j * dst_stride + rows - 1 - i]
+     *  = src[i * src_stride + j], strides in pixels; dst must not overlap src */
+    void (*rotate_tile)(Pixel* dst, size_t dst_stride, const Pixel* src, size_t src_stride, int rows, int cols);
+    /** Copies count 3-byte pixels exchanging bytes 0 and 2 (RGB <-> BGR); dst may equal src */
+    void (*swap_rb)(uint8_t* dst, const uint8_t* src, size_t count);
+    /** Returns the sum of squared byte differences, raises *max_out to the largest
+     *  one and, if dst is not NULL, stores |a - b| there */
+    uint64_t (*abs_diff)(uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t bytes, uint8_t* max_out);
+    /** XXH3 stripe accumulation: folds stripes 64-byte stripes into the eight
+     *  accumulators, advancing the secret by 8 bytes per stripe */
+    void (*hash_stripes)(uint64_t* acc, const uint8_t* in, const uint8_t* secret, size_t stripes);
+    /** Per byte: dst = (b * a + dst * (255 - a)) / 255, rounded, where b is the mode's
+     *  blend of src and dst and a is alpha[i] * opacity / 255, or opacity when alpha is NULL */
+    void (*blend)(uint8_t* dst, const uint8_t* src, const uint8_t* alpha, uint8_t opacity,
+                  size_t bytes, BMPBlendMode mode);
+    /** As blend, in linear light: src and dst bytes are decoded through bmp_srgb_to_linear16,
+     *  blended and mixed scaled to 65535 and re-encoded through bmp_linear12_to_srgb */
+    void (*blend_linear)(uint8_t* dst, const uint8_t* src, const uint8_t* alpha, uint8_t opacity,
+                         size_t bytes, BMPBlendMode mode);
+    /** Writes every byte of src three times, e.g. a coverage mask as per-channel alpha */
+    void (*expand3)(uint8_t* dst, const uint8_t* src, size_t count);
+    /** Applies m to count byte triples; dst may equal src */
+    void (*matrix3)(uint8_t* dst, const uint8_t* src, size_t count, const BmapColorMatrix* m);
+    /** Splits count byte triples into three planes */
+    void (*split3)(uint8_t* c0, uint8_t* c1, uint8_t* c2, const uint8_t* src, size_t count);
+    /** Interleaves three planes into count byte triples */
+    void (*merge3)(uint8_t* dst, const uint8_t* c0, const uint8_t* c1, const uint8_t* c2, size_t count);
+    /** dst[i] = rounded mean of row0[2i], row0[2i + 1], row1[2i] and row1[2i + 1] */
+    void (*average2x2)(uint8_t* dst, const uint8_t* row0, const uint8_t* row1, size_t count);
+} BmapKernels;
+
+/**
+ * @brief Returns the kernel table selected for this CPU (chosen once).
+ */
+const BmapKernels* bmap_kernels(void);
+
+#endif // BMAP_INTERNAL_H
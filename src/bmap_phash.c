@@ -0,0 +1,194 @@
+/**
+ * @file bmap_phash.c
+ * @brief Perceptual hashes (aHash, dHash, pHash) for near-duplicate search.
+ * * Every hash starts from a small luma grid built in one pass over the
+ * image. Each grid cell averages an evenly spaced sample of at most
+ * HASH_SAMPLES x HASH_SAMPLES pixels, so only a fraction of the rows of a
+ * large image is touched and the cost stays nearly flat with image size.
+ * pHash then takes a separable 32x32 DCT, keeping only the 8x8 lowest
+ * frequencies. Grid rows run top to bottom, as the image is displayed.
+ * @author Arda Aksu
+ * @date 2026
+ * @see bmap.h for the public hashing API.
+ */
+
+#include "bmap_internal.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HASH_SAMPLES 16     /* Samples per grid cell along each axis */
+#define HASH_MAX_GRID 32
+#define HASH_PI 3.14159265358979323846
+
+static float dct_table[8][32];  /* cos((2x + 1) u pi / 64), scaled for an orthonormal DCT-II */
+static pthread_once_t dct_once = PTHREAD_ONCE_INIT;
+
+static void dct_init(void) {
+    for (int u = 0; u < 8; u++) {
+        double scale = u == 0 ? sqrt(1.0 / 32) : sqrt(2.0 / 32);
+        for (int x = 0; x < 32; x++) dct_table[u][x] = (float)(scale * cos((2 * x + 1) * u * HASH_PI / 64));
+    }
+}
+
+/* Averages luma into a cols x rows grid, top row first */
+static void luma_grid(const BMPImage* image, int cols, int rows, float* grid) {
+    int step_x = image->width / (cols * HASH_SAMPLES);
+    int step_y = image->height / (rows * HASH_SAMPLES);
+    if (step_x < 1) step_x = 1;
+    if (step_y < 1) step_y = 1;
+
+    uint32_t sums[HASH_MAX_GRID * HASH_MAX_GRID] = {0};
+    uint32_t counts[HASH_MAX_GRID * HASH_MAX_GRID] = {0};
+    uint8_t cell_x[HASH_MAX_GRID * HASH_SAMPLES * 2];
+    int samples_x = 0;
+    for (int x = step_x / 2; x < image->width && samples_x < (int)sizeof(cell_x); x += step_x) {
+        cell_x[samples_x++] = (uint8_t)((int64_t)x * cols / image->width);
+    }
+
+    for (int top = step_y / 2; top < image->height; top += step_y) {
+        int cell_y = (int)((int64_t)top * rows / image->height);
+        const Pixel* row = &image->data[(size_t)(image->height - 1 - top) * image->width];
+        uint32_t* cell_sums = &sums[cell_y * cols];
+        uint32_t* cell_counts = &counts[cell_y * cols];
+        for (int i = 0, x = step_x / 2; i < samples_x; i++, x += step_x) {
+            Pixel p = row[x];
+            cell_sums[cell_x[i]] += (uint32_t)(p.red * 77 + p.green * 150 + p.blue * 29 + 128) >> 8;
+            cell_counts[cell_x[i]]++;
+        }
+    }
+
+    /* Images smaller than the grid leave some cells empty; those take the pixel under the cell */
+    for (int gy = 0; gy < rows; gy++) {
+        for (int gx = 0; gx < cols; gx++) {
+            int i = gy * cols + gx;
+            if (counts[i]) {
+                grid[i] = (float)sums[i] / counts[i];
+            } else {
+                int x = (int)((int64_t)gx * image->width / cols);
+                int top = (int)((int64_t)gy * image->height / rows);
+                Pixel p = image->data[(size_t)(image->height - 1 - top) * image->width + x];
+                grid[i] = (float)((p.red * 77 + p.green * 150 + p.blue * 29 + 128) >> 8);
+            }
+        }
+    }
+}
+
+static int compare_floats(const void* a, const void* b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+uint64_t bmp_ahash(const BMPImage* image) {
+    if (!image || !image->data || image->width <= 0 || image->height <= 0) return 0;
+
+    float grid[64];
+    luma_grid(image, 8, 8, grid);
+    float mean = 0;
+    for (int i = 0; i < 64; i++) mean += grid[i];
+    mean /= 64;
+
+    uint64_t hash = 0;
+    for (int i = 0; i < 64; i++) hash = hash << 1 | (grid[i] > mean);
+    return hash;
+}
+
+uint64_t bmp_dhash(const BMPImage* image) {
+    if (!image || !image->data || image->width <= 0 || image->height <= 0) return 0;
+
+    float grid[9 * 8];
+    luma_grid(image, 9, 8, grid);
+
+    uint64_t hash = 0;
+    for (int y = 0; y < 8; y++) {
+        for (int x = 0; x < 8; x++) hash = hash << 1 | (grid[y * 9 + x + 1] > grid[y * 9 + x]);
+    }
+    return hash;
+}
+
+uint64_t bmp_phash(const BMPImage* image) {
+    if (!image || !image->data || image->width <= 0 || image->height <= 0) return 0;
+    pthread_once(&dct_once, dct_init);
+
+    float grid[32 * 32], rows[32][8], coeffs[64];
+    luma_grid(image, 32, 32, grid);
+
+    /* Separable DCT: 8 frequencies per row, then 8 per column */
+    for (int y = 0; y < 32; y++) {
+        for (int u = 0; u < 8; u++) {
+            float sum = 0;
+            for (int x = 0; x < 32; x++) sum += grid[y * 32 + x] * dct_table[u][x];
+            rows[y][u] = sum;
+        }
+    }
+    for (int v = 0; v < 8; v++) {
+        for (int u = 0; u < 8; u++) {
+            float sum = 0;
+            for (int y = 0; y < 32; y++) sum += rows[y][u] * dct_table[v][y];
+            coeffs[v * 8 + u] = sum;
+        }
+    }
+
+    /* The median ignores the DC term, which only tracks overall brightness */
+    float sorted[63];
+    memcpy(sorted, coeffs + 1, sizeof(sorted));
+    qsort(sorted, 63, sizeof(float), compare_floats);
+    float median = sorted[31];
+
+    uint64_t hash = 0;
+    for (int i = 0; i < 64; i++) hash = hash << 1 | (coeffs[i] > median);
+    return hash;
+}
+
+int bmp_hamming_distance(uint64_t a, uint64_t b) {
+    return __builtin_popcountll(a ^ b);
+}
+
+/* --- Batch Hashing --- */
+
+typedef struct {
+    const BMPImage* const* images;
+    uint64_t* hashes;
+    uint64_t (*hash)(const BMPImage*);
+    int begin, end;
+} HashJob;
+
+static void* hash_images(void* arg) {
+    HashJob* job = (HashJob*)arg;
+    for (int i = job->begin; i < job->end; i++) job->hashes[i] = job->hash(job->images[i]);
+    return NULL;
+}
+
+BMPError bmp_perceptual_hash_batch(const BMPImage* const* images, int count, BMPPerceptualHash kind,
+                                   int threads, uint64_t* hashes) {
+    uint64_t (*hash)(const BMPImage*) = kind == BMP_PERCEPTUAL_AHASH ? bmp_ahash :
+                                        kind == BMP_PERCEPTUAL_DHASH ? bmp_dhash :
+                                        kind == BMP_PERCEPTUAL_PHASH ? bmp_phash : NULL;
+    if (!hash || count < 0 || (count > 0 && (!images || !hashes))) return BMP_ERR_INVALID_ARGUMENT;
+    if (count == 0) return BMP_SUCCESS;
+
+    if (threads > count) threads = count;
+    if (threads > BMP_PERCEPTUAL_MAX_THREADS) threads = BMP_PERCEPTUAL_MAX_THREADS;
+    if (threads < 1) threads = 1;
+
+    HashJob jobs[BMP_PERCEPTUAL_MAX_THREADS];
+    pthread_t workers[BMP_PERCEPTUAL_MAX_THREADS];
+    int started[BMP_PERCEPTUAL_MAX_THREADS] = {0};
+
+    for (int t = 0; t < threads; t++) {
+        jobs[t].images = images;
+        jobs[t].hashes = hashes;
+        jobs[t].hash = hash;
+        jobs[t].begin = (int)((int64_t)count * t / threads);
+        jobs[t].end = (int)((int64_t)count * (t + 1) / threads);
+        /* The calling thread takes the first block itself */
+        if (t > 0) started[t] = pthread_create(&workers[t], NULL, hash_images, &jobs[t]) == 0;
+    }
+    hash_images(&jobs[0]);
+    for (int t = 1; t < threads; t++) {
+        if (started[t]) pthread_join(workers[t], NULL);
+        else hash_images(&jobs[t]);
+    }
+    return BMP_SUCCESS;
+}
@@ -0,0 +1,347 @@
+/**
+ * @file bmap_pnm.c
+ * @brief Binary PPM (P6), PGM (P5) and PAM (P7) import and export.
+ * * 8-bit RGB and gray rows are read straight into the image rows and fixed up
+ * in place: RGB is swizzled to BGR with the dispatched swap_rb kernel, gray is
+ * spread to three channels. In-memory decoding swizzles directly from the
+ * caller's buffer, and encoding writes straight into the output buffer, so the
+ * common formats cost a single pass with no staging copy. Other depths and
+ * maxvals (including 16-bit samples) go through one row buffer and are scaled
+ * to 8 bits. Rows are stored top to bottom, like bmp_save() output.
+ * @author Arda Aksu
+ * @date 2026
+ * @see http://netpbm.sourceforge.net/doc/pam.html
+ */
+
+#include "bmap_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PNM_HEADER_MAX 4096
+
+typedef struct {
+    int width, height;
+    int depth;                  /* Samples per pixel: 1 gray, 2 gray+alpha, 3 RGB, 4 RGBA */
+    int maxval;
+    size_t data_offset;         /* Bytes before the first sample */
+} PnmHeader;
+
+/* --- Header Parsing --- */
+
+typedef struct {
+    const char* p;
+    const char* end;
+} PnmCursor;
+
+/* Skips whitespace and '#' comments */
+static void skip_space(PnmCursor* c) {
+    while (c->p < c->end) {
+        if (*c->p == '#') {
+            while (c->p < c->end && *c->p != '\n') c->p++;
+        } else if (*c->p == ' ' || *c->p == '\t' || *c->p == '\n' || *c->p == '\r' ||
+                   *c->p == '\v' || *c->p == '\f') {
+            c->p++;
+        } else {
+            break;
+        }
+    }
+}
+
+static int read_uint(PnmCursor* c, int* value) {
+    skip_space(c);
+    long v = 0;
+    const char* start = c->p;
+    while (c->p < c->end && *c->p >= '0' && *c->p <= '9' && v <= 0x7fffffffL) {
+        v = v * 10 + (*c->p++ - '0');
+    }
+    if (c->p == start || v > 0x7fffffffL) return 0;
+    *value = (int)v;
+    return 1;
+}
+
+static int read_word(PnmCursor* c, char* word, size_t size) {
+    skip_space(c);
+    size_t n = 0;
+    while (c->p < c->end && *c->p > ' ' && n + 1 < size) word[n++] = *c->p++;
+    word[n] = '\0';
+    return n > 0;
+}
+
+static int parse_header(const uint8_t* data, size_t size, PnmHeader* h) {
+    PnmCursor c = { (const char*)data, (const char*)data + size };
+    if (size < 3 || c.p[0] != 'P') return 0;
+    char kind = c.p[1];
+    c.p += 2;
+
+    if (kind == '5' || kind == '6') {
+        h->depth = kind == '6' ? 3 : 1;
+        if (!read_uint(&c, &h->width) || !read_uint(&c, &h->height) || !read_uint(&c, &h->maxval)) return 0;
+        /* Exactly one whitespace byte separates maxval from the samples */
+        if (c.p >= c.end) return 0;
+        c.p++;
+    } else if (kind == '7') {
+        char key[32];
+        h->width = h->height = h->depth = h->maxval = 0;
+        for (;;) {
+            if (!read_word(&c, key, sizeof(key))) return 0;
+            if (strcmp(key, "ENDHDR") == 0) break;
+
+            if (strcmp(key, "TUPLTYPE") == 0) {
+                while (c.p < c.end && *c.p != '\n') c.p++;  /* Layout follows from DEPTH */
+            } else {
+                int* field = strcmp(key, "WIDTH") == 0 ? &h->width :
+                             strcmp(key, "HEIGHT") == 0 ? &h->height :
+                             strcmp(key, "DEPTH") == 0 ? &h->depth :
+                             strcmp(key, "MAXVAL") == 0 ? &h->maxval : NULL;
+                if (!field || !read_uint(&c, field)) return 0;
+            }
+        }
+        while (c.p < c.end && *c.p != '\n') c.p++;
+        if (c.p >= c.end) return 0;
+        c.p++;
+    } else {
+        return 0;
+    }
+
+    if (h->width <= 0 || h->height <= 0 || h->depth < 1 || h->depth > 4 ||
+        h->maxval < 1 || h->maxval > 65535) {
+        return 0;
+    }
+    h->data_offset = (size_t)(c.p - (const char*)data);
+    return 1;
+}
+
+/* --- Sample Sources --- */
+
+/* Either a FILE or a memory range; rows come back as pointers either way */
+typedef struct {
+    FILE* file;
+    const uint8_t* mem;
+    size_t left;
+} PnmInput;
+
+/* Returns n bytes of input: read into scratch for files, in place for memory */
+static const uint8_t* input_row(PnmInput* in, size_t n, uint8_t* scratch) {
+    if (in->file) return fread(scratch, 1, n, in->file) == n ? scratch : NULL;
+    if (in->left < n) return NULL;
+    const uint8_t* row = in->mem;
+    in->mem += n;
+    in->left -= n;
+    return row;
+}
+
+static BMPError decode_rows(PnmInput* in, const PnmHeader* h, BMPImage* img) {
+    const BmapKernels* kernels = bmap_kernels();
+    size_t w = (size_t)h->width;
+    int bytes_per_sample = h->maxval > 255 ? 2 : 1;
+    int direct = h->maxval == 255 && (h->depth == 3 || h->depth == 1);
+    size_t row_bytes = w * h->depth * bytes_per_sample;
+
+    uint8_t* scratch = NULL;
+    if (!direct) {
+        scratch = (uint8_t*)malloc(row_bytes);
+        if (!scratch) return BMP_ERR_MALLOC_FAILED;
+    }
+
+    BMPError err = BMP_SUCCESS;
+    for (int y = img->height - 1; y >= 0 && err == BMP_SUCCESS; y--) {
+        Pixel* row = &img->data[(size_t)y * w];
+        uint8_t* out = (uint8_t*)row;
+
+        if (direct && h->depth == 3) {
+            const uint8_t* src = input_row(in, row_bytes, out);
+            if (!src) err = BMP_ERR_INVALID_FORMAT;
+            else kernels->swap_rb(out, src, w);
+        } else if (direct) {
+            /* Gray lands in the last third of the row; spreading forwards never overtakes it */
+            const uint8_t* src = input_row(in, row_bytes, out + 2 * w);
+            if (!src) {
+                err = BMP_ERR_INVALID_FORMAT;
+            } else {
+                for (size_t x = 0; x < w; x++) {
+                    uint8_t v = src[x];
+                    out[3 * x] = out[3 * x + 1] = out[3 * x + 2] = v;
+                }
+            }
+        } else {
+            const uint8_t* src = input_row(in, row_bytes, scratch);
+            if (!src) {
+                err = BMP_ERR_INVALID_FORMAT;
+                break;
+            }
+            uint32_t maxval = (uint32_t)h->maxval;
+            for (size_t x = 0; x < w; x++) {
+                uint32_t s[3];
+                for (int k = 0; k < 3; k++) {
+                    /* Gray formats repeat sample 0; the alpha sample is skipped */
+                    size_t i = (x * h->depth + (h->depth >= 3 ? k : 0)) * bytes_per_sample;
+                    uint32_t v = bytes_per_sample == 2 ? (uint32_t)src[i] << 8 | src[i + 1] : src[i];
+                    if (v > maxval) v = maxval;
+                    s[k] = (v * 255 + maxval / 2) / maxval;
+                }
+                row[x].red = (uint8_t)s[0];
+                row[x].green = (uint8_t)s[1];
+                row[x].blue = (uint8_t)s[2];
+            }
+        }
+    }
+
+    free(scratch);
+    return err;
+}
+
+/* --- Sample Sinks --- */
+
+typedef struct {
+    FILE* file;
+    uint8_t* mem;               /* Exactly sized output buffer when encoding to memory */
+    size_t pos;
+    uint8_t* scratch;           /* One row, files only */
+    int failed;
+} PnmOutput;
+
+/* Where the next n bytes should be produced */
+static uint8_t* output_row(PnmOutput* out) {
+    return out->file ? out->scratch : out->mem + out->pos;
+}
+
+static void output_commit(PnmOutput* out, size_t n) {
+    if (out->file) {
+        if (fwrite(out->scratch, 1, n, out->file) != n) out->failed = 1;
+    } else {
+        out->pos += n;
+    }
+}
+
+static int format_header(const BMPImage* image, BMPPnmFormat format, char* header, size_t size) {
+    switch (format) {
+        case BMP_PNM_PPM: return snprintf(header, size, "P6\n%d %d\n255\n", image->width, image->height);
+        case BMP_PNM_PGM: return snprintf(header, size, "P5\n%d %d\n255\n", image->width, image->height);
+        case BMP_PNM_PAM:
+            return snprintf(header, size, "P7\nWIDTH %d\nHEIGHT %d\nDEPTH 3\nMAXVAL 255\nTUPLTYPE RGB\nENDHDR\n",
+                            image->width, image->height);
+        default: return -1;
+    }
+}
+
+static void encode_rows(const BMPImage* image, BMPPnmFormat format, PnmOutput* out) {
+    const BmapKernels* kernels = bmap_kernels();
+    size_t w = (size_t)image->width;
+
+    for (int y = image->height - 1; y >= 0 && !out->failed; y--) {
+        const Pixel* row = &image->data[(size_t)y * w];
+        uint8_t* dst = output_row(out);
+
+        if (format == BMP_PNM_PGM) {
+            /* Same rounding as bmp_grayscale() */
+            for (size_t x = 0; x < w; x++) dst[x] = (uint8_t)((row[x].red + row[x].green + row[x].blue) / 3);
+            output_commit(out, w);
+        } else {
+            kernels->swap_rb(dst, (const uint8_t*)row, w);
+            output_commit(out, 3 * w);
+        }
+    }
+}
+
+/* --- Public API --- */
+
+BMPImage* bmp_decode_pnm(const void* data, size_t size, BMPError* err_out) {
+    PnmHeader h;
+    if (!data || !parse_header((const uint8_t*)data, size, &h)) {
+        if (err_out) *err_out = BMP_ERR_INVALID_FORMAT;
+        return NULL;
+    }
+
+    BMPImage* img = bmap_image_create(h.width, h.height, BMAP_STORAGE_HEAP, err_out);
+    if (!img) return NULL;
+
+    PnmInput in = { NULL, (const uint8_t*)data + h.data_offset, size - h.data_offset };
+    BMPError err = decode_rows(&in, &h, img);
+    if (err != BMP_SUCCESS) {
+        bmp_free(img);
+        img = NULL;
+    }
+    if (err_out) *err_out = err;
+    return img;
+}
+
+BMPImage* bmp_load_pnm(const char* filename, BMPError* err_out) {
+    FILE* file = filename ? fopen(filename, "rb") : NULL;
+    if (!file) {
+        if (err_out) *err_out = BMP_ERR_FILE_NOT_FOUND;
+        return NULL;
+    }
+
+    uint8_t header[PNM_HEADER_MAX];
+    size_t got = fread(header, 1, sizeof(header), file);
+    PnmHeader h;
+    if (!parse_header(header, got, &h) || fseek(file, (long)h.data_offset, SEEK_SET) != 0) {
+        fclose(file);
+        if (err_out) *err_out = BMP_ERR_INVALID_FORMAT;
+        return NULL;
+    }
+
+    BMPImage* img = bmap_image_create(h.width, h.height, BMAP_STORAGE_HEAP, err_out);
+    if (!img) {
+        fclose(file);
+        return NULL;
+    }
+
+    PnmInput in = { file, NULL, 0 };
+    BMPError err = decode_rows(&in, &h, img);
+    fclose(file);
+    if (err != BMP_SUCCESS) {
+        bmp_free(img);
+        img = NULL;
+    }
+    if (err_out) *err_out = err;
+    return img;
+}
+
+void* bmp_encode_pnm(const BMPImage* image, BMPPnmFormat format, size_t* size_out, BMPError* err_out) {
+    char header[160];
+    int header_len = image && image->data && size_out ? format_header(image, format, header, sizeof(header)) : -1;
+    if (header_len < 0) {
+        if (err_out) *err_out = BMP_ERR_INVALID_ARGUMENT;
+        return NULL;
+    }
+
+    size_t channels = format == BMP_PNM_PGM ? 1 : 3;
+    size_t size = (size_t)header_len + (size_t)image->width * image->height * channels;
+    PnmOutput out = { NULL, (uint8_t*)malloc(size), 0, NULL, 0 };
+    if (!out.mem) {
+        if (err_out) *err_out = BMP_ERR_MALLOC_FAILED;
+        return NULL;
+    }
+
+    memcpy(out.mem, header, (size_t)header_len);
+    out.pos = (size_t)header_len;
+    encode_rows(image, format, &out);
+
+    *size_out = size;
+    if (err_out) *err_out = BMP_SUCCESS;
+    return out.mem;
+}
+
+BMPError bmp_save_pnm(const BMPImage* image, const char* filename, BMPPnmFormat format) {
+    char header[160];
+    int header_len = image && image->data ? format_header(image, format, header, sizeof(header)) : -1;
+    if (header_len < 0) return BMP_ERR_INVALID_ARGUMENT;
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) return BMP_ERR_FILE_NOT_FOUND;
+
+    PnmOutput out = { file, NULL, 0, (uint8_t*)malloc((size_t)image->width * sizeof(Pixel)), 0 };
+    if (!out.scratch) {
+        fclose(file);
+        return BMP_ERR_MALLOC_FAILED;
+    }
+
+    if (fwrite(header, 1, (size_t)header_len, file) != (size_t)header_len) out.failed = 1;
+    encode_rows(image, format, &out);
+    free(out.scratch);
+
+    if (fclose(file) != 0) out.failed = 1;
+    return out.failed ? BMP_ERR_IO : BMP_SUCCESS;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file bmap_protocol.h
+ * @brief Wire format between bmp_client_* calls and bmp_daemon_run().
+ * Messages travel over a SOCK_SEQPACKET UNIX socket, one request and one
+ * reply per call. The request carries the descriptor of the shared memory
+ * holding the pixels as SCM_RIGHTS ancillary data; the daemon maps it, runs
+ * the operations in place and replies with the resulting size.
+ * Not installed and not part of the public API.
+ * @author Arda Aksu
+ * @date 2026
+ */
+
+#ifndef BMAP_PROTOCOL_H
+#define BMAP_PROTOCOL_H
+
+#include <stdint.h>
+
+#define BMAPD_MAGIC 0x44504D42u     /* "BMPD" */
+#define BMAPD_MAX_OPS 16            /* Longer chains are sent as several requests */
+
+typedef struct {
+    uint32_t magic;
+    int32_t width;                  /* Pixel layout of the shared mapping */
+    int32_t height;
+    int32_t op_count;
+    int32_t ops[BMAPD_MAX_OPS];     /* BMPOperation values */
+} BmapdRequest;
+
+typedef struct {
+    uint32_t magic;
+    int32_t status;                 /* BMPError */
+    int32_t width;                  /* Size after the operations */
+    int32_t height;
+} BmapdReply;
+
+#endif // BMAP_PROTOCOL_H
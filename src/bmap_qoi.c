@@ -0,0 +1,352 @@
+/**
+ * @file bmap_qoi.c
+ * @brief Lossless QOI ("Quite OK Image") encoder and decoder for BMPImage.
+ * * Single pass in both directions: every pixel becomes a run, a reference into
+ * a 64-entry hash of recently seen colors, a small delta from the previous
+ * pixel, or a literal. Files are streamed through a fixed chunk buffer, so
+ * memory use does not grow with the compressed size.
+ * Rows are written top to bottom as the format requires, i.e. in reverse
+ * BMPImage row order (row 0 is the bottom row, as in bmp_save()).
+ * @author Arda Aksu
+ * @date 2026
+ * @see https://qoiformat.org/qoi-specification.pdf
+ */
+
+#include "bmap_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define QOI_OP_INDEX 0x00
+#define QOI_OP_DIFF  0x40
+#define QOI_OP_LUMA  0x80
+#define QOI_OP_RUN   0xc0
+#define QOI_OP_RGB   0xfe
+#define QOI_OP_RGBA  0xff
+#define QOI_MASK_2   0xc0
+
+#define QOI_HEADER_SIZE 14
+#define QOI_PADDING_SIZE 8
+#define QOI_MAX_PIXELS 400000000u  /* Limit from the reference implementation */
+#define QOI_CHUNK (64 * 1024)
+
+/* Colors are packed as r | g << 8 | b << 16 | a << 24 */
+#define QOI_R(c) ((uint8_t)(c))
+#define QOI_G(c) ((uint8_t)((c) >> 8))
+#define QOI_B(c) ((uint8_t)((c) >> 16))
+#define QOI_A(c) ((uint8_t)((c) >> 24))
+#define QOI_HASH(c) ((QOI_R(c) * 3 + QOI_G(c) * 5 + QOI_B(c) * 7 + QOI_A(c) * 11) & 63)
+
+static const uint8_t qoi_padding[QOI_PADDING_SIZE] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+static void put_u32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static uint32_t get_u32(const uint8_t* p) {
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+/* --- Encoder --- */
+
+/* Output buffer; a file sink flushes whenever fewer than QOI_SINK_SLACK bytes are free */
+typedef struct {
+    uint8_t* buf;
+    size_t pos, cap;
+    FILE* file;
+    int failed;
+} QoiSink;
+
+#define QOI_SINK_SLACK 8   /* A pending run plus the longest op */
+
+static void sink_flush(QoiSink* sink) {
+    if (sink->file && sink->pos) {
+        if (fwrite(sink->buf, 1, sink->pos, sink->file) != sink->pos) sink->failed = 1;
+        sink->pos = 0;
+    }
+}
+
+static void qoi_encode(const BMPImage* image, QoiSink* sink) {
+    uint8_t* out = sink->buf;
+    memcpy(out, "qoif", 4);
+    put_u32(out + 4, (uint32_t)image->width);
+    put_u32(out + 8, (uint32_t)image->height);
+    out[12] = 3;    /* RGB */
+    out[13] = 0;    /* sRGB with linear alpha */
+    size_t pos = QOI_HEADER_SIZE;
+
+    uint32_t index[64] = { 0 };
+    uint32_t prev = 0xff000000u;
+    int run = 0;
+
+    for (int y = image->height - 1; y >= 0; y--) {
+        const Pixel* row = &image->data[(size_t)y * image->width];
+
+        for (int x = 0; x < image->width; x++) {
+            uint32_t px = row[x].red | (uint32_t)row[x].green << 8 |
+                          (uint32_t)row[x].blue << 16 | 0xff000000u;
+
+            if (sink->cap - pos < QOI_SINK_SLACK) {
+                sink->pos = pos;
+                sink_flush(sink);
+                pos = sink->pos;
+            }
+
+            if (px == prev) {
+                if (++run == 62) {
+                    out[pos++] = (uint8_t)(QOI_OP_RUN | (run - 1));
+                    run = 0;
+                }
+                continue;
+            }
+            if (run) {
+                out[pos++] = (uint8_t)(QOI_OP_RUN | (run - 1));
+                run = 0;
+            }
+
+            int h = QOI_HASH(px);
+            if (index[h] == px) {
+                out[pos++] = (uint8_t)(QOI_OP_INDEX | h);
+            } else {
+                index[h] = px;
+                signed char dr = (signed char)(QOI_R(px) - QOI_R(prev));
+                signed char dg = (signed char)(QOI_G(px) - QOI_G(prev));
+                signed char db = (signed char)(QOI_B(px) - QOI_B(prev));
+                signed char dr_dg = (signed char)(dr - dg);
+                signed char db_dg = (signed char)(db - dg);
+
+                if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                    out[pos++] = (uint8_t)(QOI_OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2));
+                } else if (dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 && db_dg >= -8 && db_dg <= 7) {
+                    out[pos++] = (uint8_t)(QOI_OP_LUMA | (dg + 32));
+                    out[pos++] = (uint8_t)((dr_dg + 8) << 4 | (db_dg + 8));
+                } else {
+                    out[pos++] = QOI_OP_RGB;
+                    out[pos++] = QOI_R(px);
+                    out[pos++] = QOI_G(px);
+                    out[pos++] = QOI_B(px);
+                }
+            }
+            prev = px;
+        }
+    }
+
+    if (sink->cap - pos < QOI_SINK_SLACK + QOI_PADDING_SIZE) {
+        sink->pos = pos;
+        sink_flush(sink);
+        pos = sink->pos;
+    }
+    if (run) out[pos++] = (uint8_t)(QOI_OP_RUN | (run - 1));
+    memcpy(out + pos, qoi_padding, QOI_PADDING_SIZE);
+    sink->pos = pos + QOI_PADDING_SIZE;
+    sink_flush(sink);
+}
+
+/* Worst case: a 4-byte literal for every pixel */
+static int qoi_max_size(const BMPImage* image, size_t* size) {
+    size_t pixels = (size_t)image->width * image->height;
+    if (pixels > QOI_MAX_PIXELS) return 0;
+    *size = QOI_HEADER_SIZE + pixels * 4 + QOI_PADDING_SIZE;
+    return 1;
+}
+
+/* --- Decoder --- */
+
+/* Input window; a file source refills whenever fewer than 5 bytes remain */
+typedef struct {
+    const uint8_t* p;
+    const uint8_t* end;
+    FILE* file;
+    uint8_t* buf;
+} QoiSource;
+
+static void source_refill(QoiSource* src) {
+    if (!src->file) return;
+    size_t left = (size_t)(src->end - src->p);
+    memmove(src->buf, src->p, left);
+    left += fread(src->buf + left, 1, QOI_CHUNK - left, src->file);
+    src->p = src->buf;
+    src->end = src->buf + left;
+}
+
+static int parse_header(const uint8_t* h, int* width, int* height) {
+    uint32_t w = get_u32(h + 4), hgt = get_u32(h + 8);
+    if (memcmp(h, "qoif", 4) != 0 || (h[12] != 3 && h[12] != 4) || h[13] > 1 ||
+        w == 0 || hgt == 0 || w > 0x7fffffffu || hgt > 0x7fffffffu ||
+        (uint64_t)w * hgt > QOI_MAX_PIXELS) {
+        return 0;
+    }
+    *width = (int)w;
+    *height = (int)hgt;
+    return 1;
+}
+
+static BMPError qoi_decode(QoiSource* src, BMPImage* image) {
+    uint32_t index[64] = { 0 };
+    uint32_t px = 0xff000000u;
+    int run = 0;
+    const uint8_t* p = src->p;
+
+    for (int y = image->height - 1; y >= 0; y--) {
+        Pixel* row = &image->data[(size_t)y * image->width];
+
+        for (int x = 0; x < image->width; x++) {
+            if (run > 0) {
+                run--;
+            } else {
+                if (src->end - p < 5) {
+                    src->p = p;
+                    source_refill(src);
+                    p = src->p;
+                    ptrdiff_t avail = src->end - p;
+                    int need = avail < 1 ? 1 : (p[0] == QOI_OP_RGBA ? 5 : p[0] == QOI_OP_RGB ? 4 :
+                                                (p[0] & QOI_MASK_2) == QOI_OP_LUMA ? 2 : 1);
+                    if (avail < need) return BMP_ERR_INVALID_FORMAT;
+                }
+
+                int b1 = *p++;
+                if (b1 == QOI_OP_RGB) {
+                    px = p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (px & 0xff000000u);
+                    p += 3;
+                } else if (b1 == QOI_OP_RGBA) {
+                    px = p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+                    p += 4;
+                } else {
+                    switch (b1 & QOI_MASK_2) {
+                        case QOI_OP_INDEX:
+                            px = index[b1];
+                            break;
+                        case QOI_OP_DIFF:
+                            px = (uint8_t)(QOI_R(px) + ((b1 >> 4) & 3) - 2) |
+                                 (uint32_t)(uint8_t)(QOI_G(px) + ((b1 >> 2) & 3) - 2) << 8 |
+                                 (uint32_t)(uint8_t)(QOI_B(px) + (b1 & 3) - 2) << 16 |
+                                 (px & 0xff000000u);
+                            break;
+                        case QOI_OP_LUMA: {
+                            int b2 = *p++;
+                            int dg = (b1 & 0x3f) - 32;
+                            px = (uint8_t)(QOI_R(px) + dg - 8 + ((b2 >> 4) & 0x0f)) |
+                                 (uint32_t)(uint8_t)(QOI_G(px) + dg) << 8 |
+                                 (uint32_t)(uint8_t)(QOI_B(px) + dg - 8 + (b2 & 0x0f)) << 16 |
+                                 (px & 0xff000000u);
+                            break;
+                        }
+                        default: /* QOI_OP_RUN */
+                            run = b1 & 0x3f;
+                            break;
+                    }
+                }
+                index[QOI_HASH(px)] = px;
+            }
+
+            row[x].red = QOI_R(px);
+            row[x].green = QOI_G(px);
+            row[x].blue = QOI_B(px);
+        }
+    }
+
+    src->p = p;
+    return BMP_SUCCESS;
+}
+
+/* --- Public API --- */
+
+void* bmp_encode_qoi(const BMPImage* image, size_t* size_out, BMPError* err_out) {
+    size_t cap;
+    if (!image || !image->data || !size_out || !qoi_max_size(image, &cap)) {
+        if (err_out) *err_out = BMP_ERR_INVALID_ARGUMENT;
+        return NULL;
+    }
+
+    QoiSink sink = { (uint8_t*)malloc(cap), 0, cap, NULL, 0 };
+    if (!sink.buf) {
+        if (err_out) *err_out = BMP_ERR_MALLOC_FAILED;
+        return NULL;
+    }
+    qoi_encode(image, &sink);
+
+    /* Give back the unused worst-case tail */
+    uint8_t* shrunk = (uint8_t*)realloc(sink.buf, sink.pos);
+    *size_out = sink.pos;
+    if (err_out) *err_out = BMP_SUCCESS;
+    return shrunk ? shrunk : sink.buf;
+}
+
+BMPImage* bmp_decode_qoi(const void* data, size_t size, BMPError* err_out) {
+    int width, height;
+    const uint8_t* bytes = (const uint8_t*)data;
+    if (!bytes || size < QOI_HEADER_SIZE + QOI_PADDING_SIZE || !parse_header(bytes, &width, &height)) {
+        if (err_out) *err_out = BMP_ERR_INVALID_FORMAT;
+        return NULL;
+    }
+
+    BMPImage* img = bmap_image_create(width, height, BMAP_STORAGE_HEAP, err_out);
+    if (!img) return NULL;
+
+    QoiSource src = { bytes + QOI_HEADER_SIZE, bytes + size, NULL, NULL };
+    BMPError err = qoi_decode(&src, img);
+    if (err != BMP_SUCCESS) {
+        bmp_free(img);
+        img = NULL;
+    }
+    if (err_out) *err_out = err;
+    return img;
+}
+
+BMPError bmp_save_qoi(const BMPImage* image, const char* filename) {
+    size_t cap;
+    if (!image || !image->data || !qoi_max_size(image, &cap)) return BMP_ERR_INVALID_ARGUMENT;
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) return BMP_ERR_FILE_NOT_FOUND;
+
+    QoiSink sink = { (uint8_t*)malloc(QOI_CHUNK), 0, QOI_CHUNK, file, 0 };
+    if (!sink.buf) {
+        fclose(file);
+        return BMP_ERR_MALLOC_FAILED;
+    }
+    qoi_encode(image, &sink);
+    free(sink.buf);
+
+    if (fclose(file) != 0) sink.failed = 1;
+    return sink.failed ? BMP_ERR_IO : BMP_SUCCESS;
+}
+
+BMPImage* bmp_load_qoi(const char* filename, BMPError* err_out) {
+    FILE* file = filename ? fopen(filename, "rb") : NULL;
+    if (!file) {
+        if (err_out) *err_out = BMP_ERR_FILE_NOT_FOUND;
+        return NULL;
+    }
+
+    uint8_t header[QOI_HEADER_SIZE];
+    int width, height;
+    if (fread(header, 1, sizeof(header), file) != sizeof(header) || !parse_header(header, &width, &height)) {
+        fclose(file);
+        if (err_out) *err_out = BMP_ERR_INVALID_FORMAT;
+        return NULL;
+    }
+
+    uint8_t* buf = (uint8_t*)malloc(QOI_CHUNK);
+    BMPImage* img = buf ? bmap_image_create(width, height, BMAP_STORAGE_HEAP, err_out) : NULL;
+    if (!img) {
+        if (!buf && err_out) *err_out = BMP_ERR_MALLOC_FAILED;
+        free(buf);
+        fclose(file);
+        return NULL;
+    }
+
+    QoiSource src = { buf, buf, file, buf };
+    BMPError err = qoi_decode(&src, img);
+    free(buf);
+    fclose(file);
+    if (err != BMP_SUCCESS) {
+        bmp_free(img);
+        img = NULL;
+    }
+    if (err_out) *err_out = err;
+    return img;
+}
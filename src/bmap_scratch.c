@@ -0,0 +1,213 @@
+/**
+ * @file bmap_scratch.c
+ * @brief File-backed scratch storage for images larger than RAM.
+ * * Pixel buffers are placed in an unlinked temporary file mapped with
+ * MAP_SHARED, so the kernel can write pages back and reclaim them instead of
+ * failing the allocation. Transforms release pages they are done with, which
+ * keeps the resident set bounded. The same mappings, backed by a memfd
+ * instead of a file, carry images to and from the daemon.
+ * @author Arda Aksu
+ * @date 2026
+ * @see bmap_internal.h for the allocation helpers.
+ */
+
+#define _GNU_SOURCE  /* memfd_create() */
+
+#include "bmap_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#define SCRATCH_PATH_MAX 4096
+
+typedef struct {
+    int fd;
+    void* base;
+    size_t bytes;
+    int kind;       /* BMAP_STORAGE_* the mapping was requested as */
+} ScratchMapping;
+
+static char scratch_dir[SCRATCH_PATH_MAX];
+static int scratch_enabled;
+
+#ifndef _WIN32
+
+static pthread_mutex_t scratch_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int scratch_open(void) {
+    char path[SCRATCH_PATH_MAX + 32];
+    const char* dir;
+
+    pthread_mutex_lock(&scratch_lock);
+    dir = scratch_enabled ? scratch_dir : getenv("TMPDIR");
+    if (!dir || !*dir) dir = "/tmp";
+    snprintf(path, sizeof(path), "%s/bmap-scratch-XXXXXX", dir);
+    pthread_mutex_unlock(&scratch_lock);
+
+    int fd = mkstemp(path);
+    if (fd >= 0) unlink(path);  /* The file disappears as soon as the mapping is closed */
+    return fd;
+}
+
+static int shared_open(void) {
+#ifdef __linux__
+    int fd = memfd_create("bmap-shared", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd >= 0) return fd;
+#endif
+    return scratch_open();
+}
+
+/* Sizes fd to bytes and maps all of it; takes ownership of fd */
+static Pixel* scratch_map(int fd, size_t bytes, int kind, void** storage) {
+    if (fd < 0) return NULL;
+
+    if (bytes == 0 || ftruncate(fd, (off_t)bytes) != 0) {
+        close(fd);
+        return NULL;
+    }
+#ifdef F_ADD_SEALS
+    /* The daemon maps shared buffers by size, so the size is fixed from here on */
+    if (kind == BMAP_STORAGE_SHARED) fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL);
+#endif
+
+    void* base = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ScratchMapping* mapping = (ScratchMapping*)malloc(sizeof(ScratchMapping));
+    if (base == MAP_FAILED || !mapping) {
+        if (base != MAP_FAILED) munmap(base, bytes);
+        free(mapping);
+        close(fd);
+        return NULL;
+    }
+
+    mapping->fd = fd;
+    mapping->base = base;
+    mapping->bytes = bytes;
+    mapping->kind = kind;
+    *storage = mapping;
+    return (Pixel*)base;
+}
+
+#else
+
+static int scratch_open(void) { return -1; }
+static int shared_open(void) { return -1; }
+
+static Pixel* scratch_map(int fd, size_t bytes, int kind, void** storage) {
+    (void)fd;
+    (void)bytes;
+    (void)kind;
+    (void)storage;
+    return NULL;
+}
+
+#endif
+
+/* --- Public API --- */
+
+BMPError bmp_set_scratch_directory(const char* directory) {
+    if (directory && strlen(directory) >= SCRATCH_PATH_MAX) return BMP_ERR_INVALID_ARGUMENT;
+
+#ifndef _WIN32
+    pthread_mutex_lock(&scratch_lock);
+#endif
+    if (directory) strcpy(scratch_dir, directory);
+    scratch_enabled = directory != NULL;
+#ifndef _WIN32
+    pthread_mutex_unlock(&scratch_lock);
+#endif
+    return BMP_SUCCESS;
+}
+
+int bmp_is_mapped(const BMPImage* image) {
+    return image && image->storage != NULL;
+}
+
+/* --- Internal Helpers --- */
+
+Pixel* bmap_pixels_alloc(size_t count, int kind, void** storage) {
+    *storage = NULL;
+    if (count > SIZE_MAX / sizeof(Pixel)) return NULL;
+
+    size_t bytes = count * sizeof(Pixel);
+    if (kind == BMAP_STORAGE_SHARED) return scratch_map(shared_open(), bytes, kind, storage);
+    if (kind == BMAP_STORAGE_SCRATCH) return scratch_map(scratch_open(), bytes, kind, storage);
+
+    Pixel* data = (Pixel*)malloc(bytes);
+    if (!data) {
+#ifndef _WIN32
+        pthread_mutex_lock(&scratch_lock);
+#endif
+        int fallback = scratch_enabled;
+#ifndef _WIN32
+        pthread_mutex_unlock(&scratch_lock);
+#endif
+        if (fallback) data = scratch_map(scratch_open(), bytes, kind, storage);
+    }
+    return data;
+}
+
+void bmap_pixels_free(Pixel* data, void* storage) {
+    if (!storage) {
+        free(data);
+        return;
+    }
+#ifndef _WIN32
+    ScratchMapping* mapping = (ScratchMapping*)storage;
+    munmap(mapping->base, mapping->bytes);
+    close(mapping->fd);
+    free(mapping);
+#endif
+}
+
+void bmap_pixels_evict(void* storage, const void* addr, size_t len) {
+#ifndef _WIN32
+    if (!storage || len == 0) return;
+
+    /* madvise needs page-aligned bounds; round inwards to whole pages */
+    long page = sysconf(_SC_PAGESIZE);
+    uintptr_t start = ((uintptr_t)addr + page - 1) & ~(uintptr_t)(page - 1);
+    uintptr_t end = ((uintptr_t)addr + len) & ~(uintptr_t)(page - 1);
+    if (end > start) {
+        /* Shared file pages keep their contents; only the resident copy is dropped */
+        madvise((void*)start, end - start, MADV_DONTNEED);
+    }
+#else
+    (void)storage;
+    (void)addr;
+    (void)len;
+#endif
+}
+
+int bmap_pixels_kind(const void* storage) {
+#ifndef _WIN32
+    if (storage) return ((const ScratchMapping*)storage)->kind;
+#else
+    (void)storage;
+#endif
+    return BMAP_STORAGE_HEAP;
+}
+
+int bmap_pixels_fd(const void* storage) {
+#ifndef _WIN32
+    if (storage) return ((const ScratchMapping*)storage)->fd;
+#else
+    (void)storage;
+#endif
+    return -1;
+}
+
+int bmap_fd_size_sealed(int fd) {
+#ifdef F_GET_SEALS
+    int seals = fd >= 0 ? fcntl(fd, F_GET_SEALS) : -1;
+    return seals >= 0 && (seals & F_SEAL_SHRINK) != 0;
+#else
+    return fd >= 0;
+#endif
+}
@@ -0,0 +1,454 @@
+/**
+ * @file bmap_sequence.c
+ * @brief Frame sequences: dirty-tile reprocessing and keyframe/delta files.
+ * * Consecutive frames are compared tile by tile against a copy of the
+ * previous frame (memcmp per tile row, vectorized by libc, stopping at the
+ * first difference). Only changed tiles are filtered again.
+ * * An operation chain splits into per-pixel filters (grayscale, invert),
+ * which commute with any pixel permutation, and a flip/rotate placement that
+ * is folded into one coordinate map. A dirty tile is filtered in a small
+ * scratch buffer and scattered straight to its place in the output.
+ * @author Arda Aksu
+ * @date 2026
+ * @see bmap.h for the public sequence API.
+ */
+
+#define _POSIX_C_SOURCE 200809L  /* fileno() */
+
+#include "bmap_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define DELTA_VERSION 1
+#define DELTA_HEADER_SIZE 32
+#define DELTA_KEYFRAME 0
+#define DELTA_TILES 1
+
+/* Output position of source pixel (x, y): X = xx*x + xy*y + x0, Y = yx*x + yy*y + y0 */
+typedef struct {
+    int xx, xy, x0;
+    int yx, yy, y0;
+} Placement;
+
+struct BMPSequence {
+    int tile_size;
+    BMPOperation filters[BMP_SEQUENCE_MAX_OPS];     /* Per-pixel part of the chain */
+    int filter_count;
+    BMPOperation ops[BMP_SEQUENCE_MAX_OPS];
+    int op_count;
+    Placement place;
+    BMPImage* previous;     /* Last input frame, updated tile by tile */
+    BMPImage* output;
+    BMPImage* scratch;      /* One tile */
+    int dirty_tiles;
+};
+
+struct BMPDeltaWriter {
+    FILE* file;
+    int tile_size;
+    int keyframe_interval;
+    int frame_count;
+    BMPImage* previous;
+};
+
+struct BMPDeltaReader {
+    FILE* file;
+    int tile_size;
+    int frame_count;
+    int frames_read;
+    BMPImage* frame;
+};
+
+/* --- Tile Helpers --- */
+
+static void put_le32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint32_t get_le32(const uint8_t* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+/* Tile counts are computed in size_t: width + tile_size - 1 can exceed INT_MAX */
+static size_t tile_count(const BMPImage* image, int tile_size) {
+    return (((size_t)image->width + tile_size - 1) / tile_size) *
+           (((size_t)image->height + tile_size - 1) / tile_size);
+}
+
+/* Clips tile index t of the image to a rectangle */
+static void tile_rect(const BMPImage* image, int tile_size, size_t t, int* x, int* y, int* w, int* h) {
+    size_t tiles_x = ((size_t)image->width + tile_size - 1) / tile_size;
+    *x = (int)(t % tiles_x) * tile_size;
+    *y = (int)(t / tiles_x) * tile_size;
+    *w = image->width - *x < tile_size ? image->width - *x : tile_size;
+    *h = image->height - *y < tile_size ? image->height - *y : tile_size;
+}
+
+/* Compares one tile with the previous frame and copies it over if it changed */
+static int tile_update(BMPImage* previous, const BMPImage* frame, int x, int y, int w, int h) {
+    size_t row_bytes = (size_t)w * sizeof(Pixel);
+    int r = 0;
+    while (r < h && memcmp(&previous->data[(size_t)(y + r) * frame->width + x],
+                           &frame->data[(size_t)(y + r) * frame->width + x], row_bytes) == 0) {
+        r++;
+    }
+    if (r == h) return 0;
+    for (; r < h; r++) {
+        memcpy(&previous->data[(size_t)(y + r) * frame->width + x],
+               &frame->data[(size_t)(y + r) * frame->width + x], row_bytes);
+    }
+    return 1;
+}
+
+/* --- Sequence --- */
+
+BMPSequence* bmp_sequence_create(int tile_size, const BMPOperation* ops, int op_count, BMPError* err_out) {
+    if (tile_size <= 0 || tile_size > BMP_SEQUENCE_MAX_TILE || op_count < 0 || op_count > BMP_SEQUENCE_MAX_OPS ||
+        (op_count > 0 && !ops)) {
+        if (err_out) *err_out = BMP_ERR_INVALID_ARGUMENT;
+        return NULL;
+    }
+    for (int i = 0; i < op_count; i++) {
+        if ((int)ops[i] < BMP_OP_GRAYSCALE || ops[i] > BMP_OP_ROTATE_RIGHT) {
+            if (err_out) *err_out = BMP_ERR_INVALID_ARGUMENT;
+            return NULL;
+        }
+    }
+
+    BMPSequence* seq = (BMPSequence*)calloc(1, sizeof(BMPSequence));
+    if (!seq) {
+        if (err_out) *err_out = BMP_ERR_MALLOC_FAILED;
+        return NULL;
+    }
+    seq->tile_size = tile_size;
+    seq->op_count = op_count;
+    for (int i = 0; i < op_count; i++) {
+        seq->ops[i] = ops[i];
+        if (ops[i] == BMP_OP_GRAYSCALE || ops[i] == BMP_OP_INVERT) seq->filters[seq->filter_count++] = ops[i];
+    }
+    if (err_out) *err_out = BMP_SUCCESS;
+    return seq;
+}
+
+void bmp_sequence_free(BMPSequence* seq) {
+    if (!seq) return;
+    bmp_free(seq->previous);
+    bmp_free(seq->output);
+    bmp_free(seq->scratch);
+    free(seq);
+}
+
+/* Folds the flips and rotations of the chain into one map for a width x height input */
+static Placement plan_placement(const BMPOperation* ops, int op_count, int width, int height) {
+    Placement p = { 1, 0, 0, 0, 1, 0 };
+    for (int i = 0; i < op_count; i++) {
+        if (ops[i] == BMP_OP_FLIP_HORIZONTAL) {
+            /* X' = width - 1 - X */
+            p.xx = -p.xx;
+            p.xy = -p.xy;
+            p.x0 = width - 1 - p.x0;
+        } else if (ops[i] == BMP_OP_ROTATE_RIGHT) {
+            /* X' = height - 1 - Y, Y' = X, as in bmp_rotate_right() */
+            Placement r = { -p.yx, -p.yy, height - 1 - p.y0, p.xx, p.xy, p.x0 };
+            p = r;
+            int t = width;
+            width = height;
+            height = t;
+        }
+    }
+    return p;
+}
+
+/* Filters one tile in the scratch buffer and writes it to its output position */
+static void process_tile(BMPSequence* seq, const BMPImage* frame, int x, int y, int w, int h) {
+    BMPImage* tile = seq->scratch;
+    tile->width = w;
+    tile->height = h;
+    for (int r = 0; r < h; r++) {
+        memcpy(&tile->data[(size_t)r * w], &frame->data[(size_t)(y + r) * frame->width + x],
+               (size_t)w * sizeof(Pixel));
+    }
+    bmp_apply_operations(tile, seq->filters, seq->filter_count);
+
+    const Placement* p = &seq->place;
+    BMPImage* out = seq->output;
+    if (p->xx == 1 && p->yy == 1 && p->xy == 0 && p->yx == 0) {
+        for (int r = 0; r < h; r++) {
+            memcpy(&out->data[(size_t)(y + r + p->y0) * out->width + x + p->x0],
+                   &tile->data[(size_t)r * w], (size_t)w * sizeof(Pixel));
+        }
+        return;
+    }
+    for (int r = 0; r < h; r++) {
+        const Pixel* src = &tile->data[(size_t)r * w];
+        for (int c = 0; c < w; c++) {
+            int sx = x + c, sy = y + r;
+            int ox = p->xx * sx + p->xy * sy + p->x0;
+            int oy = p->yx * sx + p->yy * sy + p->y0;
+            out->data[(size_t)oy * out->width + ox] = src[c];
+        }
+    }
+}
+
+const BMPImage* bmp_sequence_process(BMPSequence* seq, const BMPImage* frame, BMPError* err_out) {
+    if (!seq || !frame || !frame->data ||
+        (seq->previous && (frame->width != seq->previous->width || frame->height != seq->previous->height))) {
+        if (err_out) *err_out = BMP_ERR_INVALID_ARGUMENT;
+        return NULL;
+    }
+
+    int first = !seq->previous;
+    if (first) {
+        int rotations = 0;
+        for (int i = 0; i < seq->op_count; i++) rotations += seq->ops[i] == BMP_OP_ROTATE_RIGHT;
+        int out_w = rotations % 2 ? frame->height : frame->width;
+        int out_h = rotations % 2 ? frame->width : frame->height;
+
+        seq->previous = bmp_clone(frame, NULL);
+        seq->output = bmp_create(out_w, out_h, NULL);
+        seq->scratch = bmp_create(frame->width < seq->tile_size ? frame->width : seq->tile_size,
+                                  frame->height < seq->tile_size ? frame->height : seq->tile_size, NULL);
+        if (!seq->previous || !seq->output || !seq->scratch) {
+            bmp_free(seq->previous);
+            bmp_free(seq->output);
+            bmp_free(seq->scratch);
+            seq->previous = seq->output = seq->scratch = NULL;
+            if (err_out) *err_out = BMP_ERR_MALLOC_FAILED;
+            return NULL;
+        }
+        seq->place = plan_placement(seq->ops, seq->op_count, frame->width, frame->height);
+    }
+
+    seq->dirty_tiles = 0;
+    size_t count = tile_count(frame, seq->tile_size);
+    for (size_t t = 0; t < count; t++) {
+        int x, y, w, h;
+        tile_rect(frame, seq->tile_size, t, &x, &y, &w, &h);
+        if (first || tile_update(seq->previous, frame, x, y, w, h)) {
+            process_tile(seq, frame, x, y, w, h);
+            seq->dirty_tiles++;
+        }
+    }
+
+    if (err_out) *err_out = BMP_SUCCESS;
+    return seq->output;
+}
+
+int bmp_sequence_dirty_tiles(const BMPSequence* seq) {
+    return seq ? seq->dirty_tiles : 0;
+}
+
+/* --- Delta Files --- */
+
+static BMPError write_header(FILE* file, int tile_size, const BMPImage* frame, int frame_count) {
+    uint8_t header[DELTA_HEADER_SIZE] = { 'B', 'M', 'A', 'P', 'D', 'L', 'T', 'A' };
+    put_le32(header + 8, DELTA_VERSION);
+    put_le32(header + 12, (uint32_t)tile_size);
+    put_le32(header + 16, frame ? (uint32_t)frame->width : 0);
+    put_le32(header + 20, frame ? (uint32_t)frame->height : 0);
+    put_le32(header + 24, (uint32_t)frame_count);
+    if (fseek(file, 0, SEEK_SET) != 0 || fwrite(header, 1, sizeof(header), file) != sizeof(header)) {
+        return BMP_ERR_IO;
+    }
+    return BMP_SUCCESS;
+}
+
+BMPDeltaWriter* bmp_delta_create(const char* filename, int tile_size, int keyframe_interval, BMPError* err_out) {
+    if (!filename || tile_size <= 0 || tile_size > BMP_SEQUENCE_MAX_TILE) {
+        if (err_out) *err_out = BMP_ERR_INVALID_ARGUMENT;
+        return NULL;
+    }
+    BMPDeltaWriter* writer = (BMPDeltaWriter*)calloc(1, sizeof(BMPDeltaWriter));
+    if (!writer) {
+        if (err_out) *err_out = BMP_ERR_MALLOC_FAILED;
+        return NULL;
+    }
+    writer->file = fopen(filename, "wb");
+    if (!writer->file) {
+        free(writer);
+        if (err_out) *err_out = BMP_ERR_FILE_NOT_FOUND;
+        return NULL;
+    }
+    writer->tile_size = tile_size;
+    writer->keyframe_interval = keyframe_interval;
+
+    /* Placeholder until the first frame fixes the size; bmp_delta_finish() rewrites it */
+    BMPError err = write_header(writer->file, tile_size, NULL, 0);
+    if (err != BMP_SUCCESS) {
+        fclose(writer->file);
+        free(writer);
+        writer = NULL;
+    }
+    if (err_out) *err_out = err;
+    return writer;
+}
+
+BMPError bmp_delta_append(BMPDeltaWriter* writer, const BMPImage* frame) {
+    if (!writer || !frame || !frame->data ||
+        (writer->previous && (frame->width != writer->previous->width ||
+                              frame->height != writer->previous->height))) {
+        return BMP_ERR_INVALID_ARGUMENT;
+    }
+
+    /* Tile indices are stored as u32 */
+    size_t count = tile_count(frame, writer->tile_size);
+    if (count > UINT32_MAX) return BMP_ERR_INVALID_ARGUMENT;
+    int keyframe = !writer->previous ||
+                   (writer->keyframe_interval > 0 && writer->frame_count % writer->keyframe_interval == 0);
+    uint8_t* dirty = NULL;
+    size_t dirty_count = count;
+
+    if (!writer->previous) {
+        BMPError err;
+        writer->previous = bmp_clone(frame, &err);
+        if (!writer->previous) return err;
+    } else {
+        dirty = (uint8_t*)malloc(count);
+        if (!dirty) return BMP_ERR_MALLOC_FAILED;
+        dirty_count = 0;
+        for (size_t t = 0; t < count; t++) {
+            int x, y, w, h;
+            tile_rect(frame, writer->tile_size, t, &x, &y, &w, &h);
+            dirty[t] = (uint8_t)tile_update(writer->previous, frame, x, y, w, h);
+            dirty_count += dirty[t];
+        }
+        /* A delta touching every tile is only larger than the keyframe */
+        if (dirty_count == count) keyframe = 1;
+    }
+
+    uint8_t record[8] = { 0 };
+    record[0] = keyframe ? DELTA_KEYFRAME : DELTA_TILES;
+    put_le32(record + 4, keyframe ? 0u : (uint32_t)dirty_count);
+    BMPError err = fwrite(record, 1, sizeof(record), writer->file) == sizeof(record) ? BMP_SUCCESS : BMP_ERR_IO;
+
+    if (err == BMP_SUCCESS && keyframe) {
+        size_t bytes = (size_t)frame->width * frame->height * sizeof(Pixel);
+        if (fwrite(frame->data, 1, bytes, writer->file) != bytes) err = BMP_ERR_IO;
+    }
+    for (size_t t = 0; err == BMP_SUCCESS && !keyframe && t < count; t++) {
+        if (!dirty[t]) continue;
+        int x, y, w, h;
+        tile_rect(frame, writer->tile_size, t, &x, &y, &w, &h);
+        uint8_t index[4];
+        put_le32(index, (uint32_t)t);
+        if (fwrite(index, 1, sizeof(index), writer->file) != sizeof(index)) err = BMP_ERR_IO;
+        for (int r = 0; err == BMP_SUCCESS && r < h; r++) {
+            if (fwrite(&frame->data[(size_t)(y + r) * frame->width + x], sizeof(Pixel), (size_t)w,
+                       writer->file) != (size_t)w) {
+                err = BMP_ERR_IO;
+            }
+        }
+    }
+    free(dirty);
+
+    if (err == BMP_SUCCESS) writer->frame_count++;
+    return err;
+}
+
+BMPError bmp_delta_finish(BMPDeltaWriter* writer) {
+    if (!writer) return BMP_ERR_INVALID_ARGUMENT;
+    BMPError err = write_header(writer->file, writer->tile_size, writer->previous, writer->frame_count);
+    if (fclose(writer->file) != 0 && err == BMP_SUCCESS) err = BMP_ERR_IO;
+    bmp_free(writer->previous);
+    free(writer);
+    return err;
+}
+
+BMPDeltaReader* bmp_delta_open(const char* filename, BMPError* err_out) {
+    FILE* file = filename ? fopen(filename, "rb") : NULL;
+    if (!file) {
+        if (err_out) *err_out = BMP_ERR_FILE_NOT_FOUND;
+        return NULL;
+    }
+
+    uint8_t header[DELTA_HEADER_SIZE];
+    uint32_t width = 0, height = 0, tile_size = 0;
+    if (fread(header, 1, sizeof(header), file) == sizeof(header) && memcmp(header, "BMAPDLTA", 8) == 0 &&
+        get_le32(header + 8) == DELTA_VERSION) {
+        tile_size = get_le32(header + 12);
+        width = get_le32(header + 16);
+        height = get_le32(header + 20);
+    }
+    /* The first frame is a full keyframe, so a size the file cannot hold is never allocated */
+    struct stat st;
+    uint64_t keyframe_end = DELTA_HEADER_SIZE + 8 + (uint64_t)width * height * sizeof(Pixel);
+    if (tile_size == 0 || tile_size > BMP_SEQUENCE_MAX_TILE || width > 0x7fffffffu || height > 0x7fffffffu ||
+        (width == 0) != (height == 0) ||
+        (width && (fstat(fileno(file), &st) != 0 || keyframe_end > (uint64_t)st.st_size))) {
+        fclose(file);
+        if (err_out) *err_out = BMP_ERR_INVALID_FORMAT;
+        return NULL;
+    }
+
+    BMPDeltaReader* reader = (BMPDeltaReader*)calloc(1, sizeof(BMPDeltaReader));
+    BMPImage* frame = width ? bmp_create((int)width, (int)height, err_out) : NULL;
+    if (!reader || (width && !frame)) {
+        fclose(file);
+        free(reader);
+        bmp_free(frame);
+        if (err_out) *err_out = BMP_ERR_MALLOC_FAILED;
+        return NULL;
+    }
+    reader->file = file;
+    reader->tile_size = (int)tile_size;
+    reader->frame_count = width ? (int)get_le32(header + 24) : 0;
+    reader->frame = frame;
+    if (err_out) *err_out = BMP_SUCCESS;
+    return reader;
+}
+
+int bmp_delta_frame_count(const BMPDeltaReader* reader) {
+    return reader ? reader->frame_count : 0;
+}
+
+const BMPImage* bmp_delta_read(BMPDeltaReader* reader, BMPError* err_out) {
+    if (!reader) {
+        if (err_out) *err_out = BMP_ERR_INVALID_ARGUMENT;
+        return NULL;
+    }
+    if (reader->frames_read >= reader->frame_count) {
+        if (err_out) *err_out = BMP_SUCCESS;
+        return NULL;
+    }
+
+    BMPImage* frame = reader->frame;
+    uint8_t record[8];
+    int ok = fread(record, 1, sizeof(record), reader->file) == sizeof(record);
+    if (ok && record[0] == DELTA_KEYFRAME) {
+        size_t count = (size_t)frame->width * frame->height;
+        ok = fread(frame->data, sizeof(Pixel), count, reader->file) == count;
+    } else if (ok && record[0] == DELTA_TILES && reader->frames_read > 0) {
+        uint32_t dirty = get_le32(record + 4);
+        size_t count = tile_count(frame, reader->tile_size);
+        ok = dirty <= count;
+        for (uint32_t i = 0; ok && i < dirty; i++) {
+            uint8_t index[4];
+            ok = fread(index, 1, sizeof(index), reader->file) == sizeof(index) && get_le32(index) < count;
+            int x = 0, y = 0, w = 0, h = 0;
+            if (ok) tile_rect(frame, reader->tile_size, get_le32(index), &x, &y, &w, &h);
+            for (int r = 0; ok && r < h; r++) {
+                ok = fread(&frame->data[(size_t)(y + r) * frame->width + x], sizeof(Pixel), (size_t)w,
+                           reader->file) == (size_t)w;
+            }
+        }
+    } else {
+        ok = 0;
+    }
+
+    if (!ok) {
+        if (err_out) *err_out = BMP_ERR_INVALID_FORMAT;
+        return NULL;
+    }
+    reader->frames_read++;
+    if (err_out) *err_out = BMP_SUCCESS;
+    return frame;
+}
+
+void bmp_delta_close(BMPDeltaReader* reader) {
+    if (!reader) return;
+    fclose(reader->file);
+    bmp_free(reader->frame);
+    free(reader);
+}
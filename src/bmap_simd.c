@@ -0,0 +1,714 @@
+/**
+ * @file bmap_simd.c
+ * @brief Per-ISA pixel kernels and the runtime dispatch table.
+ * * Each hot kernel has a scalar version plus SSE4.1, AVX2 and AVX-512BW
+ * variants on x86 (GCC/Clang). The best variant the CPU supports is chosen
+ * once, on first use; setting BMAP_FORCE_ISA to scalar, sse4.1, avx2 or
+ * avx512 caps the choice, which is how each path is tested and benchmarked.
+ * @author Arda Aksu
+ * @date 2026
+ * @see bmap_internal.h for the kernel table.
+ */
+
+#include "bmap_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BMAP_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+/* --- Scalar Kernels --- */
+
+static void scalar_grayscale(Pixel* px, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        uint8_t avg = (px[i].red + px[i].green + px[i].blue) / 3;
+
+        px[i].red = avg;
+        px[i].green = avg;
+        px[i].blue = avg;
+    }
+}
+
+static void scalar_invert(Pixel* px, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        px[i].blue = (255 - px[i].blue);
+        px[i].red = (255 - px[i].red);
+        px[i].green = (255 - px[i].green);
+    }
+}
+
+static void scalar_flip_row(Pixel* row, int width) {
+    for (int j = 0, k = width - 1; j < k; j++, k--) {
+        Pixel tmp = row[j];
+        row[j] = row[k];
+        row[k] = tmp;
+    }
+}
+
+static void scalar_rotate_tile(Pixel* dst, size_t dst_stride, const Pixel* src, size_t src_stride, int rows, int cols) {
+    for (int i = 0; i < rows; i++) {
+        const Pixel* row = src + (size_t)i * src_stride;
+        Pixel* out = dst + (rows - 1 - i);
+        for (int j = 0; j < cols; j++) out[(size_t)j * dst_stride] = row[j];
+    }
+}
+
+static void scalar_swap_rb(uint8_t* dst, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; i++, src += 3, dst += 3) {
+        uint8_t first = src[0];
+        dst[1] = src[1];
+        dst[0] = src[2];
+        dst[2] = first;
+    }
+}
+
+static uint64_t scalar_abs_diff(uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t bytes, uint8_t* max_out) {
+    uint64_t sum = 0;
+    uint8_t max = *max_out;
+    for (size_t i = 0; i < bytes; i++) {
+        uint8_t d = a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+        sum += (uint32_t)d * d;
+        if (d > max) max = d;
+        if (dst) dst[i] = d;
+    }
+    *max_out = max;
+    return sum;
+}
+
+static void scalar_hash_stripes(uint64_t* acc, const uint8_t* in, const uint8_t* secret, size_t stripes) {
+    for (size_t s = 0; s < stripes; s++, in += 64, secret += 8) {
+        for (int i = 0; i < 8; i++) {
+            uint64_t data, key;
+            memcpy(&data, in + 8 * i, 8);
+            memcpy(&key, secret + 8 * i, 8);
+            key ^= data;
+            acc[i ^ 1] += data;
+            acc[i] += (key & 0xFFFFFFFFu) * (key >> 32);
+        }
+    }
+}
+
+static void scalar_blend(uint8_t* dst, const uint8_t* src, const uint8_t* alpha, uint8_t opacity,
+                         size_t bytes, BMPBlendMode mode) {
+    for (size_t i = 0; i < bytes; i++) {
+        uint32_t s = src[i], d = dst[i], a = alpha ? bmap_div255((uint32_t)alpha[i] * opacity) : opacity, b;
+        switch (mode) {
+        case BMP_BLEND_MULTIPLY: b = bmap_div255(s * d); break;
+        case BMP_BLEND_SCREEN: b = 255 - bmap_div255((255 - s) * (255 - d)); break;
+        case BMP_BLEND_ADD: b = s + d > 255 ? 255 : s + d; break;
+        default: b = s; break;
+        }
+        dst[i] = bmap_div255(b * a + d * (255 - a));
+    }
+}
+
+/* Same formulas on 16-bit linear light; every intermediate fits in 32 bits (65535 * 65535 + 32767 < 2^32) */
+static void scalar_blend_linear(uint8_t* dst, const uint8_t* src, const uint8_t* alpha, uint8_t opacity,
+                                size_t bytes, BMPBlendMode mode) {
+    const uint16_t* decode = bmp_srgb_to_linear16;
+    for (size_t i = 0; i < bytes; i++) {
+        uint32_t s = decode[src[i]], d = decode[dst[i]], b;
+        uint32_t a = alpha ? bmap_div255((uint32_t)alpha[i] * opacity) : opacity;
+        switch (mode) {
+        case BMP_BLEND_MULTIPLY: b = (s * d + 32767) / 65535; break;
+        case BMP_BLEND_SCREEN: b = 65535 - ((65535 - s) * (65535 - d) + 32767) / 65535; break;
+        case BMP_BLEND_ADD: b = s + d > 65535 ? 65535 : s + d; break;
+        default: b = s; break;
+        }
+        dst[i] = bmp_linear12_to_srgb[(b * a + d * (255 - a) + 127) / 255 >> 4];
+    }
+}
+
+static void scalar_expand3(uint8_t* dst, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; i++, dst += 3) dst[0] = dst[1] = dst[2] = src[i];
+}
+
+static void scalar_matrix3(uint8_t* dst, const uint8_t* src, size_t count, const BmapColorMatrix* m) {
+    for (size_t i = 0; i < count; i++, src += 3, dst += 3) {
+        int in[3] = { src[0] - m->in_offset[0], src[1] - m->in_offset[1], src[2] - m->in_offset[2] };
+        for (int k = 0; k < 3; k++) {
+            int v = ((m->coeff[k][0] * in[0] + m->coeff[k][1] * in[1] + m->coeff[k][2] * in[2] +
+                      (1 << (BMAP_MATRIX_BITS - 1))) >> BMAP_MATRIX_BITS) + m->out_offset[k];
+            dst[k] = (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+        }
+    }
+}
+
+static void scalar_split3(uint8_t* c0, uint8_t* c1, uint8_t* c2, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; i++, src += 3) {
+        c0[i] = src[0];
+        c1[i] = src[1];
+        c2[i] = src[2];
+    }
+}
+
+static void scalar_merge3(uint8_t* dst, const uint8_t* c0, const uint8_t* c1, const uint8_t* c2, size_t count) {
+    for (size_t i = 0; i < count; i++, dst += 3) {
+        dst[0] = c0[i];
+        dst[1] = c1[i];
+        dst[2] = c2[i];
+    }
+}
+
+static void scalar_average2x2(uint8_t* dst, const uint8_t* row0, const uint8_t* row1, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = (uint8_t)((row0[2 * i] + row0[2 * i + 1] + row1[2 * i] + row1[2 * i + 1] + 2) >> 2);
+    }
+}
+
+static const BmapKernels scalar_kernels = {
+    "scalar", scalar_grayscale, scalar_invert, scalar_flip_row, scalar_rotate_tile, scalar_swap_rb, scalar_abs_diff,
+    scalar_hash_stripes, scalar_blend, scalar_blend_linear, scalar_expand3, scalar_matrix3, scalar_split3,
+    scalar_merge3, scalar_average2x2
+};
+
+#ifdef BMAP_X86_DISPATCH
+
+/* --- Shuffle Masks (one 16-pixel group per 128-bit lane) --- */
+
+/* [channel][input vector]: gathers channel c of the 16 pixels into one vector */
+static const uint8_t simd_deinterleave_masks[3][3][16] = {
+    {
+        { 0x00, 0x03, 0x06, 0x09, 0x0C, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x02, 0x05, 0x08, 0x0B, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x04, 0x07, 0x0A, 0x0D },
+    },
+    {
+        { 0x01, 0x04, 0x07, 0x0A, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x03, 0x06, 0x09, 0x0C, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x02, 0x05, 0x08, 0x0B, 0x0E },
+    },
+    {
+        { 0x02, 0x05, 0x08, 0x0B, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x04, 0x07, 0x0A, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x03, 0x06, 0x09, 0x0C, 0x0F },
+    },
+};
+
+/* [output vector]: repeats each of the 16 gray bytes three times */
+static const uint8_t simd_gray_spread_masks[3][16] = {
+    { 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x03, 0x03, 0x03, 0x04, 0x04, 0x04, 0x05 },
+    { 0x05, 0x05, 0x06, 0x06, 0x06, 0x07, 0x07, 0x07, 0x08, 0x08, 0x08, 0x09, 0x09, 0x09, 0x0A, 0x0A },
+    { 0x0A, 0x0B, 0x0B, 0x0B, 0x0C, 0x0C, 0x0C, 0x0D, 0x0D, 0x0D, 0x0E, 0x0E, 0x0E, 0x0F, 0x0F, 0x0F },
+};
+
+/* [output vector][channel]: scatters three channel vectors back into 16 pixels */
+static const uint8_t simd_interleave_masks[3][3][16] = {
+    {
+        { 0x00, 0x80, 0x80, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x03, 0x80, 0x80, 0x04, 0x80, 0x80, 0x05 },
+        { 0x80, 0x00, 0x80, 0x80, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x03, 0x80, 0x80, 0x04, 0x80, 0x80 },
+        { 0x80, 0x80, 0x00, 0x80, 0x80, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x03, 0x80, 0x80, 0x04, 0x80 },
+    },
+    {
+        { 0x80, 0x80, 0x06, 0x80, 0x80, 0x07, 0x80, 0x80, 0x08, 0x80, 0x80, 0x09, 0x80, 0x80, 0x0A, 0x80 },
+        { 0x05, 0x80, 0x80, 0x06, 0x80, 0x80, 0x07, 0x80, 0x80, 0x08, 0x80, 0x80, 0x09, 0x80, 0x80, 0x0A },
+        { 0x80, 0x05, 0x80, 0x80, 0x06, 0x80, 0x80, 0x07, 0x80, 0x80, 0x08, 0x80, 0x80, 0x09, 0x80, 0x80 },
+    },
+    {
+        { 0x80, 0x0B, 0x80, 0x80, 0x0C, 0x80, 0x80, 0x0D, 0x80, 0x80, 0x0E, 0x80, 0x80, 0x0F, 0x80, 0x80 },
+        { 0x80, 0x80, 0x0B, 0x80, 0x80, 0x0C, 0x80, 0x80, 0x0D, 0x80, 0x80, 0x0E, 0x80, 0x80, 0x0F, 0x80 },
+        { 0x0A, 0x80, 0x80, 0x0B, 0x80, 0x80, 0x0C, 0x80, 0x80, 0x0D, 0x80, 0x80, 0x0E, 0x80, 0x80, 0x0F },
+    },
+};
+
+/* [output vector][input vector]: reverses the pixel order of the group */
+static const uint8_t simd_reverse_masks[3][3][16] = {
+    {
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x0E },
+        { 0x0D, 0x0E, 0x0F, 0x0A, 0x0B, 0x0C, 0x07, 0x08, 0x09, 0x04, 0x05, 0x06, 0x01, 0x02, 0x03, 0x80 },
+    },
+    {
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x0F, 0x80 },
+        { 0x0F, 0x80, 0x0B, 0x0C, 0x0D, 0x08, 0x09, 0x0A, 0x05, 0x06, 0x07, 0x02, 0x03, 0x04, 0x80, 0x00 },
+        { 0x80, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    },
+    {
+        { 0x80, 0x0C, 0x0D, 0x0E, 0x09, 0x0A, 0x0B, 0x06, 0x07, 0x08, 0x03, 0x04, 0x05, 0x00, 0x01, 0x02 },
+        { 0x01, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    },
+};
+
+/* [output vector][input vector]: exchanges the first and third byte of every pixel */
+static const uint8_t simd_swap_rb_masks[3][3][16] = {
+    {
+        { 0x02, 0x01, 0x00, 0x05, 0x04, 0x03, 0x08, 0x07, 0x06, 0x0B, 0x0A, 0x09, 0x0E, 0x0D, 0x0C, 0x80 },
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01 },
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    },
+    {
+        { 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+        { 0x00, 0x80, 0x04, 0x03, 0x02, 0x07, 0x06, 0x05, 0x0A, 0x09, 0x08, 0x0D, 0x0C, 0x0B, 0x80, 0x0F },
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x80 },
+    },
+    {
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+        { 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+        { 0x80, 0x03, 0x02, 0x01, 0x06, 0x05, 0x04, 0x09, 0x08, 0x07, 0x0C, 0x0B, 0x0A, 0x0F, 0x0E, 0x0D },
+    },
+};
+
+#define M128(p) _mm_loadu_si128((const __m128i*)(p))
+#define S128(p, v) _mm_storeu_si128((__m128i*)(p), (v))
+
+/* --- SSE4.1 --- */
+
+#define ISA_SUFFIX sse41
+#define ISA_TARGET "sse4.1"
+#define VEC __m128i
+#define VEC_LANES 1
+#define VEC_BYTES 16
+#define VEC_MASK(m) M128(m)
+#define VEC_LOAD3(p, k) M128((p) + 16 * (k))
+#define VEC_STORE3(p, k, v) S128((p) + 16 * (k), (v))
+#define VEC_STORE3_REV(p, k, v) VEC_STORE3(p, k, v)
+#define VEC_STORE3_ROWS(p, stride, k, v) ((void)(stride), S128((p) + 16 * (k), (v)))
+#define VEC_LOADU(p) M128(p)
+#define VEC_STOREU(p, v) S128(p, v)
+#define VEC_SHUF _mm_shuffle_epi8
+#define VEC_OR _mm_or_si128
+#define VEC_XOR _mm_xor_si128
+#define VEC_ADD16 _mm_add_epi16
+#define VEC_MULHI16 _mm_mulhi_epu16
+#define VEC_UNPACKLO8 _mm_unpacklo_epi8
+#define VEC_UNPACKHI8 _mm_unpackhi_epi8
+#define VEC_PACKUS16 _mm_packus_epi16
+#define VEC_ZERO _mm_setzero_si128()
+#define VEC_SET1_8 _mm_set1_epi8
+#define VEC_SET1_16 _mm_set1_epi16
+#define VEC_SUBS8 _mm_subs_epu8
+#define VEC_MAX8 _mm_max_epu8
+#define VEC_MADD16 _mm_madd_epi16
+#define VEC_ADD32 _mm_add_epi32
+#define VEC_ADD64 _mm_add_epi64
+#define VEC_UNPACKLO32 _mm_unpacklo_epi32
+#define VEC_UNPACKHI32 _mm_unpackhi_epi32
+#define VEC_MUL32 _mm_mul_epu32
+#define VEC_SRLI64 _mm_srli_epi64
+#define VEC_SWAP64(v) _mm_shuffle_epi32((v), 0x4E)
+#define VEC_MULLO16 _mm_mullo_epi16
+#define VEC_SRLI16 _mm_srli_epi16
+#define VEC_ADDS8 _mm_adds_epu8
+#define VEC_SUB16 _mm_sub_epi16
+#define VEC_UNPACKLO16 _mm_unpacklo_epi16
+#define VEC_UNPACKHI16 _mm_unpackhi_epi16
+#define VEC_SRAI32 _mm_srai_epi32
+#define VEC_PACKS32 _mm_packs_epi32
+#define VEC_SET1_32 _mm_set1_epi32
+#define VEC_MADDUBS _mm_maddubs_epi16
+#define VEC_PACKUS16_LINEAR _mm_packus_epi16
+#include "bmap_simd_x86.h"
+#undef ISA_SUFFIX
+#undef ISA_TARGET
+#undef VEC
+#undef VEC_LANES
+#undef VEC_BYTES
+#undef VEC_MASK
+#undef VEC_LOAD3
+#undef VEC_STORE3
+#undef VEC_STORE3_REV
+#undef VEC_STORE3_ROWS
+#undef VEC_LOADU
+#undef VEC_STOREU
+#undef VEC_SHUF
+#undef VEC_OR
+#undef VEC_XOR
+#undef VEC_ADD16
+#undef VEC_MULHI16
+#undef VEC_UNPACKLO8
+#undef VEC_UNPACKHI8
+#undef VEC_PACKUS16
+#undef VEC_ZERO
+#undef VEC_SET1_8
+#undef VEC_SET1_16
+#undef VEC_SUBS8
+#undef VEC_MAX8
+#undef VEC_MADD16
+#undef VEC_ADD32
+#undef VEC_ADD64
+#undef VEC_UNPACKLO32
+#undef VEC_UNPACKHI32
+#undef VEC_MUL32
+#undef VEC_SRLI64
+#undef VEC_SWAP64
+#undef VEC_MULLO16
+#undef VEC_SRLI16
+#undef VEC_ADDS8
+#undef VEC_SUB16
+#undef VEC_UNPACKLO16
+#undef VEC_UNPACKHI16
+#undef VEC_SRAI32
+#undef VEC_PACKS32
+#undef VEC_SET1_32
+#undef VEC_MADDUBS
+#undef VEC_PACKUS16_LINEAR
+
+/* --- AVX2 (two groups per vector) --- */
+
+#define ISA_SUFFIX avx2
+#define ISA_TARGET "avx2"
+#define VEC __m256i
+#define VEC_LANES 2
+#define VEC_BYTES 32
+#define VEC_MASK(m) _mm256_broadcastsi128_si256(M128(m))
+#define VEC_LOAD3(p, k) _mm256_inserti128_si256(_mm256_castsi128_si256(M128((p) + 16 * (k))), \
+                                                M128((p) + 48 + 16 * (k)), 1)
+#define VEC_STORE3(p, k, v) (S128((p) + 16 * (k), _mm256_castsi256_si128(v)), \
+                             S128((p) + 48 + 16 * (k), _mm256_extracti128_si256((v), 1)))
+#define VEC_STORE3_REV(p, k, v) (S128((p) + 48 + 16 * (k), _mm256_castsi256_si128(v)), \
+                                 S128((p) + 16 * (k), _mm256_extracti128_si256((v), 1)))
+#define VEC_STORE3_ROWS(p, stride, k, v) (S128((p) + 16 * (k), _mm256_castsi256_si128(v)), \
+                                          S128((p) + (stride) + 16 * (k), _mm256_extracti128_si256((v), 1)))
+#define VEC_LOADU(p) _mm256_loadu_si256((const __m256i*)(p))
+#define VEC_STOREU(p, v) _mm256_storeu_si256((__m256i*)(p), (v))
+#define VEC_SHUF _mm256_shuffle_epi8
+#define VEC_OR _mm256_or_si256
+#define VEC_XOR _mm256_xor_si256
+#define VEC_ADD16 _mm256_add_epi16
+#define VEC_MULHI16 _mm256_mulhi_epu16
+#define VEC_UNPACKLO8 _mm256_unpacklo_epi8
+#define VEC_UNPACKHI8 _mm256_unpackhi_epi8
+#define VEC_PACKUS16 _mm256_packus_epi16
+#define VEC_ZERO _mm256_setzero_si256()
+#define VEC_SET1_8 _mm256_set1_epi8
+#define VEC_SET1_16 _mm256_set1_epi16
+#define VEC_SUBS8 _mm256_subs_epu8
+#define VEC_MAX8 _mm256_max_epu8
+#define VEC_MADD16 _mm256_madd_epi16
+#define VEC_ADD32 _mm256_add_epi32
+#define VEC_ADD64 _mm256_add_epi64
+#define VEC_UNPACKLO32 _mm256_unpacklo_epi32
+#define VEC_UNPACKHI32 _mm256_unpackhi_epi32
+#define VEC_MUL32 _mm256_mul_epu32
+#define VEC_SRLI64 _mm256_srli_epi64
+#define VEC_SWAP64(v) _mm256_shuffle_epi32((v), 0x4E)
+#define VEC_MULLO16 _mm256_mullo_epi16
+#define VEC_SRLI16 _mm256_srli_epi16
+#define VEC_ADDS8 _mm256_adds_epu8
+#define VEC_SUB16 _mm256_sub_epi16
+#define VEC_UNPACKLO16 _mm256_unpacklo_epi16
+#define VEC_UNPACKHI16 _mm256_unpackhi_epi16
+#define VEC_SRAI32 _mm256_srai_epi32
+#define VEC_PACKS32 _mm256_packs_epi32
+#define VEC_SET1_32 _mm256_set1_epi32
+#define VEC_MADDUBS _mm256_maddubs_epi16
+#define VEC_PACKUS16_LINEAR(a, b) _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8)
+#include "bmap_simd_x86.h"
+#undef ISA_SUFFIX
+#undef ISA_TARGET
+#undef VEC
+#undef VEC_LANES
+#undef VEC_BYTES
+#undef VEC_MASK
+#undef VEC_LOAD3
+#undef VEC_STORE3
+#undef VEC_STORE3_REV
+#undef VEC_STORE3_ROWS
+#undef VEC_LOADU
+#undef VEC_STOREU
+#undef VEC_SHUF
+#undef VEC_OR
+#undef VEC_XOR
+#undef VEC_ADD16
+#undef VEC_MULHI16
+#undef VEC_UNPACKLO8
+#undef VEC_UNPACKHI8
+#undef VEC_PACKUS16
+#undef VEC_ZERO
+#undef VEC_SET1_8
+#undef VEC_SET1_16
+#undef VEC_SUBS8
+#undef VEC_MAX8
+#undef VEC_MADD16
+#undef VEC_ADD32
+#undef VEC_ADD64
+#undef VEC_UNPACKLO32
+#undef VEC_UNPACKHI32
+#undef VEC_MUL32
+#undef VEC_SRLI64
+#undef VEC_SWAP64
+#undef VEC_MULLO16
+#undef VEC_SRLI16
+#undef VEC_ADDS8
+#undef VEC_SUB16
+#undef VEC_UNPACKLO16
+#undef VEC_UNPACKHI16
+#undef VEC_SRAI32
+#undef VEC_PACKS32
+#undef VEC_SET1_32
+#undef VEC_MADDUBS
+#undef VEC_PACKUS16_LINEAR
+
+/* --- AVX-512BW (four groups per vector) --- */
+
+#define ISA_SUFFIX avx512
+#define ISA_TARGET "avx512f,avx512bw"
+#define VEC __m512i
+#define VEC_LANES 4
+#define VEC_BYTES 64
+#define VEC_MASK(m) _mm512_broadcast_i32x4(M128(m))
+#define VEC_LOAD3(p, k) \
+    _mm512_inserti32x4(_mm512_inserti32x4(_mm512_inserti32x4(_mm512_castsi128_si512(M128((p) + 16 * (k))), \
+        M128((p) + 48 + 16 * (k)), 1), M128((p) + 96 + 16 * (k)), 2), M128((p) + 144 + 16 * (k)), 3)
+#define VEC_STORE3(p, k, v) (S128((p) + 16 * (k), _mm512_extracti32x4_epi32((v), 0)), \
+                             S128((p) + 48 + 16 * (k), _mm512_extracti32x4_epi32((v), 1)), \
+                             S128((p) + 96 + 16 * (k), _mm512_extracti32x4_epi32((v), 2)), \
+                             S128((p) + 144 + 16 * (k), _mm512_extracti32x4_epi32((v), 3)))
+#define VEC_STORE3_REV(p, k, v) (S128((p) + 144 + 16 * (k), _mm512_extracti32x4_epi32((v), 0)), \
+                                 S128((p) + 96 + 16 * (k), _mm512_extracti32x4_epi32((v), 1)), \
+                                 S128((p) + 48 + 16 * (k), _mm512_extracti32x4_epi32((v), 2)), \
+                                 S128((p) + 16 * (k), _mm512_extracti32x4_epi32((v), 3)))
+#define VEC_STORE3_ROWS(p, stride, k, v) \
+    (S128((p) + 16 * (k), _mm512_extracti32x4_epi32((v), 0)),                  \
+     S128((p) + (stride) + 16 * (k), _mm512_extracti32x4_epi32((v), 1)),       \
+     S128((p) + 2 * (stride) + 16 * (k), _mm512_extracti32x4_epi32((v), 2)),   \
+     S128((p) + 3 * (stride) + 16 * (k), _mm512_extracti32x4_epi32((v), 3)))
+#define VEC_LOADU(p) _mm512_loadu_si512((const void*)(p))
+#define VEC_STOREU(p, v) _mm512_storeu_si512((void*)(p), (v))
+#define VEC_SHUF _mm512_shuffle_epi8
+#define VEC_OR _mm512_or_si512
+#define VEC_XOR _mm512_xor_si512
+#define VEC_ADD16 _mm512_add_epi16
+#define VEC_MULHI16 _mm512_mulhi_epu16
+#define VEC_UNPACKLO8 _mm512_unpacklo_epi8
+#define VEC_UNPACKHI8 _mm512_unpackhi_epi8
+#define VEC_PACKUS16 _mm512_packus_epi16
+#define VEC_ZERO _mm512_setzero_si512()
+#define VEC_SET1_8 _mm512_set1_epi8
+#define VEC_SET1_16 _mm512_set1_epi16
+#define VEC_SUBS8 _mm512_subs_epu8
+#define VEC_MAX8 _mm512_max_epu8
+#define VEC_MADD16 _mm512_madd_epi16
+#define VEC_ADD32 _mm512_add_epi32
+#define VEC_ADD64 _mm512_add_epi64
+#define VEC_UNPACKLO32 _mm512_unpacklo_epi32
+#define VEC_UNPACKHI32 _mm512_unpackhi_epi32
+#define VEC_MUL32 _mm512_mul_epu32
+#define VEC_SRLI64 _mm512_srli_epi64
+#define VEC_SWAP64(v) _mm512_shuffle_epi32((v), (_MM_PERM_ENUM)0x4E)
+#define VEC_MULLO16 _mm512_mullo_epi16
+#define VEC_SRLI16 _mm512_srli_epi16
+#define VEC_ADDS8 _mm512_adds_epu8
+#define VEC_SUB16 _mm512_sub_epi16
+#define VEC_UNPACKLO16 _mm512_unpacklo_epi16
+#define VEC_UNPACKHI16 _mm512_unpackhi_epi16
+#define VEC_SRAI32 _mm512_srai_epi32
+#define VEC_PACKS32 _mm512_packs_epi32
+#define VEC_SET1_32 _mm512_set1_epi32
+#define VEC_MADDUBS _mm512_maddubs_epi16
+#define VEC_PACKUS16_LINEAR(a, b) \
+    _mm512_permutexvar_epi64(_mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7), _mm512_packus_epi16(a, b))
+#include "bmap_simd_x86.h"
+#undef ISA_SUFFIX
+#undef ISA_TARGET
+#undef VEC
+#undef VEC_LANES
+#undef VEC_BYTES
+#undef VEC_MASK
+#undef VEC_LOAD3
+#undef VEC_STORE3
+#undef VEC_STORE3_REV
+#undef VEC_STORE3_ROWS
+#undef VEC_LOADU
+#undef VEC_STOREU
+#undef VEC_SHUF
+#undef VEC_OR
+#undef VEC_XOR
+#undef VEC_ADD16
+#undef VEC_MULHI16
+#undef VEC_UNPACKLO8
+#undef VEC_UNPACKHI8
+#undef VEC_PACKUS16
+#undef VEC_ZERO
+#undef VEC_SET1_8
+#undef VEC_SET1_16
+#undef VEC_SUBS8
+#undef VEC_MAX8
+#undef VEC_MADD16
+#undef VEC_ADD32
+#undef VEC_ADD64
+#undef VEC_UNPACKLO32
+#undef VEC_UNPACKHI32
+#undef VEC_MUL32
+#undef VEC_SRLI64
+#undef VEC_SWAP64
+#undef VEC_MULLO16
+#undef VEC_SRLI16
+#undef VEC_ADDS8
+#undef VEC_SUB16
+#undef VEC_UNPACKLO16
+#undef VEC_UNPACKHI16
+#undef VEC_SRAI32
+#undef VEC_PACKS32
+#undef VEC_SET1_32
+#undef VEC_MADDUBS
+#undef VEC_PACKUS16_LINEAR
+
+/* --- AVX-512BW Linear-Light Blend --- */
+
+/*
+ * The linear blend is bound by its sRGB table lookups. SSE4.1 and AVX2
+ * gathers are no faster than scalar loads, so those tables keep
+ * scalar_blend_linear. With AVX-512BW the 256-entry decode table fits in
+ * eight registers and is read with vpermt2w; the 4096-entry encode table is
+ * gathered from a 32-bit copy. The arithmetic runs on 16-bit lanes: the
+ * 24-bit mix b * a + d * (255 - a) is split by the high and low bytes of b
+ * and d into H and L, which fit 16 bits, and divided piecewise: with
+ * H = 255 * hq + hr, (mix + 127) / 255 = 256 * hq + hr + (hr + L + 127) / 255.
+ */
+static uint32_t simd_linear_encode[4096];   /* bmp_linear12_to_srgb widened, filled by select_kernels() */
+
+/* table[v] per 16-bit lane (v < 256), table held as eight vectors of 32 entries */
+__attribute__((target("avx512f,avx512bw")))
+static inline __m512i linear_decode_avx512(const __m512i* table, __m512i v) {
+    __m512i r0 = _mm512_permutex2var_epi16(table[0], v, table[1]);
+    __m512i r1 = _mm512_permutex2var_epi16(table[2], v, table[3]);
+    __m512i r2 = _mm512_permutex2var_epi16(table[4], v, table[5]);
+    __m512i r3 = _mm512_permutex2var_epi16(table[6], v, table[7]);
+    __mmask32 bit6 = _mm512_test_epi16_mask(v, _mm512_set1_epi16(64));
+    __mmask32 bit7 = _mm512_test_epi16_mask(v, _mm512_set1_epi16(128));
+    return _mm512_mask_blend_epi16(bit7, _mm512_mask_blend_epi16(bit6, r0, r1), _mm512_mask_blend_epi16(bit6, r2, r3));
+}
+
+/* Truncated x / 255 per 16-bit lane, exact for every 16-bit x */
+__attribute__((target("avx512f,avx512bw")))
+static inline __m512i div255_floor_avx512(__m512i x) {
+    return _mm512_srli_epi16(_mm512_mulhi_epu16(x, _mm512_set1_epi16((short)0x8081)), 7);
+}
+
+/* Rounded x / 65535 per 32-bit lane, exact for x <= 65535 * 65535 */
+__attribute__((target("avx512f,avx512bw")))
+static inline __m512i div65535_avx512(__m512i x) {
+    x = _mm512_add_epi32(x, _mm512_set1_epi32(32767));
+    return _mm512_srli_epi32(_mm512_add_epi32(_mm512_add_epi32(x, _mm512_srli_epi32(x, 16)), _mm512_set1_epi32(1)), 16);
+}
+
+/* Per 16-bit lane: (a * b) / 65535, rounded, through the full 32-bit products */
+__attribute__((target("avx512f,avx512bw")))
+static inline __m512i mul65535_avx512(__m512i a, __m512i b) {
+    __m512i lo = _mm512_mullo_epi16(a, b), hi = _mm512_mulhi_epu16(a, b);
+    return _mm512_packus_epi32(div65535_avx512(_mm512_unpacklo_epi16(lo, hi)),
+                               div65535_avx512(_mm512_unpackhi_epi16(lo, hi)));
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void blend_linear_avx512(uint8_t* dst, const uint8_t* src, const uint8_t* alpha, uint8_t opacity,
+                                size_t bytes, BMPBlendMode mode) {
+    const __m512i zero = _mm512_setzero_si512(), ones = _mm512_set1_epi16(-1);
+    const __m512i low = _mm512_set1_epi16(255), round = _mm512_set1_epi16(127);
+    const __m512i scale = _mm512_set1_epi16(opacity);
+    __m512i table[8], a = scale;
+    for (int k = 0; k < 8; k++) table[k] = _mm512_loadu_si512((const void*)(bmp_srgb_to_linear16 + 32 * k));
+
+    size_t i = 0;
+    for (; i + 64 <= bytes; i += 64) {
+        __m512i out[2];
+        for (int half = 0; half < 2; half++) {
+            size_t at = i + 32 * (size_t)half;
+            __m512i s = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i*)(src + at)));
+            __m512i d = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i*)(dst + at))), b;
+            s = linear_decode_avx512(table, s);
+            d = linear_decode_avx512(table, d);
+            if (alpha) {
+                a = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i*)(alpha + at)));
+                if (opacity != 255) a = div255_avx512(_mm512_mullo_epi16(a, scale));
+            }
+            switch (mode) {
+            case BMP_BLEND_MULTIPLY: b = mul65535_avx512(s, d); break;
+            case BMP_BLEND_SCREEN:
+                b = _mm512_xor_si512(mul65535_avx512(_mm512_xor_si512(s, ones), _mm512_xor_si512(d, ones)), ones);
+                break;
+            case BMP_BLEND_ADD: b = _mm512_adds_epu16(s, d); break;
+            default: b = s; break;
+            }
+
+            __m512i na = _mm512_xor_si512(a, low);
+            __m512i hi = _mm512_add_epi16(_mm512_mullo_epi16(_mm512_srli_epi16(b, 8), a),
+                                          _mm512_mullo_epi16(_mm512_srli_epi16(d, 8), na));
+            __m512i lo = _mm512_add_epi16(_mm512_mullo_epi16(_mm512_and_si512(b, low), a),
+                                          _mm512_mullo_epi16(_mm512_and_si512(d, low), na));
+            __m512i hq = div255_floor_avx512(hi), hr = _mm512_sub_epi16(hi, _mm512_mullo_epi16(hq, low));
+            __m512i q = _mm512_add_epi16(_mm512_add_epi16(_mm512_slli_epi16(hq, 8), hr),
+                                         div255_floor_avx512(_mm512_add_epi16(_mm512_add_epi16(hr, lo), round)));
+            __m512i index = _mm512_srli_epi16(q, 4);
+
+            /* The in-lane unpack and pack undo each other, so lanes keep their order */
+            out[half] = _mm512_packus_epi32(
+                _mm512_i32gather_epi32(_mm512_unpacklo_epi16(index, zero), (const void*)simd_linear_encode, 4),
+                _mm512_i32gather_epi32(_mm512_unpackhi_epi16(index, zero), (const void*)simd_linear_encode, 4));
+        }
+        _mm512_storeu_si512((void*)(dst + i), _mm512_permutexvar_epi64(_mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7),
+                                                                       _mm512_packus_epi16(out[0], out[1])));
+    }
+    scalar_blend_linear(dst + i, src + i, alpha ? alpha + i : NULL, opacity, bytes - i, mode);
+}
+
+#undef M128
+#undef S128
+
+static const BmapKernels sse41_kernels = {
+    "sse4.1", grayscale_sse41, invert_sse41, flip_row_sse41, rotate_tile_sse41, swap_rb_sse41, abs_diff_sse41,
+    hash_stripes_sse41, blend_sse41, scalar_blend_linear, expand3_sse41, matrix3_sse41, split3_sse41,
+    merge3_sse41, average2x2_sse41
+};
+static const BmapKernels avx2_kernels = {
+    "avx2", grayscale_avx2, invert_avx2, flip_row_avx2, rotate_tile_avx2, swap_rb_avx2, abs_diff_avx2,
+    hash_stripes_avx2, blend_avx2, scalar_blend_linear, expand3_avx2, matrix3_avx2, split3_avx2,
+    merge3_avx2, average2x2_avx2
+};
+static const BmapKernels avx512_kernels = {
+    "avx512", grayscale_avx512, invert_avx512, flip_row_avx512, rotate_tile_avx512, swap_rb_avx512, abs_diff_avx512,
+    hash_stripes_avx512, blend_avx512, blend_linear_avx512, expand3_avx512, matrix3_avx512, split3_avx512,
+    merge3_avx512, average2x2_avx512
+};
+
+#endif /* BMAP_X86_DISPATCH */
+
+/* --- Dispatch --- */
+
+static const BmapKernels* active_kernels = &scalar_kernels;
+static pthread_once_t kernels_once = PTHREAD_ONCE_INIT;
+
+static void select_kernels(void) {
+#ifdef BMAP_X86_DISPATCH
+    /* Ordered from the narrowest to the widest ISA */
+    const BmapKernels* candidates[] = { &scalar_kernels, &sse41_kernels, &avx2_kernels, &avx512_kernels };
+    int supported[4];
+
+    __builtin_cpu_init();
+    supported[0] = 1;
+    supported[1] = __builtin_cpu_supports("sse4.1");
+    supported[2] = supported[1] && __builtin_cpu_supports("avx2");
+    supported[3] = supported[2] && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+
+    for (int i = 0; i < 4096; i++) simd_linear_encode[i] = bmp_linear12_to_srgb[i];
+
+    int limit = 3;
+    const char* force = getenv("BMAP_FORCE_ISA");
+    if (force && *force) {
+        for (int i = 0; i < 4; i++) {
+            if (strcmp(force, candidates[i]->name) == 0) limit = i;
+        }
+    }
+
+    for (int i = limit; i >= 0; i--) {
+        if (supported[i]) {
+            active_kernels = candidates[i];
+            return;
+        }
+    }
+#endif
+}
+
+const BmapKernels* bmap_kernels(void) {
+    pthread_once(&kernels_once, select_kernels);
+    return active_kernels;
+}
+
+const char* bmp_active_isa(void) {
+    return bmap_kernels()->name;
+}
@@ -0,0 +1,423 @@
+/**
+ * @file bmap_simd_x86.h
+ * @brief Lane-generic x86 kernels, instantiated once per instruction set.
+ * * Included several times by bmap_simd.c with the VEC_* primitives and
+ * ISA_SUFFIX/ISA_TARGET defined for SSE4.1, AVX2 and AVX-512. Every kernel
+ * works on 16-pixel (48-byte) groups inside each 128-bit lane, so the same
+ * shuffle masks serve all vector widths; wider ISAs simply run more lanes.
+ * @author Arda Aksu
+ * @date 2026
+ */
+
+#define ISA_FN2(name, suffix) name##_##suffix
+#define ISA_FN1(name, suffix) ISA_FN2(name, suffix)
+#define ISA_FN(name) ISA_FN1(name, ISA_SUFFIX)
+
+/* Pixels handled per vector iteration */
+#define GROUP_PIXELS (16 * VEC_LANES)
+
+__attribute__((target(ISA_TARGET)))
+static void ISA_FN(grayscale)(Pixel* px, size_t count) {
+    uint8_t* p = (uint8_t*)px;
+    VEC deint[3][3], spread[3];
+    for (int c = 0; c < 3; c++) {
+        for (int k = 0; k < 3; k++) deint[c][k] = VEC_MASK(simd_deinterleave_masks[c][k]);
+        spread[c] = VEC_MASK(simd_gray_spread_masks[c]);
+    }
+    const VEC zero = VEC_ZERO;
+    const VEC third = VEC_SET1_16(21846);   /* (s * 21846) >> 16 == s / 3 for s <= 765 */
+
+    size_t i = 0;
+    for (; i + GROUP_PIXELS <= count; i += GROUP_PIXELS, p += 3 * GROUP_PIXELS) {
+        VEC v0 = VEC_LOAD3(p, 0), v1 = VEC_LOAD3(p, 1), v2 = VEC_LOAD3(p, 2);
+        VEC sum_lo = zero, sum_hi = zero;
+
+        for (int c = 0; c < 3; c++) {
+            VEC ch = VEC_OR(VEC_OR(VEC_SHUF(v0, deint[c][0]), VEC_SHUF(v1, deint[c][1])),
+                            VEC_SHUF(v2, deint[c][2]));
+            sum_lo = VEC_ADD16(sum_lo, VEC_UNPACKLO8(ch, zero));
+            sum_hi = VEC_ADD16(sum_hi, VEC_UNPACKHI8(ch, zero));
+        }
+
+        VEC avg = VEC_PACKUS16(VEC_MULHI16(sum_lo, third), VEC_MULHI16(sum_hi, third));
+        VEC_STORE3(p, 0, VEC_SHUF(avg, spread[0]));
+        VEC_STORE3(p, 1, VEC_SHUF(avg, spread[1]));
+        VEC_STORE3(p, 2, VEC_SHUF(avg, spread[2]));
+    }
+    scalar_grayscale(px + i, count - i);
+}
+
+__attribute__((target(ISA_TARGET)))
+static void ISA_FN(invert)(Pixel* px, size_t count) {
+    uint8_t* p = (uint8_t*)px;
+    size_t bytes = count * sizeof(Pixel);
+    const VEC ones = VEC_SET1_8((char)0xFF);
+
+    size_t i = 0;
+    for (; i + VEC_BYTES <= bytes; i += VEC_BYTES) {
+        VEC_STOREU(p + i, VEC_XOR(VEC_LOADU(p + i), ones));
+    }
+    for (; i < bytes; i++) p[i] = (uint8_t)~p[i];
+}
+
+/* Gathers channel c of the group in v0..v2 into one vector */
+#define ISA_DEINTERLEAVE(c, v0, v1, v2) \
+    VEC_OR(VEC_OR(VEC_SHUF(v0, deint[c][0]), VEC_SHUF(v1, deint[c][1])), VEC_SHUF(v2, deint[c][2]))
+
+/* Reverses GROUP_PIXELS pixels at src into dst (may be the same chunk) */
+#define ISA_REVERSE_GROUP(dst, src)                                                      \
+    do {                                                                                 \
+        VEC r0 = VEC_LOAD3(src, 0), r1 = VEC_LOAD3(src, 1), r2 = VEC_LOAD3(src, 2);      \
+        VEC o[3];                                                                        \
+        for (int k = 0; k < 3; k++) {                                                    \
+            o[k] = VEC_OR(VEC_OR(VEC_SHUF(r0, rev[k][0]), VEC_SHUF(r1, rev[k][1])),      \
+                          VEC_SHUF(r2, rev[k][2]));                                      \
+        }                                                                                \
+        VEC_STORE3_REV(dst, 0, o[0]);                                                    \
+        VEC_STORE3_REV(dst, 1, o[1]);                                                    \
+        VEC_STORE3_REV(dst, 2, o[2]);                                                    \
+    } while (0)
+
+__attribute__((target(ISA_TARGET)))
+static void ISA_FN(flip_row)(Pixel* row, int width) {
+    VEC rev[3][3];
+    for (int k = 0; k < 3; k++) {
+        for (int m = 0; m < 3; m++) rev[k][m] = VEC_MASK(simd_reverse_masks[k][m]);
+    }
+
+    /* Swap mirrored groups from both ends, then finish the middle in scalar code */
+    int j = 0, k = width;
+    uint8_t left[3 * GROUP_PIXELS];
+    while (k - j >= 2 * GROUP_PIXELS) {
+        uint8_t* lp = (uint8_t*)(row + j);
+        uint8_t* rp = (uint8_t*)(row + k - GROUP_PIXELS);
+        memcpy(left, lp, sizeof(left));
+        ISA_REVERSE_GROUP(lp, rp);
+        ISA_REVERSE_GROUP(rp, left);
+        j += GROUP_PIXELS;
+        k -= GROUP_PIXELS;
+    }
+    scalar_flip_row(row + j, k - j);
+}
+
+/*
+ * Transposes the 16x16 bytes in each 128-bit lane of r. Every round moves
+ * byte p of row v to row (v << 1 | p >> 3) & 15, byte (p << 1 | v >> 3) & 15,
+ * i.e. rotates the 8-bit (row, byte) index left by one; four rounds swap them.
+ */
+__attribute__((target(ISA_TARGET)))
+static inline void ISA_FN(transpose16)(VEC* r) {
+    VEC t[16];
+#pragma GCC unroll 4
+    for (int round = 0; round < 4; round++) {
+#pragma GCC unroll 8
+        for (int k = 0; k < 8; k++) {
+            t[2 * k] = VEC_UNPACKLO8(r[k], r[k + 8]);
+            t[2 * k + 1] = VEC_UNPACKHI8(r[k], r[k + 8]);
+        }
+#pragma GCC unroll 16
+        for (int k = 0; k < 16; k++) r[k] = t[k];
+    }
+}
+
+__attribute__((target(ISA_TARGET)))
+static void ISA_FN(rotate_tile)(Pixel* dst, size_t dst_stride, const Pixel* src, size_t src_stride,
+                                int rows, int cols) {
+    VEC deint[3][3], inter[3][3];
+    for (int c = 0; c < 3; c++) {
+        for (int k = 0; k < 3; k++) {
+            deint[c][k] = VEC_MASK(simd_deinterleave_masks[c][k]);
+            inter[c][k] = VEC_MASK(simd_interleave_masks[c][k]);
+        }
+    }
+
+    /*
+     * Blocks of 16 rows by GROUP_PIXELS columns: split into channel planes,
+     * transpose each plane per lane, interleave again. Rows are loaded bottom
+     * first, so every transposed row is already in output order; lane L holds
+     * output rows 16 * L onwards.
+     */
+    int rows16 = rows & ~15;
+    int cols_full = cols - cols % GROUP_PIXELS;
+    size_t lane_stride = (size_t)16 * dst_stride * sizeof(Pixel);
+    for (int a = 0; a < rows16; a += 16) {
+        for (int c = 0; c < cols_full; c += GROUP_PIXELS) {
+            VEC plane[3][16];
+#pragma GCC unroll 16
+            for (int k = 0; k < 16; k++) {
+                const uint8_t* p = (const uint8_t*)(src + (size_t)(a + 15 - k) * src_stride + c);
+                VEC v0 = VEC_LOAD3(p, 0), v1 = VEC_LOAD3(p, 1), v2 = VEC_LOAD3(p, 2);
+                for (int ch = 0; ch < 3; ch++) plane[ch][k] = ISA_DEINTERLEAVE(ch, v0, v1, v2);
+            }
+            for (int ch = 0; ch < 3; ch++) ISA_FN(transpose16)(plane[ch]);
+
+            uint8_t* out = (uint8_t*)(dst + (size_t)c * dst_stride + (rows - 16 - a));
+#pragma GCC unroll 16
+            for (int j = 0; j < 16; j++, out += dst_stride * sizeof(Pixel)) {
+                for (int k = 0; k < 3; k++) {
+                    VEC_STORE3_ROWS(out, lane_stride, k,
+                                    VEC_OR(VEC_OR(VEC_SHUF(plane[0][j], inter[k][0]), VEC_SHUF(plane[1][j], inter[k][1])),
+                                           VEC_SHUF(plane[2][j], inter[k][2])));
+                }
+            }
+        }
+    }
+
+    /* Leftover columns of the full row blocks, then the leftover rows */
+    scalar_rotate_tile(dst + (size_t)cols_full * dst_stride + (rows - rows16), dst_stride,
+                       src + cols_full, src_stride, rows16, cols - cols_full);
+    scalar_rotate_tile(dst, dst_stride, src + (size_t)rows16 * src_stride, src_stride, rows - rows16, cols);
+}
+
+__attribute__((target(ISA_TARGET)))
+static void ISA_FN(swap_rb)(uint8_t* dst, const uint8_t* src, size_t count) {
+    VEC swap[3][3];
+    for (int k = 0; k < 3; k++) {
+        for (int m = 0; m < 3; m++) swap[k][m] = VEC_MASK(simd_swap_rb_masks[k][m]);
+    }
+
+    /* All three loads precede the stores, so dst may equal src */
+    size_t i = 0;
+    for (; i + GROUP_PIXELS <= count; i += GROUP_PIXELS, src += 3 * GROUP_PIXELS, dst += 3 * GROUP_PIXELS) {
+        VEC v0 = VEC_LOAD3(src, 0), v1 = VEC_LOAD3(src, 1), v2 = VEC_LOAD3(src, 2);
+        VEC o[3];
+        for (int k = 0; k < 3; k++) {
+            o[k] = VEC_OR(VEC_OR(VEC_SHUF(v0, swap[k][0]), VEC_SHUF(v1, swap[k][1])),
+                          VEC_SHUF(v2, swap[k][2]));
+        }
+        VEC_STORE3(dst, 0, o[0]);
+        VEC_STORE3(dst, 1, o[1]);
+        VEC_STORE3(dst, 2, o[2]);
+    }
+    scalar_swap_rb(dst, src, count - i);
+}
+
+__attribute__((target(ISA_TARGET)))
+static uint64_t ISA_FN(abs_diff)(uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t bytes, uint8_t* max_out) {
+    const VEC zero = VEC_ZERO;
+    VEC vmax = zero, sum64 = zero;
+
+    size_t i = 0;
+    while (i + VEC_BYTES <= bytes) {
+        /* A 32-bit lane gains at most 4 * 255^2 per vector; widen before 8192 vectors overflow it */
+        size_t end = bytes - i > (size_t)8192 * VEC_BYTES ? i + (size_t)8192 * VEC_BYTES : bytes;
+        VEC sum32 = zero;
+        for (; i + VEC_BYTES <= end; i += VEC_BYTES) {
+            VEC va = VEC_LOADU(a + i), vb = VEC_LOADU(b + i);
+            VEC d = VEC_OR(VEC_SUBS8(va, vb), VEC_SUBS8(vb, va));
+            if (dst) VEC_STOREU(dst + i, d);
+            vmax = VEC_MAX8(vmax, d);
+            VEC lo = VEC_UNPACKLO8(d, zero), hi = VEC_UNPACKHI8(d, zero);
+            sum32 = VEC_ADD32(sum32, VEC_ADD32(VEC_MADD16(lo, lo), VEC_MADD16(hi, hi)));
+        }
+        sum64 = VEC_ADD64(sum64, VEC_ADD64(VEC_UNPACKLO32(sum32, zero), VEC_UNPACKHI32(sum32, zero)));
+    }
+
+    uint64_t sums[VEC_BYTES / 8];
+    uint8_t maxes[VEC_BYTES];
+    VEC_STOREU(sums, sum64);
+    VEC_STOREU(maxes, vmax);
+    uint64_t sum = 0;
+    for (int k = 0; k < VEC_BYTES / 8; k++) sum += sums[k];
+    for (int k = 0; k < VEC_BYTES; k++) {
+        if (maxes[k] > *max_out) *max_out = maxes[k];
+    }
+    return sum + scalar_abs_diff(dst ? dst + i : NULL, a + i, b + i, bytes - i, max_out);
+}
+
+__attribute__((target(ISA_TARGET)))
+static void ISA_FN(hash_stripes)(uint64_t* acc, const uint8_t* in, const uint8_t* secret, size_t stripes) {
+    /* The eight 64-bit accumulators fill 64 / VEC_BYTES vectors; i ^ 1 stays inside a 128-bit lane */
+    VEC sums[64 / VEC_BYTES];
+    for (int k = 0; k < 64 / VEC_BYTES; k++) sums[k] = VEC_LOADU((const uint8_t*)acc + k * VEC_BYTES);
+
+    for (size_t s = 0; s < stripes; s++, in += 64, secret += 8) {
+        for (int k = 0; k < 64 / VEC_BYTES; k++) {
+            VEC data = VEC_LOADU(in + k * VEC_BYTES);
+            VEC key = VEC_XOR(data, VEC_LOADU(secret + k * VEC_BYTES));
+            VEC product = VEC_MUL32(key, VEC_SRLI64(key, 32));
+            sums[k] = VEC_ADD64(sums[k], VEC_ADD64(product, VEC_SWAP64(data)));
+        }
+    }
+    for (int k = 0; k < 64 / VEC_BYTES; k++) VEC_STOREU((uint8_t*)acc + k * VEC_BYTES, sums[k]);
+}
+
+/* Rounded x / 255 per 16-bit lane, exact for x <= 255 * 255 */
+__attribute__((target(ISA_TARGET)))
+static inline VEC ISA_FN(div255)(VEC x) {
+    x = VEC_ADD16(x, VEC_SET1_16(128));
+    return VEC_SRLI16(VEC_ADD16(x, VEC_SRLI16(x, 8)), 8);
+}
+
+/* Per byte: (a * b) / 255, rounded */
+__attribute__((target(ISA_TARGET)))
+static inline VEC ISA_FN(mul255)(VEC a, VEC b) {
+    const VEC zero = VEC_ZERO;
+    VEC lo = VEC_MULLO16(VEC_UNPACKLO8(a, zero), VEC_UNPACKLO8(b, zero));
+    VEC hi = VEC_MULLO16(VEC_UNPACKHI8(a, zero), VEC_UNPACKHI8(b, zero));
+    return VEC_PACKUS16(ISA_FN(div255)(lo), ISA_FN(div255)(hi));
+}
+
+__attribute__((target(ISA_TARGET)))
+static void ISA_FN(blend)(uint8_t* dst, const uint8_t* src, const uint8_t* alpha, uint8_t opacity,
+                          size_t bytes, BMPBlendMode mode) {
+    const VEC zero = VEC_ZERO, ones = VEC_SET1_8((char)0xFF);
+    const VEC scale = VEC_SET1_8((char)opacity);
+    VEC a = scale;
+
+    size_t i = 0;
+    for (; i + VEC_BYTES <= bytes; i += VEC_BYTES) {
+        VEC s = VEC_LOADU(src + i), d = VEC_LOADU(dst + i), b;
+        if (alpha) a = opacity == 255 ? VEC_LOADU(alpha + i) : ISA_FN(mul255)(VEC_LOADU(alpha + i), scale);
+        switch (mode) {
+        case BMP_BLEND_MULTIPLY: b = ISA_FN(mul255)(s, d); break;
+        case BMP_BLEND_SCREEN: b = VEC_XOR(ISA_FN(mul255)(VEC_XOR(s, ones), VEC_XOR(d, ones)), ones); break;
+        case BMP_BLEND_ADD: b = VEC_ADDS8(s, d); break;
+        default: b = s; break;
+        }
+
+        /* b * a + d * (255 - a) never exceeds 255 * 255, so 16-bit lanes suffice */
+        VEC na = VEC_XOR(a, ones);
+        VEC lo = VEC_ADD16(VEC_MULLO16(VEC_UNPACKLO8(b, zero), VEC_UNPACKLO8(a, zero)),
+                           VEC_MULLO16(VEC_UNPACKLO8(d, zero), VEC_UNPACKLO8(na, zero)));
+        VEC hi = VEC_ADD16(VEC_MULLO16(VEC_UNPACKHI8(b, zero), VEC_UNPACKHI8(a, zero)),
+                           VEC_MULLO16(VEC_UNPACKHI8(d, zero), VEC_UNPACKHI8(na, zero)));
+        VEC_STOREU(dst + i, VEC_PACKUS16(ISA_FN(div255)(lo), ISA_FN(div255)(hi)));
+    }
+    scalar_blend(dst + i, src + i, alpha ? alpha + i : NULL, opacity, bytes - i, mode);
+}
+
+__attribute__((target(ISA_TARGET)))
+static void ISA_FN(expand3)(uint8_t* dst, const uint8_t* src, size_t count) {
+    VEC spread[3];
+    for (int c = 0; c < 3; c++) spread[c] = VEC_MASK(simd_gray_spread_masks[c]);
+
+    size_t i = 0;
+    for (; i + GROUP_PIXELS <= count; i += GROUP_PIXELS, dst += 3 * GROUP_PIXELS) {
+        VEC v = VEC_LOADU(src + i);
+        VEC_STORE3(dst, 0, VEC_SHUF(v, spread[0]));
+        VEC_STORE3(dst, 1, VEC_SHUF(v, spread[1]));
+        VEC_STORE3(dst, 2, VEC_SHUF(v, spread[2]));
+    }
+    scalar_expand3(dst, src + i, count - i);
+}
+
+/* Stores channel vectors c0..c2 as GROUP_PIXELS interleaved triples */
+#define ISA_INTERLEAVE(dst, c0, c1, c2)                                                          \
+    do {                                                                                         \
+        for (int k = 0; k < 3; k++) {                                                            \
+            VEC_STORE3(dst, k, VEC_OR(VEC_OR(VEC_SHUF(c0, inter[k][0]), VEC_SHUF(c1, inter[k][1])), \
+                                      VEC_SHUF(c2, inter[k][2])));                               \
+        }                                                                                        \
+    } while (0)
+
+__attribute__((target(ISA_TARGET)))
+static void ISA_FN(matrix3)(uint8_t* dst, const uint8_t* src, size_t count, const BmapColorMatrix* m) {
+    VEC deint[3][3], inter[3][3];
+    for (int c = 0; c < 3; c++) {
+        for (int k = 0; k < 3; k++) {
+            deint[c][k] = VEC_MASK(simd_deinterleave_masks[c][k]);
+            inter[c][k] = VEC_MASK(simd_interleave_masks[c][k]);
+        }
+    }
+
+    /* madd pairs (in0, in1) and (in2, 1); the second pair also carries the rounding term */
+    VEC pair01[3], pair2r[3], in_offset[3], out_offset[3];
+    for (int k = 0; k < 3; k++) {
+        pair01[k] = VEC_SET1_32((int)((uint32_t)(uint16_t)m->coeff[k][1] << 16 | (uint16_t)m->coeff[k][0]));
+        pair2r[k] = VEC_SET1_32((int)((uint32_t)(1 << (BMAP_MATRIX_BITS - 1)) << 16 | (uint16_t)m->coeff[k][2]));
+        in_offset[k] = VEC_SET1_16(m->in_offset[k]);
+        out_offset[k] = VEC_SET1_16(m->out_offset[k]);
+    }
+    const VEC zero = VEC_ZERO, one = VEC_SET1_16(1);
+
+    size_t i = 0;
+    for (; i + GROUP_PIXELS <= count; i += GROUP_PIXELS, src += 3 * GROUP_PIXELS, dst += 3 * GROUP_PIXELS) {
+        VEC v0 = VEC_LOAD3(src, 0), v1 = VEC_LOAD3(src, 1), v2 = VEC_LOAD3(src, 2);
+        VEC in[3][2];
+        for (int c = 0; c < 3; c++) {
+            VEC ch = ISA_DEINTERLEAVE(c, v0, v1, v2);
+            in[c][0] = VEC_SUB16(VEC_UNPACKLO8(ch, zero), in_offset[c]);
+            in[c][1] = VEC_SUB16(VEC_UNPACKHI8(ch, zero), in_offset[c]);
+        }
+
+        /* Quarters of the group: pixels 0-3, 4-7, 8-11 and 12-15 of each lane */
+        VEC p01[4], p2r[4];
+        for (int h = 0; h < 2; h++) {
+            p01[2 * h] = VEC_UNPACKLO16(in[0][h], in[1][h]);
+            p01[2 * h + 1] = VEC_UNPACKHI16(in[0][h], in[1][h]);
+            p2r[2 * h] = VEC_UNPACKLO16(in[2][h], one);
+            p2r[2 * h + 1] = VEC_UNPACKHI16(in[2][h], one);
+        }
+
+        VEC out[3];
+        for (int k = 0; k < 3; k++) {
+            VEC sum[4];
+            for (int q = 0; q < 4; q++) {
+                sum[q] = VEC_SRAI32(VEC_ADD32(VEC_MADD16(p01[q], pair01[k]), VEC_MADD16(p2r[q], pair2r[k])),
+                                    BMAP_MATRIX_BITS);
+            }
+            out[k] = VEC_PACKUS16(VEC_ADD16(VEC_PACKS32(sum[0], sum[1]), out_offset[k]),
+                                  VEC_ADD16(VEC_PACKS32(sum[2], sum[3]), out_offset[k]));
+        }
+        ISA_INTERLEAVE(dst, out[0], out[1], out[2]);
+    }
+    scalar_matrix3(dst, src, count - i, m);
+}
+
+__attribute__((target(ISA_TARGET)))
+static void ISA_FN(split3)(uint8_t* c0, uint8_t* c1, uint8_t* c2, const uint8_t* src, size_t count) {
+    VEC deint[3][3];
+    for (int c = 0; c < 3; c++) {
+        for (int k = 0; k < 3; k++) deint[c][k] = VEC_MASK(simd_deinterleave_masks[c][k]);
+    }
+
+    size_t i = 0;
+    for (; i + GROUP_PIXELS <= count; i += GROUP_PIXELS, src += 3 * GROUP_PIXELS) {
+        VEC v0 = VEC_LOAD3(src, 0), v1 = VEC_LOAD3(src, 1), v2 = VEC_LOAD3(src, 2);
+        VEC_STOREU(c0 + i, ISA_DEINTERLEAVE(0, v0, v1, v2));
+        VEC_STOREU(c1 + i, ISA_DEINTERLEAVE(1, v0, v1, v2));
+        VEC_STOREU(c2 + i, ISA_DEINTERLEAVE(2, v0, v1, v2));
+    }
+    scalar_split3(c0 + i, c1 + i, c2 + i, src, count - i);
+}
+
+__attribute__((target(ISA_TARGET)))
+static void ISA_FN(merge3)(uint8_t* dst, const uint8_t* c0, const uint8_t* c1, const uint8_t* c2, size_t count) {
+    VEC inter[3][3];
+    for (int k = 0; k < 3; k++) {
+        for (int c = 0; c < 3; c++) inter[k][c] = VEC_MASK(simd_interleave_masks[k][c]);
+    }
+
+    size_t i = 0;
+    for (; i + GROUP_PIXELS <= count; i += GROUP_PIXELS, dst += 3 * GROUP_PIXELS) {
+        VEC v0 = VEC_LOADU(c0 + i), v1 = VEC_LOADU(c1 + i), v2 = VEC_LOADU(c2 + i);
+        ISA_INTERLEAVE(dst, v0, v1, v2);
+    }
+    scalar_merge3(dst, c0 + i, c1 + i, c2 + i, count - i);
+}
+
+__attribute__((target(ISA_TARGET)))
+static void ISA_FN(average2x2)(uint8_t* dst, const uint8_t* row0, const uint8_t* row1, size_t count) {
+    const VEC ones = VEC_SET1_8(1), two = VEC_SET1_16(2);
+
+    /* Horizontal pair sums in 16 bits, then the two rows, then the rounded quarter */
+    size_t i = 0;
+    for (; i + VEC_BYTES <= count; i += VEC_BYTES) {
+        const uint8_t* a = row0 + 2 * i;
+        const uint8_t* b = row1 + 2 * i;
+        VEC lo = VEC_ADD16(VEC_MADDUBS(VEC_LOADU(a), ones), VEC_MADDUBS(VEC_LOADU(b), ones));
+        VEC hi = VEC_ADD16(VEC_MADDUBS(VEC_LOADU(a + VEC_BYTES), ones), VEC_MADDUBS(VEC_LOADU(b + VEC_BYTES), ones));
+        VEC_STOREU(dst + i, VEC_PACKUS16_LINEAR(VEC_SRLI16(VEC_ADD16(lo, two), 2), VEC_SRLI16(VEC_ADD16(hi, two), 2)));
+    }
+    scalar_average2x2(dst + i, row0 + 2 * i, row1 + 2 * i, count - i);
+}
+
+#undef ISA_INTERLEAVE
+#undef ISA_DEINTERLEAVE
+#undef ISA_REVERSE_GROUP
+#undef GROUP_PIXELS
+#undef ISA_FN
+#undef ISA_FN1
+#undef ISA_FN2
+
@@ -0,0 +1,658 @@
+/**
+ * @file bmap_tables.c
+ * @brief Precomputed lookup tables shared by the library.
+ * * The tables are plain static data so they live in .rodata, are shared
+ * between processes mapping the library and cost nothing at startup or on the
+ * first call. include/bmap_tables.hpp generates the same values with constexpr
+ * code, and the C++ test suite checks that both agree.
+ * @author Arda Aksu
+ * @date 2026
+ * @see bmap.h for the table declarations.
+ */
+
+#include "bmap.h"
+
+/*
+ * sRGB decode: entry i = round(65535 * lin(i / 255)), where
+ * lin(c) = c / 12.92 for c <= 0.04045, ((c + 0.055) / 1.055)^2.4 otherwise.
+ */
+const uint16_t bmp_srgb_to_linear16[256] = {
+        0,    20,    40,    60,    80,    99,   119,   139,   159,   179,   199,   219,
+      241,   264,   288,   313,   340,   367,   396,   427,   458,   491,   526,   562,
+      599,   637,   677,   718,   761,   805,   851,   898,   947,   997,  1048,  1101,
+     1156,  1212,  1270,  1330,  1391,  1453,  1517,  1583,  1651,  1720,  1790,  1863,
+     1937,  2013,  2090,  2170,  2250,  2333,  2418,  2504,  2592,  2681,  2773,  2866,
+     2961,  3058,  3157,  3258,  3360,  3464,  3570,  3678,  3788,  3900,  4014,  4129,
+     4247,  4366,  4488,  4611,  4736,  4864,  4993,  5124,  5257,  5392,  5530,  5669,
+     5810,  5953,  6099,  6246,  6395,  6547,  6700,  6856,  7014,  7174,  7335,  7500,
+     7666,  7834,  8004,  8177,  8352,  8528,  8708,  8889,  9072,  9258,  9445,  9635,
+     9828, 10022, 10219, 10417, 10619, 10822, 11028, 11235, 11446, 11658, 11873, 12090,
+    12309, 12530, 12754, 12980, 13209, 13440, 13673, 13909, 14146, 14387, 14629, 14874,
+    15122, 15371, 15623, 15878, 16135, 16394, 16656, 16920, 17187, 17456, 17727, 18001,
+    18277, 18556, 18837, 19121, 19407, 19696, 19987, 20281, 20577, 20876, 21177, 21481,
+    21787, 22096, 22407, 22721, 23038, 23357, 23678, 24002, 24329, 24658, 24990, 25325,
+    25662, 26001, 26344, 26688, 27036, 27386, 27739, 28094, 28452, 28813, 29176, 29542,
+    29911, 30282, 30656, 31033, 31412, 31794, 32179, 32567, 32957, 33350, 33745, 34143,
+    34544, 34948, 35355, 35764, 36176, 36591, 37008, 37429, 37852, 38278, 38706, 39138,
+    39572, 40009, 40449, 40891, 41337, 41785, 42236, 42690, 43147, 43606, 44069, 44534,
+    45002, 45473, 45947, 46423, 46903, 47385, 47871, 48359, 48850, 49344, 49841, 50341,
+    50844, 51349, 51858, 52369, 52884, 53401, 53921, 54445, 54971, 55500, 56032, 56567,
+    57105, 57646, 58190, 58737, 59287, 59840, 60396, 60955, 61517, 62082, 62650, 63221,
+    63795, 64372, 64952, 65535
+};
+
+/*
+ * sRGB encode: entry j covers linear16 values j * 16 .. j * 16 + 15 and holds
+ * round(255 * enc(l)) at the bucket centre l = (j + 0.5) * 16 / 65535, where
+ * enc(l) = 12.92 * l for l <= 0.0031308, 1.055 * l^(1/2.4) - 0.055 otherwise.
+ * Index with linear16 >> 4. Decoding and re-encoding every 8-bit value is exact.
+ */
+const uint8_t bmp_linear12_to_srgb[4096] = {
+      0,   1,   2,   3,   4,   4,   5,   6,   7,   8,   8,   9,  10,  11,  12,  12,
+     13,  14,  14,  15,  16,  16,  17,  17,  18,  18,  19,  19,  20,  20,  21,  21,
+     22,  22,  23,  23,  24,  24,  24,  25,  25,  26,  26,  26,  27,  27,  28,  28,
+     28,  29,  29,  29,  30,  30,  30,  31,  31,  31,  32,  32,  32,  33,  33,  33,
+     34,  34,  34,  35,  35,  35,  35,  36,  36,  36,  37,  37,  37,  37,  38,  38,
+     38,  39,  39,  39,  39,  40,  40,  40,  40,  41,  41,  41,  41,  42,  42,  42,
+     42,  43,  43,  43,  43,  44,  44,  44,  44,  45,  45,  45,  45,  45,  46,  46,
+     46,  46,  47,  47,  47,  47,  47,  48,  48,  48,  48,  49,  49,  49,  49,  49,
+     50,  50,  50,  50,  50,  51,  51,  51,  51,  51,  52,  52,  52,  52,  52,  53,
+     53,  53,  53,  53,  54,  54,  54,  54,  54,  54,  55,  55,  55,  55,  55,  56,
+     56,  56,  56,  56,  56,  57,  57,  57,  57,  57,  58,  58,  58,  58,  58,  58,
+     59,  59,  59,  59,  59,  59,  60,  60,  60,  60,  60,  60,  61,  61,  61,  61,
+     61,  61,  62,  62,  62,  62,  62,  62,  63,  63,  63,  63,  63,  63,  63,  64,
+     64,  64,  64,  64,  64,  65,  65,  65,  65,  65,  65,  65,  66,  66,  66,  66,
+     66,  66,  66,  67,  67,  67,  67,  67,  67,  68,  68,  68,  68,  68,  68,  68,
+     69,  69,  69,  69,  69,  69,  69,  70,  70,  70,  70,  70,  70,  70,  71,  71,
+     71,  71,  71,  71,  71,  71,  72,  72,  72,  72,  72,  72,  72,  73,  73,  73,
+     73,  73,  73,  73,  73,  74,  74,  74,  74,  74,  74,  74,  75,  75,  75,  75,
+     75,  75,  75,  75,  76,  76,  76,  76,  76,  76,  76,  76,  77,  77,  77,  77,
+     77,  77,  77,  77,  78,  78,  78,  78,  78,  78,  78,  78,  79,  79,  79,  79,
+     79,  79,  79,  79,  80,  80,  80,  80,  80,  80,  80,  80,  80,  81,  81,  81,
+     81,  81,  81,  81,  81,  82,  82,  82,  82,  82,  82,  82,  82,  82,  83,  83,
+     83,  83,  83,  83,  83,  83,  83,  84,  84,  84,  84,  84,  84,  84,  84,  84,
+     85,  85,  85,  85,  85,  85,  85,  85,  85,  86,  86,  86,  86,  86,  86,  86,
+     86,  86,  87,  87,  87,  87,  87,  87,  87,  87,  87,  88,  88,  88,  88,  88,
+     88,  88,  88,  88,  89,  89,  89,  89,  89,  89,  89,  89,  89,  89,  90,  90,
+     90,  90,  90,  90,  90,  90,  90,  90,  91,  91,  91,  91,  91,  91,  91,  91,
+     91,  92,  92,  92,  92,  92,  92,  92,  92,  92,  92,  93,  93,  93,  93,  93,
+     93,  93,  93,  93,  93,  94,  94,  94,  94,  94,  94,  94,  94,  94,  94,  94,
+     95,  95,  95,  95,  95,  95,  95,  95,  95,  95,  96,  96,  96,  96,  96,  96,
+     96,  96,  96,  96,  97,  97,  97,  97,  97,  97,  97,  97,  97,  97,  97,  98,
+     98,  98,  98,  98,  98,  98,  98,  98,  98,  98,  99,  99,  99,  99,  99,  99,
+     99,  99,  99,  99,  99, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 101,
+    101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 102, 102, 102, 102, 102,
+    102, 102, 102, 102, 102, 102, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103,
+    103, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 105, 105, 105,
+    105, 105, 105, 105, 105, 105, 105, 105, 106, 106, 106, 106, 106, 106, 106, 106,
+    106, 106, 106, 106, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107,
+    108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 109, 109, 109, 109,
+    109, 109, 109, 109, 109, 109, 109, 109, 109, 110, 110, 110, 110, 110, 110, 110,
+    110, 110, 110, 110, 110, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111,
+    111, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 113, 113,
+    113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 114, 114, 114, 114, 114,
+    114, 114, 114, 114, 114, 114, 114, 114, 115, 115, 115, 115, 115, 115, 115, 115,
+    115, 115, 115, 115, 115, 116, 116, 116, 116, 116, 116, 116, 116, 116, 116, 116,
+    116, 116, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117, 118,
+    118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 119, 119, 119,
+    119, 119, 119, 119, 119, 119, 119, 119, 119, 119, 120, 120, 120, 120, 120, 120,
+    120, 120, 120, 120, 120, 120, 120, 120, 121, 121, 121, 121, 121, 121, 121, 121,
+    121, 121, 121, 121, 121, 121, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122,
+    122, 122, 122, 122, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123,
+    123, 123, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124,
+    124, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 126,
+    126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 127, 127,
+    127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 129, 129, 129, 129,
+    129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 130, 130, 130, 130, 130,
+    130, 130, 130, 130, 130, 130, 130, 130, 130, 130, 131, 131, 131, 131, 131, 131,
+    131, 131, 131, 131, 131, 131, 131, 131, 131, 132, 132, 132, 132, 132, 132, 132,
+    132, 132, 132, 132, 132, 132, 132, 132, 132, 133, 133, 133, 133, 133, 133, 133,
+    133, 133, 133, 133, 133, 133, 133, 133, 133, 134, 134, 134, 134, 134, 134, 134,
+    134, 134, 134, 134, 134, 134, 134, 134, 135, 135, 135, 135, 135, 135, 135, 135,
+    135, 135, 135, 135, 135, 135, 135, 135, 136, 136, 136, 136, 136, 136, 136, 136,
+    136, 136, 136, 136, 136, 136, 136, 136, 136, 137, 137, 137, 137, 137, 137, 137,
+    137, 137, 137, 137, 137, 137, 137, 137, 137, 138, 138, 138, 138, 138, 138, 138,
+    138, 138, 138, 138, 138, 138, 138, 138, 138, 139, 139, 139, 139, 139, 139, 139,
+    139, 139, 139, 139, 139, 139, 139, 139, 139, 139, 140, 140, 140, 140, 140, 140,
+    140, 140, 140, 140, 140, 140, 140, 140, 140, 140, 140, 141, 141, 141, 141, 141,
+    141, 141, 141, 141, 141, 141, 141, 141, 141, 141, 141, 142, 142, 142, 142, 142,
+    142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 143, 143, 143, 143,
+    143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 144, 144,
+    144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 145,
+    145, 145, 145, 145, 145, 145, 145, 145, 145, 145, 145, 145, 145, 145, 145, 145,
+    145, 146, 146, 146, 146, 146, 146, 146, 146, 146, 146, 146, 146, 146, 146, 146,
+    146, 146, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147,
+    147, 147, 147, 147, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148,
+    148, 148, 148, 148, 148, 148, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149,
+    149, 149, 149, 149, 149, 149, 149, 149, 150, 150, 150, 150, 150, 150, 150, 150,
+    150, 150, 150, 150, 150, 150, 150, 150, 150, 150, 151, 151, 151, 151, 151, 151,
+    151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 152, 152, 152,
+    152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 153,
+    153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153,
+    153, 153, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
+    154, 154, 154, 154, 154, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+    155, 155, 155, 155, 155, 155, 155, 155, 156, 156, 156, 156, 156, 156, 156, 156,
+    156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 157, 157, 157, 157, 157,
+    157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 158,
+    158, 158, 158, 158, 158, 158, 158, 158, 158, 158, 158, 158, 158, 158, 158, 158,
+    158, 158, 159, 159, 159, 159, 159, 159, 159, 159, 159, 159, 159, 159, 159, 159,
+    159, 159, 159, 159, 159, 159, 160, 160, 160, 160, 160, 160, 160, 160, 160, 160,
+    160, 160, 160, 160, 160, 160, 160, 160, 160, 160, 161, 161, 161, 161, 161, 161,
+    161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 162, 162,
+    162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162,
+    162, 162, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163,
+    163, 163, 163, 163, 163, 163, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164,
+    164, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164, 165, 165, 165, 165, 165,
+    165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 166,
+    166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166,
+    166, 166, 166, 166, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167,
+    167, 167, 167, 167, 167, 167, 167, 167, 167, 168, 168, 168, 168, 168, 168, 168,
+    168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 169, 169,
+    169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169,
+    169, 169, 169, 169, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+    170, 170, 170, 170, 170, 170, 170, 170, 170, 171, 171, 171, 171, 171, 171, 171,
+    171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 172,
+    172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172,
+    172, 172, 172, 172, 172, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+    173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 174, 174, 174, 174, 174,
+    174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
+    174, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175,
+    175, 175, 175, 175, 175, 175, 175, 176, 176, 176, 176, 176, 176, 176, 176, 176,
+    176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 177, 177,
+    177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177,
+    177, 177, 177, 177, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178,
+    178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 179, 179, 179, 179, 179,
+    179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179,
+    179, 179, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180,
+    180, 180, 180, 180, 180, 180, 180, 180, 180, 181, 181, 181, 181, 181, 181, 181,
+    181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181,
+    182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182,
+    182, 182, 182, 182, 182, 182, 182, 182, 183, 183, 183, 183, 183, 183, 183, 183,
+    183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 184,
+    184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184,
+    184, 184, 184, 184, 184, 184, 184, 185, 185, 185, 185, 185, 185, 185, 185, 185,
+    185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 186,
+    186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186,
+    186, 186, 186, 186, 186, 186, 186, 187, 187, 187, 187, 187, 187, 187, 187, 187,
+    187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187,
+    188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188,
+    188, 188, 188, 188, 188, 188, 188, 188, 189, 189, 189, 189, 189, 189, 189, 189,
+    189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189,
+    189, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190,
+    190, 190, 190, 190, 190, 190, 190, 190, 190, 191, 191, 191, 191, 191, 191, 191,
+    191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191,
+    191, 191, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192,
+    192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 193, 193, 193, 193,
+    193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193,
+    193, 193, 193, 193, 193, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194,
+    194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 195, 195,
+    195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195,
+    195, 195, 195, 195, 195, 195, 195, 195, 196, 196, 196, 196, 196, 196, 196, 196,
+    196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196,
+    196, 196, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197,
+    197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 198, 198, 198, 198,
+    198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198,
+    198, 198, 198, 198, 198, 198, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199,
+    199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199,
+    200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200,
+    200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 201, 201, 201, 201, 201,
+    201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201,
+    201, 201, 201, 201, 201, 201, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202,
+    202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202,
+    202, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203,
+    203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 204, 204, 204, 204,
+    204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
+    204, 204, 204, 204, 204, 204, 204, 205, 205, 205, 205, 205, 205, 205, 205, 205,
+    205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205,
+    205, 205, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206,
+    206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 207, 207,
+    207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207,
+    207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 208, 208, 208, 208, 208, 208,
+    208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208,
+    208, 208, 208, 208, 208, 208, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209,
+    209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209,
+    209, 209, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+    210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 211, 211,
+    211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211,
+    211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 212, 212, 212, 212, 212, 212,
+    212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212,
+    212, 212, 212, 212, 212, 212, 212, 213, 213, 213, 213, 213, 213, 213, 213, 213,
+    213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213,
+    213, 213, 213, 213, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214,
+    214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214,
+    214, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215,
+    215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 216, 216,
+    216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216,
+    216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 217, 217, 217, 217, 217,
+    217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217,
+    217, 217, 217, 217, 217, 217, 217, 217, 217, 218, 218, 218, 218, 218, 218, 218,
+    218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218,
+    218, 218, 218, 218, 218, 218, 218, 219, 219, 219, 219, 219, 219, 219, 219, 219,
+    219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219,
+    219, 219, 219, 219, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220,
+    220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220,
+    220, 220, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221,
+    221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221,
+    221, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222,
+    222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 223,
+    223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223,
+    223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 224, 224,
+    224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224,
+    224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 225, 225, 225,
+    225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225,
+    225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 226, 226, 226, 226,
+    226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226,
+    226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 227, 227, 227, 227, 227,
+    227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227,
+    227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 228, 228, 228, 228, 228, 228,
+    228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228,
+    228, 228, 228, 228, 228, 228, 228, 228, 228, 229, 229, 229, 229, 229, 229, 229,
+    229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229,
+    229, 229, 229, 229, 229, 229, 229, 229, 229, 230, 230, 230, 230, 230, 230, 230,
+    230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230,
+    230, 230, 230, 230, 230, 230, 230, 230, 230, 231, 231, 231, 231, 231, 231, 231,
+    231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231,
+    231, 231, 231, 231, 231, 231, 231, 231, 231, 232, 232, 232, 232, 232, 232, 232,
+    232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232,
+    232, 232, 232, 232, 232, 232, 232, 232, 232, 233, 233, 233, 233, 233, 233, 233,
+    233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233,
+    233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 234, 234, 234, 234, 234, 234,
+    234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234,
+    234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 235, 235, 235, 235, 235, 235,
+    235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235,
+    235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 236, 236, 236, 236, 236,
+    236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236,
+    236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 237, 237, 237, 237,
+    237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237,
+    237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 238, 238, 238,
+    238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238,
+    238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 239,
+    239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239,
+    239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239,
+    240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+    240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+    240, 240, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241,
+    241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241,
+    241, 241, 241, 241, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242,
+    242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242,
+    242, 242, 242, 242, 242, 242, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243,
+    243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243,
+    243, 243, 243, 243, 243, 243, 243, 243, 244, 244, 244, 244, 244, 244, 244, 244,
+    244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244,
+    244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 245, 245, 245, 245, 245,
+    245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245,
+    245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 246, 246, 246,
+    246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246,
+    246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246,
+    247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247,
+    247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247,
+    247, 247, 247, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248,
+    248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248,
+    248, 248, 248, 248, 248, 248, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249,
+    249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249,
+    249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 250, 250, 250, 250, 250, 250,
+    250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250,
+    250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 251, 251, 251,
+    251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+    251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+    251, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252,
+    252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252,
+    252, 252, 252, 252, 252, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253,
+    253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253,
+    253, 253, 253, 253, 253, 253, 253, 253, 253, 254, 254, 254, 254, 254, 254, 254,
+    254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254,
+    254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
+};
+
+/*
+ * CIELAB companding: entry j covers t16 values j * 16 .. j * 16 + 15 and holds
+ * round(65535 * f(t)) at the bucket centre t = (j + 0.5) * 16 / 65535, where
+ * f(t) = t^(1/3) for t > (6/29)^3, t / (3 * (6/29)^2) + 4/29 otherwise.
+ * t is a white-normalized X, Y or Z in 16-bit linear light; index with t16 >> 4.
+ */
+const uint16_t bmp_lab_f16[4096] = {
+    9102, 9226, 9351, 9475, 9600, 9725, 9849, 9974, 10098, 10223, 10348, 10472,
+    10597, 10721, 10846, 10970, 11095, 11220, 11344, 11469, 11593, 11718, 11843, 11967,
+    12092, 12216, 12341, 12466, 12590, 12715, 12839, 12964, 13089, 13213, 13338, 13462,
+    13587, 13710, 13831, 13949, 14066, 14181, 14294, 14405, 14515, 14623, 14729, 14834,
+    14937, 15039, 15140, 15239, 15337, 15434, 15529, 15624, 15717, 15809, 15900, 15990,
+    16080, 16168, 16255, 16341, 16426, 16511, 16594, 16677, 16759, 16840, 16921, 17000,
+    17079, 17157, 17235, 17312, 17388, 17463, 17538, 17612, 17686, 17759, 17831, 17903,
+    17974, 18044, 18115, 18184, 18253, 18322, 18390, 18457, 18524, 18591, 18657, 18722,
+    18787, 18852, 18916, 18980, 19043, 19106, 19169, 19231, 19293, 19354, 19415, 19476,
+    19536, 19596, 19655, 19714, 19773, 19831, 19890, 19947, 20005, 20062, 20118, 20175,
+    20231, 20287, 20342, 20398, 20452, 20507, 20561, 20615, 20669, 20723, 20776, 20829,
+    20881, 20934, 20986, 21038, 21090, 21141, 21192, 21243, 21294, 21344, 21394, 21444,
+    21494, 21543, 21592, 21641, 21690, 21739, 21787, 21835, 21883, 21931, 21979, 22026,
+    22073, 22120, 22167, 22213, 22259, 22306, 22351, 22397, 22443, 22488, 22533, 22578,
+    22623, 22668, 22712, 22757, 22801, 22845, 22889, 22932, 22976, 23019, 23062, 23105,
+    23148, 23191, 23233, 23276, 23318, 23360, 23402, 23444, 23485, 23527, 23568, 23609,
+    23650, 23691, 23732, 23772, 23813, 23853, 23893, 23933, 23973, 24013, 24053, 24092,
+    24132, 24171, 24210, 24249, 24288, 24327, 24365, 24404, 24442, 24481, 24519, 24557,
+    24595, 24633, 24670, 24708, 24745, 24783, 24820, 24857, 24894, 24931, 24968, 25004,
+    25041, 25077, 25114, 25150, 25186, 25222, 25258, 25294, 25330, 25365, 25401, 25437,
+    25472, 25507, 25542, 25577, 25612, 25647, 25682, 25717, 25751, 25786, 25820, 25854,
+    25889, 25923, 25957, 25991, 26025, 26058, 26092, 26126, 26159, 26193, 26226, 26259,
+    26292, 26326, 26359, 26391, 26424, 26457, 26490, 26522, 26555, 26587, 26620, 26652,
+    26684, 26716, 26748, 26780, 26812, 26844, 26876, 26907, 26939, 26971, 27002, 27033,
+    27065, 27096, 27127, 27158, 27189, 27220, 27251, 27282, 27313, 27343, 27374, 27404,
+    27435, 27465, 27496, 27526, 27556, 27586, 27616, 27646, 27676, 27706, 27736, 27766,
+    27795, 27825, 27855, 27884, 27913, 27943, 27972, 28001, 28031, 28060, 28089, 28118,
+    28147, 28176, 28204, 28233, 28262, 28291, 28319, 28348, 28376, 28405, 28433, 28461,
+    28489, 28518, 28546, 28574, 28602, 28630, 28658, 28686, 28713, 28741, 28769, 28797,
+    28824, 28852, 28879, 28907, 28934, 28961, 28989, 29016, 29043, 29070, 29097, 29124,
+    29151, 29178, 29205, 29232, 29259, 29285, 29312, 29339, 29365, 29392, 29418, 29445,
+    29471, 29498, 29524, 29550, 29576, 29602, 29629, 29655, 29681, 29707, 29733, 29758,
+    29784, 29810, 29836, 29862, 29887, 29913, 29938, 29964, 29989, 30015, 30040, 30066,
+    30091, 30116, 30142, 30167, 30192, 30217, 30242, 30267, 30292, 30317, 30342, 30367,
+    30392, 30416, 30441, 30466, 30490, 30515, 30540, 30564, 30589, 30613, 30638, 30662,
+    30686, 30711, 30735, 30759, 30783, 30807, 30832, 30856, 30880, 30904, 30928, 30952,
+    30975, 30999, 31023, 31047, 31071, 31094, 31118, 31142, 31165, 31189, 31212, 31236,
+    31259, 31283, 31306, 31329, 31353, 31376, 31399, 31423, 31446, 31469, 31492, 31515,
+    31538, 31561, 31584, 31607, 31630, 31653, 31676, 31699, 31721, 31744, 31767, 31789,
+    31812, 31835, 31857, 31880, 31902, 31925, 31947, 31970, 31992, 32014, 32037, 32059,
+    32081, 32104, 32126, 32148, 32170, 32192, 32214, 32236, 32258, 32280, 32302, 32324,
+    32346, 32368, 32390, 32412, 32434, 32455, 32477, 32499, 32520, 32542, 32564, 32585,
+    32607, 32628, 32650, 32671, 32693, 32714, 32736, 32757, 32778, 32800, 32821, 32842,
+    32863, 32885, 32906, 32927, 32948, 32969, 32990, 33011, 33032, 33053, 33074, 33095,
+    33116, 33137, 33158, 33178, 33199, 33220, 33241, 33262, 33282, 33303, 33324, 33344,
+    33365, 33385, 33406, 33426, 33447, 33467, 33488, 33508, 33529, 33549, 33569, 33590,
+    33610, 33630, 33650, 33671, 33691, 33711, 33731, 33751, 33771, 33791, 33811, 33831,
+    33851, 33871, 33891, 33911, 33931, 33951, 33971, 33991, 34011, 34030, 34050, 34070,
+    34090, 34109, 34129, 34149, 34168, 34188, 34207, 34227, 34247, 34266, 34286, 34305,
+    34325, 34344, 34363, 34383, 34402, 34421, 34441, 34460, 34479, 34499, 34518, 34537,
+    34556, 34575, 34595, 34614, 34633, 34652, 34671, 34690, 34709, 34728, 34747, 34766,
+    34785, 34804, 34823, 34842, 34860, 34879, 34898, 34917, 34936, 34954, 34973, 34992,
+    35011, 35029, 35048, 35067, 35085, 35104, 35122, 35141, 35159, 35178, 35196, 35215,
+    35233, 35252, 35270, 35289, 35307, 35325, 35344, 35362, 35380, 35399, 35417, 35435,
+    35453, 35472, 35490, 35508, 35526, 35544, 35562, 35581, 35599, 35617, 35635, 35653,
+    35671, 35689, 35707, 35725, 35743, 35761, 35779, 35796, 35814, 35832, 35850, 35868,
+    35886, 35903, 35921, 35939, 35957, 35974, 35992, 36010, 36027, 36045, 36063, 36080,
+    36098, 36115, 36133, 36150, 36168, 36185, 36203, 36220, 36238, 36255, 36273, 36290,
+    36307, 36325, 36342, 36360, 36377, 36394, 36411, 36429, 36446, 36463, 36480, 36498,
+    36515, 36532, 36549, 36566, 36583, 36600, 36618, 36635, 36652, 36669, 36686, 36703,
+    36720, 36737, 36754, 36771, 36788, 36805, 36821, 36838, 36855, 36872, 36889, 36906,
+    36923, 36939, 36956, 36973, 36990, 37006, 37023, 37040, 37056, 37073, 37090, 37106,
+    37123, 37140, 37156, 37173, 37189, 37206, 37223, 37239, 37256, 37272, 37289, 37305,
+    37321, 37338, 37354, 37371, 37387, 37403, 37420, 37436, 37453, 37469, 37485, 37501,
+    37518, 37534, 37550, 37567, 37583, 37599, 37615, 37631, 37647, 37664, 37680, 37696,
+    37712, 37728, 37744, 37760, 37776, 37792, 37808, 37824, 37840, 37856, 37872, 37888,
+    37904, 37920, 37936, 37952, 37968, 37984, 38000, 38016, 38031, 38047, 38063, 38079,
+    38095, 38110, 38126, 38142, 38158, 38173, 38189, 38205, 38221, 38236, 38252, 38268,
+    38283, 38299, 38314, 38330, 38346, 38361, 38377, 38392, 38408, 38423, 38439, 38454,
+    38470, 38485, 38501, 38516, 38532, 38547, 38562, 38578, 38593, 38609, 38624, 38639,
+    38655, 38670, 38685, 38701, 38716, 38731, 38746, 38762, 38777, 38792, 38807, 38823,
+    38838, 38853, 38868, 38883, 38898, 38913, 38929, 38944, 38959, 38974, 38989, 39004,
+    39019, 39034, 39049, 39064, 39079, 39094, 39109, 39124, 39139, 39154, 39169, 39184,
+    39199, 39214, 39229, 39243, 39258, 39273, 39288, 39303, 39318, 39333, 39347, 39362,
+    39377, 39392, 39406, 39421, 39436, 39451, 39465, 39480, 39495, 39509, 39524, 39539,
+    39553, 39568, 39583, 39597, 39612, 39626, 39641, 39656, 39670, 39685, 39699, 39714,
+    39728, 39743, 39757, 39772, 39786, 39801, 39815, 39830, 39844, 39858, 39873, 39887,
+    39902, 39916, 39930, 39945, 39959, 39973, 39988, 40002, 40016, 40031, 40045, 40059,
+    40074, 40088, 40102, 40116, 40131, 40145, 40159, 40173, 40187, 40202, 40216, 40230,
+    40244, 40258, 40272, 40286, 40301, 40315, 40329, 40343, 40357, 40371, 40385, 40399,
+    40413, 40427, 40441, 40455, 40469, 40483, 40497, 40511, 40525, 40539, 40553, 40567,
+    40581, 40595, 40608, 40622, 40636, 40650, 40664, 40678, 40692, 40705, 40719, 40733,
+    40747, 40761, 40774, 40788, 40802, 40816, 40829, 40843, 40857, 40871, 40884, 40898,
+    40912, 40925, 40939, 40953, 40966, 40980, 40994, 41007, 41021, 41035, 41048, 41062,
+    41075, 41089, 41102, 41116, 41130, 41143, 41157, 41170, 41184, 41197, 41211, 41224,
+    41238, 41251, 41265, 41278, 41291, 41305, 41318, 41332, 41345, 41358, 41372, 41385,
+    41399, 41412, 41425, 41439, 41452, 41465, 41479, 41492, 41505, 41519, 41532, 41545,
+    41558, 41572, 41585, 41598, 41611, 41625, 41638, 41651, 41664, 41677, 41691, 41704,
+    41717, 41730, 41743, 41756, 41769, 41783, 41796, 41809, 41822, 41835, 41848, 41861,
+    41874, 41887, 41900, 41913, 41926, 41939, 41952, 41965, 41978, 41991, 42004, 42017,
+    42030, 42043, 42056, 42069, 42082, 42095, 42108, 42121, 42134, 42147, 42160, 42173,
+    42185, 42198, 42211, 42224, 42237, 42250, 42263, 42275, 42288, 42301, 42314, 42327,
+    42339, 42352, 42365, 42378, 42390, 42403, 42416, 42429, 42441, 42454, 42467, 42479,
+    42492, 42505, 42517, 42530, 42543, 42555, 42568, 42581, 42593, 42606, 42619, 42631,
+    42644, 42656, 42669, 42682, 42694, 42707, 42719, 42732, 42744, 42757, 42769, 42782,
+    42794, 42807, 42819, 42832, 42844, 42857, 42869, 42882, 42894, 42907, 42919, 42932,
+    42944, 42956, 42969, 42981, 42994, 43006, 43018, 43031, 43043, 43055, 43068, 43080,
+    43093, 43105, 43117, 43130, 43142, 43154, 43166, 43179, 43191, 43203, 43216, 43228,
+    43240, 43252, 43265, 43277, 43289, 43301, 43313, 43326, 43338, 43350, 43362, 43374,
+    43387, 43399, 43411, 43423, 43435, 43447, 43459, 43472, 43484, 43496, 43508, 43520,
+    43532, 43544, 43556, 43568, 43580, 43592, 43604, 43617, 43629, 43641, 43653, 43665,
+    43677, 43689, 43701, 43713, 43725, 43737, 43749, 43761, 43773, 43784, 43796, 43808,
+    43820, 43832, 43844, 43856, 43868, 43880, 43892, 43904, 43916, 43927, 43939, 43951,
+    43963, 43975, 43987, 43998, 44010, 44022, 44034, 44046, 44058, 44069, 44081, 44093,
+    44105, 44116, 44128, 44140, 44152, 44164, 44175, 44187, 44199, 44210, 44222, 44234,
+    44246, 44257, 44269, 44281, 44292, 44304, 44316, 44327, 44339, 44351, 44362, 44374,
+    44386, 44397, 44409, 44420, 44432, 44444, 44455, 44467, 44478, 44490, 44502, 44513,
+    44525, 44536, 44548, 44559, 44571, 44582, 44594, 44605, 44617, 44628, 44640, 44651,
+    44663, 44674, 44686, 44697, 44709, 44720, 44732, 44743, 44755, 44766, 44777, 44789,
+    44800, 44812, 44823, 44834, 44846, 44857, 44869, 44880, 44891, 44903, 44914, 44925,
+    44937, 44948, 44959, 44971, 44982, 44993, 45005, 45016, 45027, 45039, 45050, 45061,
+    45072, 45084, 45095, 45106, 45118, 45129, 45140, 45151, 45162, 45174, 45185, 45196,
+    45207, 45219, 45230, 45241, 45252, 45263, 45275, 45286, 45297, 45308, 45319, 45330,
+    45341, 45353, 45364, 45375, 45386, 45397, 45408, 45419, 45430, 45442, 45453, 45464,
+    45475, 45486, 45497, 45508, 45519, 45530, 45541, 45552, 45563, 45574, 45585, 45596,
+    45607, 45618, 45629, 45640, 45651, 45662, 45673, 45684, 45695, 45706, 45717, 45728,
+    45739, 45750, 45761, 45772, 45783, 45794, 45805, 45816, 45826, 45837, 45848, 45859,
+    45870, 45881, 45892, 45903, 45914, 45924, 45935, 45946, 45957, 45968, 45979, 45990,
+    46000, 46011, 46022, 46033, 46044, 46054, 46065, 46076, 46087, 46098, 46108, 46119,
+    46130, 46141, 46151, 46162, 46173, 46184, 46194, 46205, 46216, 46227, 46237, 46248,
+    46259, 46269, 46280, 46291, 46301, 46312, 46323, 46333, 46344, 46355, 46365, 46376,
+    46387, 46397, 46408, 46419, 46429, 46440, 46451, 46461, 46472, 46482, 46493, 46504,
+    46514, 46525, 46535, 46546, 46556, 46567, 46578, 46588, 46599, 46609, 46620, 46630,
+    46641, 46651, 46662, 46672, 46683, 46693, 46704, 46714, 46725, 46735, 46746, 46756,
+    46767, 46777, 46788, 46798, 46809, 46819, 46830, 46840, 46851, 46861, 46871, 46882,
+    46892, 46903, 46913, 46923, 46934, 46944, 46955, 46965, 46975, 46986, 46996, 47007,
+    47017, 47027, 47038, 47048, 47058, 47069, 47079, 47089, 47100, 47110, 47120, 47131,
+    47141, 47151, 47162, 47172, 47182, 47192, 47203, 47213, 47223, 47233, 47244, 47254,
+    47264, 47275, 47285, 47295, 47305, 47315, 47326, 47336, 47346, 47356, 47367, 47377,
+    47387, 47397, 47407, 47418, 47428, 47438, 47448, 47458, 47468, 47479, 47489, 47499,
+    47509, 47519, 47529, 47540, 47550, 47560, 47570, 47580, 47590, 47600, 47610, 47620,
+    47631, 47641, 47651, 47661, 47671, 47681, 47691, 47701, 47711, 47721, 47731, 47741,
+    47751, 47761, 47772, 47782, 47792, 47802, 47812, 47822, 47832, 47842, 47852, 47862,
+    47872, 47882, 47892, 47902, 47912, 47922, 47932, 47942, 47951, 47961, 47971, 47981,
+    47991, 48001, 48011, 48021, 48031, 48041, 48051, 48061, 48071, 48081, 48091, 48100,
+    48110, 48120, 48130, 48140, 48150, 48160, 48170, 48180, 48189, 48199, 48209, 48219,
+    48229, 48239, 48249, 48258, 48268, 48278, 48288, 48298, 48307, 48317, 48327, 48337,
+    48347, 48356, 48366, 48376, 48386, 48396, 48405, 48415, 48425, 48435, 48444, 48454,
+    48464, 48474, 48484, 48493, 48503, 48513, 48522, 48532, 48542, 48552, 48561, 48571,
+    48581, 48590, 48600, 48610, 48620, 48629, 48639, 48649, 48658, 48668, 48678, 48687,
+    48697, 48707, 48716, 48726, 48736, 48745, 48755, 48764, 48774, 48784, 48793, 48803,
+    48813, 48822, 48832, 48841, 48851, 48861, 48870, 48880, 48889, 48899, 48909, 48918,
+    48928, 48937, 48947, 48956, 48966, 48975, 48985, 48995, 49004, 49014, 49023, 49033,
+    49042, 49052, 49061, 49071, 49080, 49090, 49099, 49109, 49118, 49128, 49137, 49147,
+    49156, 49166, 49175, 49185, 49194, 49204, 49213, 49223, 49232, 49241, 49251, 49260,
+    49270, 49279, 49289, 49298, 49307, 49317, 49326, 49336, 49345, 49355, 49364, 49373,
+    49383, 49392, 49401, 49411, 49420, 49430, 49439, 49448, 49458, 49467, 49476, 49486,
+    49495, 49505, 49514, 49523, 49533, 49542, 49551, 49561, 49570, 49579, 49588, 49598,
+    49607, 49616, 49626, 49635, 49644, 49654, 49663, 49672, 49681, 49691, 49700, 49709,
+    49719, 49728, 49737, 49746, 49756, 49765, 49774, 49783, 49793, 49802, 49811, 49820,
+    49830, 49839, 49848, 49857, 49866, 49876, 49885, 49894, 49903, 49912, 49922, 49931,
+    49940, 49949, 49958, 49967, 49977, 49986, 49995, 50004, 50013, 50022, 50032, 50041,
+    50050, 50059, 50068, 50077, 50086, 50096, 50105, 50114, 50123, 50132, 50141, 50150,
+    50159, 50169, 50178, 50187, 50196, 50205, 50214, 50223, 50232, 50241, 50250, 50259,
+    50268, 50277, 50287, 50296, 50305, 50314, 50323, 50332, 50341, 50350, 50359, 50368,
+    50377, 50386, 50395, 50404, 50413, 50422, 50431, 50440, 50449, 50458, 50467, 50476,
+    50485, 50494, 50503, 50512, 50521, 50530, 50539, 50548, 50557, 50566, 50575, 50584,
+    50593, 50602, 50611, 50619, 50628, 50637, 50646, 50655, 50664, 50673, 50682, 50691,
+    50700, 50709, 50718, 50727, 50735, 50744, 50753, 50762, 50771, 50780, 50789, 50798,
+    50807, 50815, 50824, 50833, 50842, 50851, 50860, 50869, 50877, 50886, 50895, 50904,
+    50913, 50922, 50930, 50939, 50948, 50957, 50966, 50975, 50983, 50992, 51001, 51010,
+    51019, 51027, 51036, 51045, 51054, 51063, 51071, 51080, 51089, 51098, 51106, 51115,
+    51124, 51133, 51142, 51150, 51159, 51168, 51177, 51185, 51194, 51203, 51211, 51220,
+    51229, 51238, 51246, 51255, 51264, 51273, 51281, 51290, 51299, 51307, 51316, 51325,
+    51333, 51342, 51351, 51360, 51368, 51377, 51386, 51394, 51403, 51412, 51420, 51429,
+    51438, 51446, 51455, 51464, 51472, 51481, 51489, 51498, 51507, 51515, 51524, 51533,
+    51541, 51550, 51558, 51567, 51576, 51584, 51593, 51602, 51610, 51619, 51627, 51636,
+    51645, 51653, 51662, 51670, 51679, 51687, 51696, 51705, 51713, 51722, 51730, 51739,
+    51747, 51756, 51764, 51773, 51782, 51790, 51799, 51807, 51816, 51824, 51833, 51841,
+    51850, 51858, 51867, 51875, 51884, 51892, 51901, 51909, 51918, 51926, 51935, 51943,
+    51952, 51960, 51969, 51977, 51986, 51994, 52003, 52011, 52020, 52028, 52037, 52045,
+    52053, 52062, 52070, 52079, 52087, 52096, 52104, 52113, 52121, 52129, 52138, 52146,
+    52155, 52163, 52172, 52180, 52188, 52197, 52205, 52214, 52222, 52230, 52239, 52247,
+    52256, 52264, 52272, 52281, 52289, 52298, 52306, 52314, 52323, 52331, 52339, 52348,
+    52356, 52364, 52373, 52381, 52389, 52398, 52406, 52414, 52423, 52431, 52439, 52448,
+    52456, 52464, 52473, 52481, 52489, 52498, 52506, 52514, 52523, 52531, 52539, 52548,
+    52556, 52564, 52572, 52581, 52589, 52597, 52606, 52614, 52622, 52630, 52639, 52647,
+    52655, 52663, 52672, 52680, 52688, 52696, 52705, 52713, 52721, 52729, 52738, 52746,
+    52754, 52762, 52771, 52779, 52787, 52795, 52803, 52812, 52820, 52828, 52836, 52845,
+    52853, 52861, 52869, 52877, 52885, 52894, 52902, 52910, 52918, 52926, 52935, 52943,
+    52951, 52959, 52967, 52975, 52984, 52992, 53000, 53008, 53016, 53024, 53033, 53041,
+    53049, 53057, 53065, 53073, 53081, 53089, 53098, 53106, 53114, 53122, 53130, 53138,
+    53146, 53154, 53162, 53171, 53179, 53187, 53195, 53203, 53211, 53219, 53227, 53235,
+    53243, 53251, 53260, 53268, 53276, 53284, 53292, 53300, 53308, 53316, 53324, 53332,
+    53340, 53348, 53356, 53364, 53372, 53380, 53388, 53396, 53405, 53413, 53421, 53429,
+    53437, 53445, 53453, 53461, 53469, 53477, 53485, 53493, 53501, 53509, 53517, 53525,
+    53533, 53541, 53549, 53557, 53565, 53573, 53581, 53589, 53597, 53605, 53613, 53621,
+    53628, 53636, 53644, 53652, 53660, 53668, 53676, 53684, 53692, 53700, 53708, 53716,
+    53724, 53732, 53740, 53748, 53756, 53764, 53771, 53779, 53787, 53795, 53803, 53811,
+    53819, 53827, 53835, 53843, 53851, 53858, 53866, 53874, 53882, 53890, 53898, 53906,
+    53914, 53922, 53929, 53937, 53945, 53953, 53961, 53969, 53977, 53984, 53992, 54000,
+    54008, 54016, 54024, 54032, 54039, 54047, 54055, 54063, 54071, 54079, 54086, 54094,
+    54102, 54110, 54118, 54126, 54133, 54141, 54149, 54157, 54165, 54172, 54180, 54188,
+    54196, 54204, 54211, 54219, 54227, 54235, 54243, 54250, 54258, 54266, 54274, 54282,
+    54289, 54297, 54305, 54313, 54320, 54328, 54336, 54344, 54351, 54359, 54367, 54375,
+    54382, 54390, 54398, 54406, 54413, 54421, 54429, 54437, 54444, 54452, 54460, 54467,
+    54475, 54483, 54491, 54498, 54506, 54514, 54521, 54529, 54537, 54545, 54552, 54560,
+    54568, 54575, 54583, 54591, 54598, 54606, 54614, 54621, 54629, 54637, 54644, 54652,
+    54660, 54667, 54675, 54683, 54690, 54698, 54706, 54713, 54721, 54729, 54736, 54744,
+    54752, 54759, 54767, 54775, 54782, 54790, 54797, 54805, 54813, 54820, 54828, 54836,
+    54843, 54851, 54858, 54866, 54874, 54881, 54889, 54896, 54904, 54912, 54919, 54927,
+    54934, 54942, 54950, 54957, 54965, 54972, 54980, 54988, 54995, 55003, 55010, 55018,
+    55025, 55033, 55040, 55048, 55056, 55063, 55071, 55078, 55086, 55093, 55101, 55108,
+    55116, 55124, 55131, 55139, 55146, 55154, 55161, 55169, 55176, 55184, 55191, 55199,
+    55206, 55214, 55221, 55229, 55236, 55244, 55251, 55259, 55266, 55274, 55281, 55289,
+    55296, 55304, 55311, 55319, 55326, 55334, 55341, 55349, 55356, 55364, 55371, 55379,
+    55386, 55394, 55401, 55409, 55416, 55423, 55431, 55438, 55446, 55453, 55461, 55468,
+    55476, 55483, 55490, 55498, 55505, 55513, 55520, 55528, 55535, 55542, 55550, 55557,
+    55565, 55572, 55580, 55587, 55594, 55602, 55609, 55617, 55624, 55631, 55639, 55646,
+    55654, 55661, 55668, 55676, 55683, 55691, 55698, 55705, 55713, 55720, 55727, 55735,
+    55742, 55750, 55757, 55764, 55772, 55779, 55786, 55794, 55801, 55809, 55816, 55823,
+    55831, 55838, 55845, 55853, 55860, 55867, 55875, 55882, 55889, 55897, 55904, 55911,
+    55919, 55926, 55933, 55941, 55948, 55955, 55963, 55970, 55977, 55984, 55992, 55999,
+    56006, 56014, 56021, 56028, 56036, 56043, 56050, 56057, 56065, 56072, 56079, 56087,
+    56094, 56101, 56108, 56116, 56123, 56130, 56138, 56145, 56152, 56159, 56167, 56174,
+    56181, 56188, 56196, 56203, 56210, 56217, 56225, 56232, 56239, 56246, 56254, 56261,
+    56268, 56275, 56283, 56290, 56297, 56304, 56311, 56319, 56326, 56333, 56340, 56348,
+    56355, 56362, 56369, 56376, 56384, 56391, 56398, 56405, 56412, 56420, 56427, 56434,
+    56441, 56448, 56456, 56463, 56470, 56477, 56484, 56491, 56499, 56506, 56513, 56520,
+    56527, 56534, 56542, 56549, 56556, 56563, 56570, 56577, 56585, 56592, 56599, 56606,
+    56613, 56620, 56627, 56635, 56642, 56649, 56656, 56663, 56670, 56677, 56685, 56692,
+    56699, 56706, 56713, 56720, 56727, 56734, 56742, 56749, 56756, 56763, 56770, 56777,
+    56784, 56791, 56798, 56805, 56813, 56820, 56827, 56834, 56841, 56848, 56855, 56862,
+    56869, 56876, 56883, 56891, 56898, 56905, 56912, 56919, 56926, 56933, 56940, 56947,
+    56954, 56961, 56968, 56975, 56982, 56989, 56997, 57004, 57011, 57018, 57025, 57032,
+    57039, 57046, 57053, 57060, 57067, 57074, 57081, 57088, 57095, 57102, 57109, 57116,
+    57123, 57130, 57137, 57144, 57151, 57158, 57165, 57172, 57179, 57186, 57193, 57200,
+    57207, 57214, 57221, 57228, 57235, 57242, 57249, 57256, 57263, 57270, 57277, 57284,
+    57291, 57298, 57305, 57312, 57319, 57326, 57333, 57340, 57347, 57354, 57361, 57368,
+    57375, 57382, 57389, 57396, 57403, 57410, 57416, 57423, 57430, 57437, 57444, 57451,
+    57458, 57465, 57472, 57479, 57486, 57493, 57500, 57507, 57514, 57521, 57527, 57534,
+    57541, 57548, 57555, 57562, 57569, 57576, 57583, 57590, 57597, 57603, 57610, 57617,
+    57624, 57631, 57638, 57645, 57652, 57659, 57666, 57672, 57679, 57686, 57693, 57700,
+    57707, 57714, 57721, 57727, 57734, 57741, 57748, 57755, 57762, 57769, 57776, 57782,
+    57789, 57796, 57803, 57810, 57817, 57824, 57830, 57837, 57844, 57851, 57858, 57865,
+    57871, 57878, 57885, 57892, 57899, 57906, 57912, 57919, 57926, 57933, 57940, 57947,
+    57953, 57960, 57967, 57974, 57981, 57987, 57994, 58001, 58008, 58015, 58022, 58028,
+    58035, 58042, 58049, 58056, 58062, 58069, 58076, 58083, 58089, 58096, 58103, 58110,
+    58117, 58123, 58130, 58137, 58144, 58150, 58157, 58164, 58171, 58178, 58184, 58191,
+    58198, 58205, 58211, 58218, 58225, 58232, 58238, 58245, 58252, 58259, 58265, 58272,
+    58279, 58286, 58292, 58299, 58306, 58313, 58319, 58326, 58333, 58340, 58346, 58353,
+    58360, 58366, 58373, 58380, 58387, 58393, 58400, 58407, 58413, 58420, 58427, 58434,
+    58440, 58447, 58454, 58460, 58467, 58474, 58481, 58487, 58494, 58501, 58507, 58514,
+    58521, 58527, 58534, 58541, 58547, 58554, 58561, 58567, 58574, 58581, 58588, 58594,
+    58601, 58608, 58614, 58621, 58628, 58634, 58641, 58648, 58654, 58661, 58667, 58674,
+    58681, 58687, 58694, 58701, 58707, 58714, 58721, 58727, 58734, 58741, 58747, 58754,
+    58761, 58767, 58774, 58780, 58787, 58794, 58800, 58807, 58814, 58820, 58827, 58833,
+    58840, 58847, 58853, 58860, 58866, 58873, 58880, 58886, 58893, 58899, 58906, 58913,
+    58919, 58926, 58932, 58939, 58946, 58952, 58959, 58965, 58972, 58979, 58985, 58992,
+    58998, 59005, 59012, 59018, 59025, 59031, 59038, 59044, 59051, 59058, 59064, 59071,
+    59077, 59084, 59090, 59097, 59103, 59110, 59117, 59123, 59130, 59136, 59143, 59149,
+    59156, 59162, 59169, 59176, 59182, 59189, 59195, 59202, 59208, 59215, 59221, 59228,
+    59234, 59241, 59247, 59254, 59260, 59267, 59273, 59280, 59286, 59293, 59300, 59306,
+    59313, 59319, 59326, 59332, 59339, 59345, 59352, 59358, 59365, 59371, 59378, 59384,
+    59391, 59397, 59404, 59410, 59417, 59423, 59430, 59436, 59442, 59449, 59455, 59462,
+    59468, 59475, 59481, 59488, 59494, 59501, 59507, 59514, 59520, 59527, 59533, 59540,
+    59546, 59552, 59559, 59565, 59572, 59578, 59585, 59591, 59598, 59604, 59611, 59617,
+    59623, 59630, 59636, 59643, 59649, 59656, 59662, 59669, 59675, 59681, 59688, 59694,
+    59701, 59707, 59714, 59720, 59726, 59733, 59739, 59746, 59752, 59758, 59765, 59771,
+    59778, 59784, 59791, 59797, 59803, 59810, 59816, 59823, 59829, 59835, 59842, 59848,
+    59855, 59861, 59867, 59874, 59880, 59886, 59893, 59899, 59906, 59912, 59918, 59925,
+    59931, 59938, 59944, 59950, 59957, 59963, 59969, 59976, 59982, 59988, 59995, 60001,
+    60008, 60014, 60020, 60027, 60033, 60039, 60046, 60052, 60058, 60065, 60071, 60077,
+    60084, 60090, 60096, 60103, 60109, 60116, 60122, 60128, 60135, 60141, 60147, 60154,
+    60160, 60166, 60173, 60179, 60185, 60191, 60198, 60204, 60210, 60217, 60223, 60229,
+    60236, 60242, 60248, 60255, 60261, 60267, 60274, 60280, 60286, 60292, 60299, 60305,
+    60311, 60318, 60324, 60330, 60337, 60343, 60349, 60355, 60362, 60368, 60374, 60381,
+    60387, 60393, 60399, 60406, 60412, 60418, 60425, 60431, 60437, 60443, 60450, 60456,
+    60462, 60468, 60475, 60481, 60487, 60493, 60500, 60506, 60512, 60518, 60525, 60531,
+    60537, 60543, 60550, 60556, 60562, 60568, 60575, 60581, 60587, 60593, 60600, 60606,
+    60612, 60618, 60625, 60631, 60637, 60643, 60650, 60656, 60662, 60668, 60674, 60681,
+    60687, 60693, 60699, 60706, 60712, 60718, 60724, 60730, 60737, 60743, 60749, 60755,
+    60761, 60768, 60774, 60780, 60786, 60792, 60799, 60805, 60811, 60817, 60823, 60830,
+    60836, 60842, 60848, 60854, 60861, 60867, 60873, 60879, 60885, 60891, 60898, 60904,
+    60910, 60916, 60922, 60928, 60935, 60941, 60947, 60953, 60959, 60965, 60972, 60978,
+    60984, 60990, 60996, 61002, 61009, 61015, 61021, 61027, 61033, 61039, 61045, 61052,
+    61058, 61064, 61070, 61076, 61082, 61088, 61095, 61101, 61107, 61113, 61119, 61125,
+    61131, 61138, 61144, 61150, 61156, 61162, 61168, 61174, 61180, 61187, 61193, 61199,
+    61205, 61211, 61217, 61223, 61229, 61235, 61242, 61248, 61254, 61260, 61266, 61272,
+    61278, 61284, 61290, 61296, 61303, 61309, 61315, 61321, 61327, 61333, 61339, 61345,
+    61351, 61357, 61363, 61370, 61376, 61382, 61388, 61394, 61400, 61406, 61412, 61418,
+    61424, 61430, 61436, 61442, 61448, 61455, 61461, 61467, 61473, 61479, 61485, 61491,
+    61497, 61503, 61509, 61515, 61521, 61527, 61533, 61539, 61545, 61551, 61557, 61564,
+    61570, 61576, 61582, 61588, 61594, 61600, 61606, 61612, 61618, 61624, 61630, 61636,
+    61642, 61648, 61654, 61660, 61666, 61672, 61678, 61684, 61690, 61696, 61702, 61708,
+    61714, 61720, 61726, 61732, 61738, 61744, 61750, 61756, 61762, 61768, 61774, 61780,
+    61786, 61792, 61798, 61804, 61810, 61816, 61822, 61828, 61834, 61840, 61846, 61852,
+    61858, 61864, 61870, 61876, 61882, 61888, 61894, 61900, 61906, 61912, 61918, 61924,
+    61930, 61936, 61942, 61948, 61954, 61960, 61966, 61972, 61978, 61984, 61990, 61996,
+    62002, 62008, 62013, 62019, 62025, 62031, 62037, 62043, 62049, 62055, 62061, 62067,
+    62073, 62079, 62085, 62091, 62097, 62103, 62109, 62115, 62121, 62126, 62132, 62138,
+    62144, 62150, 62156, 62162, 62168, 62174, 62180, 62186, 62192, 62198, 62204, 62209,
+    62215, 62221, 62227, 62233, 62239, 62245, 62251, 62257, 62263, 62269, 62274, 62280,
+    62286, 62292, 62298, 62304, 62310, 62316, 62322, 62328, 62333, 62339, 62345, 62351,
+    62357, 62363, 62369, 62375, 62381, 62386, 62392, 62398, 62404, 62410, 62416, 62422,
+    62428, 62434, 62439, 62445, 62451, 62457, 62463, 62469, 62475, 62481, 62486, 62492,
+    62498, 62504, 62510, 62516, 62522, 62527, 62533, 62539, 62545, 62551, 62557, 62563,
+    62568, 62574, 62580, 62586, 62592, 62598, 62603, 62609, 62615, 62621, 62627, 62633,
+    62639, 62644, 62650, 62656, 62662, 62668, 62674, 62679, 62685, 62691, 62697, 62703,
+    62709, 62714, 62720, 62726, 62732, 62738, 62743, 62749, 62755, 62761, 62767, 62773,
+    62778, 62784, 62790, 62796, 62802, 62807, 62813, 62819, 62825, 62831, 62836, 62842,
+    62848, 62854, 62860, 62865, 62871, 62877, 62883, 62889, 62894, 62900, 62906, 62912,
+    62918, 62923, 62929, 62935, 62941, 62946, 62952, 62958, 62964, 62970, 62975, 62981,
+    62987, 62993, 62998, 63004, 63010, 63016, 63021, 63027, 63033, 63039, 63045, 63050,
+    63056, 63062, 63068, 63073, 63079, 63085, 63091, 63096, 63102, 63108, 63114, 63119,
+    63125, 63131, 63137, 63142, 63148, 63154, 63160, 63165, 63171, 63177, 63183, 63188,
+    63194, 63200, 63206, 63211, 63217, 63223, 63228, 63234, 63240, 63246, 63251, 63257,
+    63263, 63269, 63274, 63280, 63286, 63291, 63297, 63303, 63309, 63314, 63320, 63326,
+    63331, 63337, 63343, 63349, 63354, 63360, 63366, 63371, 63377, 63383, 63388, 63394,
+    63400, 63406, 63411, 63417, 63423, 63428, 63434, 63440, 63445, 63451, 63457, 63462,
+    63468, 63474, 63480, 63485, 63491, 63497, 63502, 63508, 63514, 63519, 63525, 63531,
+    63536, 63542, 63548, 63553, 63559, 63565, 63570, 63576, 63582, 63587, 63593, 63599,
+    63604, 63610, 63616, 63621, 63627, 63633, 63638, 63644, 63650, 63655, 63661, 63667,
+    63672, 63678, 63684, 63689, 63695, 63700, 63706, 63712, 63717, 63723, 63729, 63734,
+    63740, 63746, 63751, 63757, 63762, 63768, 63774, 63779, 63785, 63791, 63796, 63802,
+    63808, 63813, 63819, 63824, 63830, 63836, 63841, 63847, 63853, 63858, 63864, 63869,
+    63875, 63881, 63886, 63892, 63897, 63903, 63909, 63914, 63920, 63925, 63931, 63937,
+    63942, 63948, 63953, 63959, 63965, 63970, 63976, 63981, 63987, 63993, 63998, 64004,
+    64009, 64015, 64021, 64026, 64032, 64037, 64043, 64049, 64054, 64060, 64065, 64071,
+    64076, 64082, 64088, 64093, 64099, 64104, 64110, 64115, 64121, 64127, 64132, 64138,
+    64143, 64149, 64154, 64160, 64166, 64171, 64177, 64182, 64188, 64193, 64199, 64205,
+    64210, 64216, 64221, 64227, 64232, 64238, 64243, 64249, 64254, 64260, 64266, 64271,
+    64277, 64282, 64288, 64293, 64299, 64304, 64310, 64315, 64321, 64327, 64332, 64338,
+    64343, 64349, 64354, 64360, 64365, 64371, 64376, 64382, 64387, 64393, 64398, 64404,
+    64409, 64415, 64420, 64426, 64432, 64437, 64443, 64448, 64454, 64459, 64465, 64470,
+    64476, 64481, 64487, 64492, 64498, 64503, 64509, 64514, 64520, 64525, 64531, 64536,
+    64542, 64547, 64553, 64558, 64564, 64569, 64575, 64580, 64586, 64591, 64597, 64602,
+    64608, 64613, 64619, 64624, 64630, 64635, 64641, 64646, 64651, 64657, 64662, 64668,
+    64673, 64679, 64684, 64690, 64695, 64701, 64706, 64712, 64717, 64723, 64728, 64734,
+    64739, 64745, 64750, 64755, 64761, 64766, 64772, 64777, 64783, 64788, 64794, 64799,
+    64805, 64810, 64815, 64821, 64826, 64832, 64837, 64843, 64848, 64854, 64859, 64864,
+    64870, 64875, 64881, 64886, 64892, 64897, 64903, 64908, 64913, 64919, 64924, 64930,
+    64935, 64941, 64946, 64951, 64957, 64962, 64968, 64973, 64979, 64984, 64989, 64995,
+    65000, 65006, 65011, 65017, 65022, 65027, 65033, 65038, 65044, 65049, 65054, 65060,
+    65065, 65071, 65076, 65082, 65087, 65092, 65098, 65103, 65109, 65114, 65119, 65125,
+    65130, 65136, 65141, 65146, 65152, 65157, 65163, 65168, 65173, 65179, 65184, 65190,
+    65195, 65200, 65206, 65211, 65216, 65222, 65227, 65233, 65238, 65243, 65249, 65254,
+    65260, 65265, 65270, 65276, 65281, 65286, 65292, 65297, 65303, 65308, 65313, 65319,
+    65324, 65329, 65335, 65340, 65345, 65351, 65356, 65362, 65367, 65372, 65378, 65383,
+    65388, 65394, 65399, 65404, 65410, 65415, 65420, 65426, 65431, 65437, 65442, 65447,
+    65453, 65458, 65463, 65469, 65474, 65479, 65485, 65490, 65495, 65501, 65506, 65511,
+    65517, 65522, 65527, 65533
+};
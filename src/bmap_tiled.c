@@ -0,0 +1,390 @@
+/**
+ * @file bmap_tiled.c
+ * @brief Tiled pyramid container (.bmt) with a tile index for random access.
+ * * Layout, all integers little-endian:
+ *   header   32 bytes: "BMAPTILE", version, tile size, width, height, levels, 0
+ *   tiles    level 0 first, row-major within a level; raw BGR or QOI each
+ *   index    16 bytes per tile: offset (u64), size (u32), codec (u8), 3 x 0
+ *   footer   16 bytes: index offset (u64), tile count (u32), "BMTI"
+ * Level k is level k-1 halved (rounding up) with bmp_resize(). The reader
+ * loads the index once; after that every tile costs exactly one pread, and
+ * raw tiles are read straight into the returned image.
+ * @author Arda Aksu
+ * @date 2026
+ * @see bmap.h for the public tiled-format API.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bmap_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+#define TILED_VERSION 1
+#define TILED_HEADER_SIZE 32
+#define TILED_ENTRY_SIZE 16
+#define TILED_FOOTER_SIZE 16
+#define TILED_MAX_TILE 32768  /* A raw tile (edge^2 x 3 bytes) must fit the u32 size field */
+
+typedef struct {
+    uint64_t offset;
+    uint32_t size;
+    uint8_t codec;
+} TileEntry;
+
+struct BMPTiledReader {
+    int fd;
+    int tile_size;
+    int level_count;
+    BMPTiledLevel levels[BMP_TILED_MAX_LEVELS];
+    size_t first_tile[BMP_TILED_MAX_LEVELS];    /* Index of each level's first entry */
+    TileEntry* entries;
+};
+
+/* --- Layout Helpers --- */
+
+static void put_le32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static void put_le64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint32_t get_le32(const uint8_t* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint64_t get_le64(const uint8_t* p) {
+    return (uint64_t)get_le32(p) | (uint64_t)get_le32(p + 4) << 32;
+}
+
+/* Fills level sizes and returns the number of levels actually used */
+static int plan_levels(int width, int height, int tile_size, int requested, BMPTiledLevel* levels) {
+    int count = 0;
+    for (;;) {
+        levels[count].width = width;
+        levels[count].height = height;
+        levels[count].tiles_x = (int)(((size_t)width + tile_size - 1) / tile_size);
+        levels[count].tiles_y = (int)(((size_t)height + tile_size - 1) / tile_size);
+        count++;
+
+        /* Automatic pyramids stop once a level fits in one tile */
+        int done = requested > 0 ? count >= requested : (width <= tile_size && height <= tile_size);
+        if (done || count == BMP_TILED_MAX_LEVELS || (width == 1 && height == 1)) return count;
+        width = (width + 1) / 2;
+        height = (height + 1) / 2;
+    }
+}
+
+/* --- Writer --- */
+
+static BMPError write_all(FILE* file, const void* data, size_t len, uint64_t* offset) {
+    if (fwrite(data, 1, len, file) != len) return BMP_ERR_IO;
+    *offset += len;
+    return BMP_SUCCESS;
+}
+
+/* Appends every tile of one level, filling its index entries */
+static BMPError write_level(FILE* file, const BMPImage* level, const BMPTiledLevel* info,
+                            int tile_size, int compress, BMPImage* tile,
+                            TileEntry* entries, uint64_t* offset) {
+    for (int ty = 0; ty < info->tiles_y; ty++) {
+        for (int tx = 0; tx < info->tiles_x; tx++) {
+            int x0 = tx * tile_size, y0 = ty * tile_size;
+            tile->width = level->width - x0 < tile_size ? level->width - x0 : tile_size;
+            tile->height = level->height - y0 < tile_size ? level->height - y0 : tile_size;
+            for (int y = 0; y < tile->height; y++) {
+                memcpy(&tile->data[(size_t)y * tile->width],
+                       &level->data[(size_t)(y0 + y) * level->width + x0],
+                       (size_t)tile->width * sizeof(Pixel));
+            }
+
+            size_t raw_size = (size_t)tile->width * tile->height * sizeof(Pixel);
+            size_t qoi_size = 0;
+            void* qoi = compress ? bmp_encode_qoi(tile, &qoi_size, NULL) : NULL;
+            int use_qoi = qoi && qoi_size < raw_size;
+
+            TileEntry* entry = &entries[(size_t)ty * info->tiles_x + tx];
+            entry->offset = *offset;
+            entry->size = (uint32_t)(use_qoi ? qoi_size : raw_size);
+            entry->codec = use_qoi ? BMP_TILE_QOI : BMP_TILE_RAW;
+            BMPError err = write_all(file, use_qoi ? qoi : (void*)tile->data, entry->size, offset);
+            free(qoi);
+            if (err != BMP_SUCCESS) return err;
+        }
+    }
+    return BMP_SUCCESS;
+}
+
+BMPError bmp_save_tiled(const BMPImage* image, const char* filename, int tile_size, int levels, int compress) {
+    if (!image || !image->data || tile_size <= 0 || tile_size > TILED_MAX_TILE) return BMP_ERR_INVALID_ARGUMENT;
+
+    BMPTiledLevel plan[BMP_TILED_MAX_LEVELS];
+    int level_count = plan_levels(image->width, image->height, tile_size, levels, plan);
+    size_t tile_count = 0;
+    for (int l = 0; l < level_count; l++) tile_count += (size_t)plan[l].tiles_x * plan[l].tiles_y;
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) return BMP_ERR_FILE_NOT_FOUND;
+
+    BMPError err = BMP_ERR_MALLOC_FAILED;
+    TileEntry* entries = (TileEntry*)calloc(tile_count, sizeof(TileEntry));
+    /* No tile is larger than the image, so neither is the scratch tile */
+    BMPImage* tile = bmp_create(image->width < tile_size ? image->width : tile_size,
+                                image->height < tile_size ? image->height : tile_size, NULL);
+    BMPImage* level = NULL;
+    uint64_t offset = 0;
+
+    if (entries && tile) {
+        uint8_t header[TILED_HEADER_SIZE] = { 'B', 'M', 'A', 'P', 'T', 'I', 'L', 'E' };
+        put_le32(header + 8, TILED_VERSION);
+        put_le32(header + 12, (uint32_t)tile_size);
+        put_le32(header + 16, (uint32_t)image->width);
+        put_le32(header + 20, (uint32_t)image->height);
+        put_le32(header + 24, (uint32_t)level_count);
+        err = write_all(file, header, sizeof(header), &offset);
+    }
+
+    const BMPImage* current = image;
+    size_t first = 0;
+    for (int l = 0; l < level_count && err == BMP_SUCCESS; l++) {
+        if (l > 0) {
+            /* Each level is derived from the previous one, never from the full image */
+            if (!level) level = bmp_clone(image, NULL);
+            if (!level) {
+                err = BMP_ERR_MALLOC_FAILED;
+                break;
+            }
+            bmp_resize(level, plan[l].width, plan[l].height);
+            if (level->width != plan[l].width || level->height != plan[l].height) {
+                err = BMP_ERR_MALLOC_FAILED;
+                break;
+            }
+            current = level;
+        }
+        err = write_level(file, current, &plan[l], tile_size, compress, tile, entries + first, &offset);
+        first += (size_t)plan[l].tiles_x * plan[l].tiles_y;
+    }
+
+    uint64_t index_offset = offset;
+    uint8_t record[TILED_ENTRY_SIZE];
+    for (size_t i = 0; i < tile_count && err == BMP_SUCCESS; i++) {
+        memset(record, 0, sizeof(record));
+        put_le64(record, entries[i].offset);
+        put_le32(record + 8, entries[i].size);
+        record[12] = entries[i].codec;
+        err = write_all(file, record, sizeof(record), &offset);
+    }
+
+    if (err == BMP_SUCCESS) {
+        uint8_t footer[TILED_FOOTER_SIZE] = { 0 };
+        put_le64(footer, index_offset);
+        put_le32(footer + 8, (uint32_t)tile_count);
+        memcpy(footer + 12, "BMTI", 4);
+        err = write_all(file, footer, sizeof(footer), &offset);
+    }
+
+    if (fclose(file) != 0 && err == BMP_SUCCESS) err = BMP_ERR_IO;
+    free(entries);
+    bmp_free(tile);
+    bmp_free(level);
+    return err;
+}
+
+/* --- Reader --- */
+
+static BMPTiledReader* open_failed(BMPTiledReader* reader, BMPError err, BMPError* err_out) {
+    bmp_tiled_close(reader);
+    if (err_out) *err_out = err;
+    return NULL;
+}
+
+BMPTiledReader* bmp_tiled_open(const char* filename, BMPError* err_out) {
+    int fd = filename ? open(filename, O_RDONLY | O_BINARY) : -1;
+    if (fd < 0) {
+        if (err_out) *err_out = BMP_ERR_FILE_NOT_FOUND;
+        return NULL;
+    }
+
+    BMPTiledReader* reader = (BMPTiledReader*)calloc(1, sizeof(BMPTiledReader));
+    if (!reader) {
+        close(fd);
+        if (err_out) *err_out = BMP_ERR_MALLOC_FAILED;
+        return NULL;
+    }
+    reader->fd = fd;
+
+    uint8_t header[TILED_HEADER_SIZE], footer[TILED_FOOTER_SIZE];
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < TILED_HEADER_SIZE + TILED_FOOTER_SIZE ||
+        bmap_read_at(fd, header, sizeof(header), 0) != 0 ||
+        bmap_read_at(fd, footer, sizeof(footer), (uint64_t)st.st_size - TILED_FOOTER_SIZE) != 0 ||
+        memcmp(header, "BMAPTILE", 8) != 0 || get_le32(header + 8) != TILED_VERSION ||
+        memcmp(footer + 12, "BMTI", 4) != 0) {
+        return open_failed(reader, BMP_ERR_INVALID_FORMAT, err_out);
+    }
+
+    uint32_t tile_size = get_le32(header + 12), width = get_le32(header + 16);
+    uint32_t height = get_le32(header + 20), levels = get_le32(header + 24);
+    if (tile_size == 0 || tile_size > TILED_MAX_TILE || width == 0 || width > 0x7fffffffu ||
+        height == 0 || height > 0x7fffffffu || levels == 0 || levels > BMP_TILED_MAX_LEVELS) {
+        return open_failed(reader, BMP_ERR_INVALID_FORMAT, err_out);
+    }
+
+    reader->tile_size = (int)tile_size;
+    reader->level_count = plan_levels((int)width, (int)height, (int)tile_size, (int)levels, reader->levels);
+    size_t tile_count = 0;
+    for (int l = 0; l < reader->level_count; l++) {
+        reader->first_tile[l] = tile_count;
+        tile_count += (size_t)reader->levels[l].tiles_x * reader->levels[l].tiles_y;
+    }
+
+    /* The index must sit between the header and the footer and hold exactly one entry per tile */
+    uint64_t index_offset = get_le64(footer);
+    uint64_t index_end = (uint64_t)st.st_size - TILED_FOOTER_SIZE;
+    if (reader->level_count != (int)levels || get_le32(footer + 8) != tile_count ||
+        index_offset < TILED_HEADER_SIZE || index_offset > index_end ||
+        index_end - index_offset != (uint64_t)tile_count * TILED_ENTRY_SIZE) {
+        return open_failed(reader, BMP_ERR_INVALID_FORMAT, err_out);
+    }
+
+    uint8_t* index = (uint8_t*)malloc(tile_count * TILED_ENTRY_SIZE);
+    reader->entries = (TileEntry*)malloc(tile_count * sizeof(TileEntry));
+    if (!index || !reader->entries) {
+        free(index);
+        return open_failed(reader, BMP_ERR_MALLOC_FAILED, err_out);
+    }
+    if (bmap_read_at(fd, index, tile_count * TILED_ENTRY_SIZE, index_offset) != 0) {
+        free(index);
+        return open_failed(reader, BMP_ERR_INVALID_FORMAT, err_out);
+    }
+
+    for (size_t i = 0; i < tile_count; i++) {
+        const uint8_t* record = index + i * TILED_ENTRY_SIZE;
+        TileEntry* entry = &reader->entries[i];
+        entry->offset = get_le64(record);
+        entry->size = get_le32(record + 8);
+        entry->codec = record[12];
+        if (entry->offset < TILED_HEADER_SIZE || entry->offset > index_offset ||
+            entry->size > index_offset - entry->offset ||
+            (entry->codec != BMP_TILE_RAW && entry->codec != BMP_TILE_QOI)) {
+            free(index);
+            return open_failed(reader, BMP_ERR_INVALID_FORMAT, err_out);
+        }
+    }
+    free(index);
+
+    if (err_out) *err_out = BMP_SUCCESS;
+    return reader;
+}
+
+void bmp_tiled_close(BMPTiledReader* reader) {
+    if (!reader) return;
+    if (reader->fd >= 0) close(reader->fd);
+    free(reader->entries);
+    free(reader);
+}
+
+int bmp_tiled_level_count(const BMPTiledReader* reader) {
+    return reader ? reader->level_count : 0;
+}
+
+int bmp_tiled_tile_size(const BMPTiledReader* reader) {
+    return reader ? reader->tile_size : 0;
+}
+
+BMPError bmp_tiled_level_info(const BMPTiledReader* reader, int level, BMPTiledLevel* info) {
+    if (!reader || !info || level < 0 || level >= reader->level_count) return BMP_ERR_INVALID_ARGUMENT;
+    *info = reader->levels[level];
+    return BMP_SUCCESS;
+}
+
+BMPImage* bmp_tiled_read_tile(const BMPTiledReader* reader, int level, int tile_x, int tile_y,
+                              BMPError* err_out) {
+    if (!reader || level < 0 || level >= reader->level_count ||
+        tile_x < 0 || tile_x >= reader->levels[level].tiles_x ||
+        tile_y < 0 || tile_y >= reader->levels[level].tiles_y) {
+        if (err_out) *err_out = BMP_ERR_INVALID_ARGUMENT;
+        return NULL;
+    }
+
+    const BMPTiledLevel* info = &reader->levels[level];
+    const TileEntry* entry = &reader->entries[reader->first_tile[level] + (size_t)tile_y * info->tiles_x + tile_x];
+    int ts = reader->tile_size;
+    int w = info->width - tile_x * ts < ts ? info->width - tile_x * ts : ts;
+    int h = info->height - tile_y * ts < ts ? info->height - tile_y * ts : ts;
+
+    if (entry->codec == BMP_TILE_RAW) {
+        /* Raw tiles land directly in the pixel buffer */
+        if (entry->size != (size_t)w * h * sizeof(Pixel)) {
+            if (err_out) *err_out = BMP_ERR_INVALID_FORMAT;
+            return NULL;
+        }
+        BMPImage* tile = bmp_create(w, h, err_out);
+        if (tile && bmap_read_at(reader->fd, tile->data, entry->size, entry->offset) != 0) {
+            bmp_free(tile);
+            if (err_out) *err_out = BMP_ERR_INVALID_FORMAT;
+            return NULL;
+        }
+        return tile;
+    }
+
+    void* packed = malloc(entry->size ? entry->size : 1);
+    if (!packed) {
+        if (err_out) *err_out = BMP_ERR_MALLOC_FAILED;
+        return NULL;
+    }
+    BMPImage* tile = NULL;
+    if (bmap_read_at(reader->fd, packed, entry->size, entry->offset) == 0) {
+        tile = bmp_decode_qoi(packed, entry->size, err_out);
+        if (tile && (tile->width != w || tile->height != h)) {
+            bmp_free(tile);
+            tile = NULL;
+        }
+    }
+    free(packed);
+    if (!tile && err_out && *err_out != BMP_ERR_MALLOC_FAILED) *err_out = BMP_ERR_INVALID_FORMAT;
+    return tile;
+}
+
+BMPImage* bmp_tiled_read_level(const BMPTiledReader* reader, int level, BMPError* err_out) {
+    BMPTiledLevel info;
+    if (bmp_tiled_level_info(reader, level, &info) != BMP_SUCCESS) {
+        if (err_out) *err_out = BMP_ERR_INVALID_ARGUMENT;
+        return NULL;
+    }
+
+    BMPImage* img = bmp_create(info.width, info.height, err_out);
+    if (!img) return NULL;
+
+    int ts = reader->tile_size;
+    for (int ty = 0; ty < info.tiles_y; ty++) {
+        for (int tx = 0; tx < info.tiles_x; tx++) {
+            BMPImage* tile = bmp_tiled_read_tile(reader, level, tx, ty, err_out);
+            if (!tile) {
+                bmp_free(img);
+                return NULL;
+            }
+            for (int y = 0; y < tile->height; y++) {
+                memcpy(&img->data[(size_t)(ty * ts + y) * img->width + (size_t)tx * ts],
+                       &tile->data[(size_t)y * tile->width], (size_t)tile->width * sizeof(Pixel));
+            }
+            bmp_free(tile);
+        }
+    }
+    if (err_out) *err_out = BMP_SUCCESS;
+    return img;
+}
@@ -0,0 +1,379 @@
+/**
+ * @file test_cpp.cpp
+ * @brief Test suite for the header-only C++ layer (bmap.hpp).
+ * @author Arda Aksu
+ * @date 2026
+ */
+
+#include "bmap.hpp"
+#include "bmap_expr.hpp"
+#include "bmap_formats.hpp"
+#include "bmap_tables.hpp"
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+int main() {
+    std::printf("--- BMP C++ Layer Test Suite Started ---\n");
+
+    // 1. RAII & Move Semantics
+    std::printf("[1/9] Loading and moving images... ");
+    bmap::Image img = bmap::Image::load("assets/airplane.bmp");
+    const Pixel* pixels = img.data();
+    bmap::Image moved = std::move(img);
+    if (img || moved.data() != pixels || moved.width() != 512) {
+        std::printf("FAILED! (move did not transfer ownership)\n");
+        return 1;
+    }
+    try {
+        bmap::Image::load("assets/missing.bmp");
+        std::printf("FAILED! (missing file did not throw)\n");
+        return 1;
+    } catch (const bmap::Error& e) {
+        if (e.code() != BMP_ERR_FILE_NOT_FOUND) {
+            std::printf("FAILED! (wrong error code %d)\n", e.code());
+            return 1;
+        }
+    }
+    std::printf("Success!\n");
+
+    // 2. Views & Row Iteration
+    // Inverting through a subview must match the C filter on the same window
+    std::printf("[2/9] Iterating rows of views... ");
+    bmap::Image expected = moved.clone();
+    bmp_invert(expected.get());
+
+    for (auto row : moved.view().subview(0, 0, moved.width(), moved.height()).rows()) {
+        for (Pixel& p : row) {
+            p.blue = 255 - p.blue;
+            p.green = 255 - p.green;
+            p.red = 255 - p.red;
+        }
+    }
+    bmap::ConstImageView window = moved.view().subview(500, 500, 64, 64);
+    if (window.width() != 12 || window.height() != 12 || window.stride() != 512 ||
+        std::memcmp(moved.data(), expected.data(), 512 * 512 * sizeof(Pixel)) != 0) {
+        std::printf("FAILED! (view iteration mismatch)\n");
+        return 1;
+    }
+    std::printf("Success!\n");
+
+    // 3. Format-Templated Kernels
+    // BGR24 kernels must match the C API; other formats must agree with it per channel
+    std::printf("[3/9] Running format-templated kernels... ");
+    bmap::Image c_result = moved.clone();
+    bmp_grayscale(c_result.get());
+    bmp_invert(c_result.get());
+    bmp_rotate_right(c_result.get());
+    bmp_flip_horizontal(c_result.get());
+
+    const int w = moved.width(), h = moved.height();
+    std::vector<bmap::PixelBGRA> bgra(static_cast<std::size_t>(w) * h), bgra_rot(bgra.size());
+    std::vector<std::uint8_t> planes(3 * bgra.size()), planes_rot(planes.size());
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            const Pixel& p = moved(x, y);
+            std::size_t i = static_cast<std::size_t>(y) * w + x;
+            bgra[i] = bmap::PixelBGRA{p.blue, p.green, p.red, 77};
+            planes[i] = p.blue;
+            planes[bgra.size() + i] = p.green;
+            planes[2 * bgra.size() + i] = p.red;
+        }
+    }
+    auto planar = [&](std::vector<std::uint8_t>& v, int pw, int ph) {
+        std::size_t n = bgra.size();
+        return bmap::PlanarView{{v.data(), pw, ph}, {v.data() + n, pw, ph}, {v.data() + 2 * n, pw, ph}};
+    };
+
+    bmap::Image packed = moved.clone();
+    bmap::Image packed_rot(h, w);
+    bool ok = true;
+    for (bmap::PixelFormat format : {bmap::PixelFormat::BGR24, bmap::PixelFormat::BGRA32, bmap::PixelFormat::Planar}) {
+        bmap::dispatch(format, [&](auto tag) {
+            using F = decltype(tag);
+            typename F::view_type view, rotated;
+            if constexpr (std::is_same_v<F, bmap::formats::BGR24>) {
+                view = packed.view();
+                rotated = packed_rot.view();
+            } else if constexpr (std::is_same_v<F, bmap::formats::BGRA32>) {
+                view = {bgra.data(), w, h};
+                rotated = {bgra_rot.data(), h, w};
+            } else if constexpr (std::is_same_v<F, bmap::formats::Planar>) {
+                view = planar(planes, w, h);
+                rotated = planar(planes_rot, h, w);
+            }
+            bmap::kernels::grayscale<F>(view);
+            bmap::kernels::invert<F>(view);
+            bmap::kernels::rotate_right<F>(view, rotated);
+            bmap::kernels::flip_horizontal<F>(rotated);
+        });
+    }
+    for (int y = 0; ok && y < w; y++) {
+        for (int x = 0; ok && x < h; x++) {
+            const Pixel& e = c_result(x, y);
+            std::size_t i = static_cast<std::size_t>(y) * h + x;
+            const bmap::PixelBGRA& q = bgra_rot[i];
+            ok = std::memcmp(&packed_rot(x, y), &e, sizeof(Pixel)) == 0 &&
+                 q.blue == e.blue && q.green == e.green && q.red == e.red && q.alpha == 77 &&
+                 planes_rot[i] == e.blue && planes_rot[bgra.size() + i] == e.green &&
+                 planes_rot[2 * bgra.size() + i] == e.red;
+        }
+    }
+
+    // Odd sizes leave partial SIMD blocks in every rotation tile; the templated kernel is the reference
+    bmap::Image odd(83, 150), odd_rot(150, 83);
+    for (int y = 0; y < 150; y++) {
+        for (int x = 0; x < 83; x++) odd(x, y) = moved(x * 5 + 3, y * 3 + 1);
+    }
+    bmap::kernels::rotate_right<bmap::formats::BGR24>(odd.view(), odd_rot.view());
+    odd.rotate_right();
+    ok = ok && odd.width() == 150 && std::memcmp(odd.data(), odd_rot.data(), 83 * 150 * sizeof(Pixel)) == 0;
+    if (!ok) {
+        std::printf("FAILED! (kernel output differs from the C API)\n");
+        return 1;
+    }
+    std::printf("Success!\n");
+
+    // 4. Image Comparison
+    // bmp_compare() must agree with a byte-wise reference on every ISA
+    std::printf("[4/9] Comparing images... ");
+    bmap::Image diff(w, h);
+    BMPCompareResult cmp;
+    ok = bmp_compare(moved.get(), packed.get(), 0, 3, diff.get(), &cmp) == BMP_SUCCESS;
+    std::uint64_t squared = 0;
+    int max_diff = 0;
+    const std::uint8_t* pa = reinterpret_cast<const std::uint8_t*>(moved.data());
+    const std::uint8_t* pb = reinterpret_cast<const std::uint8_t*>(packed.data());
+    const std::uint8_t* pd = reinterpret_cast<const std::uint8_t*>(diff.data());
+    for (std::size_t i = 0; ok && i < 3 * bgra.size(); i++) {
+        int d = pa[i] > pb[i] ? pa[i] - pb[i] : pb[i] - pa[i];
+        squared += static_cast<std::uint64_t>(d) * d;
+        max_diff = d > max_diff ? d : max_diff;
+        ok = pd[i] == d;
+    }
+    ok = ok && cmp.max_abs_diff == max_diff && cmp.mse == static_cast<double>(squared) / (3.0 * bgra.size());
+    if (!ok) {
+        std::printf("FAILED! (comparison differs from the byte-wise reference)\n");
+        return 1;
+    }
+    std::printf("Success!\n");
+
+    // 5. Blending
+    // Every blend mode must match exactly rounded integer math, with the overlay clipped at the corner;
+    // in linear light the same formulas run on the 16-bit decode scaled to 65535
+    auto div255 = [](int x) { return (2 * x + 255) / 510; };
+    auto linear_mix = [](BMPBlendMode mode, std::uint32_t s, std::uint32_t d, std::uint32_t a) {
+        s = bmap::srgb_to_linear16[s];
+        d = bmap::srgb_to_linear16[d];
+        std::uint32_t b = mode == BMP_BLEND_MULTIPLY ? (s * d + 32767) / 65535 :
+                          mode == BMP_BLEND_SCREEN ? 65535 - ((65535 - s) * (65535 - d) + 32767) / 65535 :
+                          mode == BMP_BLEND_ADD ? (s + d > 65535 ? 65535 : s + d) : s;
+        return bmap::linear12_to_srgb[(b * a + d * (255 - a) + 127) / 255 >> 4];
+    };
+    std::printf("[5/9] Blending images... ");
+    std::vector<std::uint8_t> mask(bgra.size());
+    for (std::size_t i = 0; i < mask.size(); i++) mask[i] = static_cast<std::uint8_t>(i * 37 + i / 512);
+    for (int flags : {0, static_cast<int>(BMP_MIX_LINEAR_LIGHT)}) {
+        for (BMPBlendMode mode : {BMP_BLEND_OVER, BMP_BLEND_MULTIPLY, BMP_BLEND_SCREEN, BMP_BLEND_ADD}) {
+            bmap::Image blended = moved.clone();
+            ok = ok && bmp_composite(blended.get(), -7, 5, packed.get(), mask.data(), 200, mode, flags) == BMP_SUCCESS;
+            for (int y = 0; ok && y < h; y++) {
+                for (int x = 0; ok && x < w; x++) {
+                    const std::uint8_t* d = &moved(x, y).blue;
+                    const std::uint8_t* r = &blended(x, y).blue;
+                    bool covered = y >= 5 && x < w - 7;
+                    int a = covered ? div255(mask[static_cast<std::size_t>(y - 5) * w + x + 7] * 200) : 0;
+                    const std::uint8_t* s = covered ? &packed(x + 7, y - 5).blue : d;
+                    for (int c = 0; ok && c < 3; c++) {
+                        if (flags) {
+                            ok = r[c] == linear_mix(mode, s[c], d[c], static_cast<std::uint32_t>(a));
+                            continue;
+                        }
+                        int b = mode == BMP_BLEND_MULTIPLY ? div255(s[c] * d[c]) :
+                                mode == BMP_BLEND_SCREEN ? 255 - div255((255 - s[c]) * (255 - d[c])) :
+                                mode == BMP_BLEND_ADD ? (s[c] + d[c] > 255 ? 255 : s[c] + d[c]) : s[c];
+                        ok = r[c] == div255(b * a + d[c] * (255 - a));
+                    }
+                }
+            }
+        }
+    }
+
+    // An opaque "over" through a strided subview is a plain copy of that window only, in linear light too
+    bmap::Image overlay = moved.clone();
+    bmap::composite(overlay.view().subview(3, 4, 100, 50), packed.view().subview(3, 4, 100, 50), BMP_BLEND_OVER);
+    bmap::composite(overlay.view().subview(3, 60, 100, 50), packed.view().subview(3, 60, 100, 50), BMP_BLEND_OVER,
+                    255, nullptr, 0, BMP_MIX_LINEAR_LIGHT);
+    ok = ok && std::memcmp(&overlay(3, 4), &packed(3, 4), 100 * sizeof(Pixel)) == 0 &&
+         std::memcmp(&overlay(103, 4), &moved(103, 4), sizeof(Pixel)) == 0 &&
+         std::memcmp(&overlay(3, 54), &moved(3, 54), sizeof(Pixel)) == 0 &&
+         std::memcmp(&overlay(3, 60), &packed(3, 60), 100 * sizeof(Pixel)) == 0 &&
+         std::memcmp(&overlay(103, 60), &moved(103, 60), sizeof(Pixel)) == 0;
+
+    // Linear light over every pair of byte values, each at a spread of coverages
+    bmap::Image pair_src(256, 256), pair_dst(256, 256);
+    std::vector<std::uint8_t> pair_mask(256 * 256);
+    for (int y = 0; y < 256; y++) {
+        for (int x = 0; x < 256; x++) {
+            pair_src(x, y) = Pixel{static_cast<std::uint8_t>(x), static_cast<std::uint8_t>(y),
+                                   static_cast<std::uint8_t>(x ^ y)};
+            pair_dst(x, y) = Pixel{static_cast<std::uint8_t>(y), static_cast<std::uint8_t>(x),
+                                   static_cast<std::uint8_t>(255 - y)};
+            pair_mask[static_cast<std::size_t>(y) * 256 + x] = static_cast<std::uint8_t>(x * 7 + y * 13);
+        }
+    }
+    for (BMPBlendMode mode : {BMP_BLEND_OVER, BMP_BLEND_MULTIPLY, BMP_BLEND_SCREEN, BMP_BLEND_ADD}) {
+        bmap::Image blended = pair_dst.clone();
+        ok = ok && bmp_composite(blended.get(), 0, 0, pair_src.get(), pair_mask.data(), 255, mode,
+                                 BMP_MIX_LINEAR_LIGHT) == BMP_SUCCESS;
+        for (int y = 0; ok && y < 256; y++) {
+            for (int x = 0; ok && x < 256; x++) {
+                const std::uint8_t* s = &pair_src(x, y).blue;
+                const std::uint8_t* d = &pair_dst(x, y).blue;
+                const std::uint8_t* r = &blended(x, y).blue;
+                std::uint32_t a = pair_mask[static_cast<std::size_t>(y) * 256 + x];
+                for (int c = 0; ok && c < 3; c++) ok = r[c] == linear_mix(mode, s[c], d[c], a);
+            }
+        }
+    }
+    if (!ok) {
+        std::printf("FAILED! (blend differs from the integer reference)\n");
+        return 1;
+    }
+    std::printf("Success!\n");
+
+    // 6. Color Spaces
+    // BT.601 YCbCr must track the float formulas, planar and interleaved must agree, and all spaces round-trip
+    std::printf("[6/9] Converting color spaces... ");
+    const int n = w * h - 5;
+    std::vector<std::uint8_t> ycc(3 * bgra.size()), ycc_planes(3 * bgra.size());
+    std::uint8_t* ch[3] = {ycc_planes.data(), ycc_planes.data() + bgra.size(), ycc_planes.data() + 2 * bgra.size()};
+    bmp_color_from_bgr(ycc.data(), moved.data(), n, BMP_COLOR_YCBCR601);
+    bmp_color_from_bgr_planar(ch[0], ch[1], ch[2], moved.data(), n, BMP_COLOR_YCBCR601);
+    for (int i = 0; ok && i < n; i++) {
+        const Pixel& p = moved.data()[i];
+        double luma = 0.299 * p.red + 0.587 * p.green + 0.114 * p.blue;
+        double ref[3] = {luma, 128 + (p.blue - luma) / 1.772, 128 + (p.red - luma) / 1.402};
+        for (int c = 0; ok && c < 3; c++) {
+            double d = ycc[3 * i + c] - ref[c];
+            ok = d < 1.0 && d > -1.0 && ch[c][i] == ycc[3 * i + c];
+        }
+    }
+    bmap::Image round_trip(w, h);
+    for (BMPColorSpace space : {BMP_COLOR_HSV, BMP_COLOR_HSL, BMP_COLOR_YCBCR601, BMP_COLOR_YCBCR601_LIMITED,
+                                BMP_COLOR_YCBCR709, BMP_COLOR_YCBCR709_LIMITED}) {
+        bmp_color_from_bgr_planar(ch[0], ch[1], ch[2], moved.data(), n, space);
+        bmp_color_to_bgr_planar(round_trip.data(), ch[0], ch[1], ch[2], n, space);
+        const std::uint8_t* a = &moved.data()->blue;
+        const std::uint8_t* b = &round_trip.data()->blue;
+        for (int i = 0; ok && i < 3 * n; i++) ok = a[i] - b[i] <= 4 && b[i] - a[i] <= 4;
+    }
+    const Pixel orange{0, 128, 255};
+    std::uint8_t hsv[3], lab[3];
+    bmp_color_from_bgr(hsv, &orange, 1, BMP_COLOR_HSV);
+    bmp_color_from_bgr(lab, &orange, 1, BMP_COLOR_LAB);
+    ok = ok && hsv[0] == 21 && hsv[1] == 255 && hsv[2] == 255 && lab[0] == 171 && lab[1] == 171 && lab[2] == 202;
+    if (!ok) {
+        std::printf("FAILED! (color conversion differs from the reference formulas)\n");
+        return 1;
+    }
+    std::printf("Success!\n");
+
+    // 7. Chroma-Subsampled Planes
+    // I420 and NV12 must agree, store the top row first, and round-trip an image flat in the 2x2 chroma blocks
+    // (planes run top-down, so with an odd height the blocks pair image rows 2k and 2k - 1)
+    std::printf("[7/9] Packing I420 and NV12 planes... ");
+    bmap::Image blocks(w - 1, h - 1);
+    for (int y = 0; y < h - 1; y++) {
+        for (int x = 0; x < w - 1; x++) blocks(x, y) = moved(x & ~1, (y + 1) & ~1);
+    }
+    const int bw = w - 1, bh = h - 1, cw = (bw + 1) / 2, chroma = cw * ((bh + 1) / 2);
+    std::vector<std::uint8_t> i420(bw * bh + 2 * chroma), nv12(i420.size()), top(3 * bw);
+    ok = bmp_to_i420(blocks.get(), BMP_COLOR_YCBCR709_LIMITED, i420.data(), bw, i420.data() + bw * bh, cw,
+                           i420.data() + bw * bh + chroma, cw) == BMP_SUCCESS &&
+         bmp_to_nv12(blocks.get(), BMP_COLOR_YCBCR709_LIMITED, nv12.data(), bw, nv12.data() + bw * bh, 2 * cw) ==
+             BMP_SUCCESS &&
+         bmp_to_nv12(blocks.get(), BMP_COLOR_LAB, nv12.data(), bw, nv12.data() + bw * bh, 2 * cw) ==
+             BMP_ERR_INVALID_ARGUMENT;
+    bmp_color_from_bgr(top.data(), &blocks(0, bh - 1), bw, BMP_COLOR_YCBCR709_LIMITED);
+    for (int i = 0; ok && i < bw; i++) ok = i420[i] == top[3 * i];
+    for (int i = 0; ok && i < chroma; i++) {
+        ok = nv12[bw * bh + 2 * i] == i420[bw * bh + i] && nv12[bw * bh + 2 * i + 1] == i420[bw * bh + chroma + i];
+    }
+    bmap::Image decoded(bw, bh);
+    ok = ok && bmp_from_nv12(decoded.get(), BMP_COLOR_YCBCR709_LIMITED, nv12.data(), bw, nv12.data() + bw * bh,
+                             2 * cw) == BMP_SUCCESS;
+    const std::uint8_t* pe = &blocks.data()->blue;
+    const std::uint8_t* pr = &decoded.data()->blue;
+    for (int i = 0; ok && i < 3 * bw * bh; i++) ok = pe[i] - pr[i] <= 3 && pr[i] - pe[i] <= 3;
+    if (!ok) {
+        std::printf("FAILED! (I420/NV12 planes differ or do not round-trip)\n");
+        return 1;
+    }
+    std::printf("Success!\n");
+
+    // 8. Expression Templates
+    // A fused expression must equal the separate C passes followed by the same arithmetic
+    std::printf("[8/9] Evaluating fused point expressions... ");
+    bmap::Image fused = bmap::Image::load("assets/airplane.bmp");
+    bmap::Image passes = fused.clone();
+    bmap::Image original = fused.clone();
+    const Pixel inside = original(7, 7);
+    const Pixel outside = original(8, 8);
+    fused = bmap::invert(bmap::gray(fused)) * 1.5f + 10;
+    passes.grayscale().invert();
+    for (auto row : passes.rows()) {
+        for (Pixel& p : row) {
+            float v = p.red * 1.5f + 10;
+            p.blue = p.green = p.red = static_cast<std::uint8_t>(v > 255.0f ? 255.0f : v + 0.5f);
+        }
+    }
+    bool fused_ok = std::memcmp(fused.data(), passes.data(), 512 * 512 * sizeof(Pixel)) == 0;
+
+    // Channel selection into a ROI, and a size mismatch must be rejected
+    bmap::assign(original.view().subview(0, 0, 8, 8),
+                 bmap::merge(bmap::channel<bmap::Channel::Red>(original.view().subview(0, 0, 8, 8)), 0, 255));
+    Pixel roi = original(7, 7);
+
+    // 0 / 0 is NaN, which must store as 0 like any other out-of-range value
+    bmap::Image black(4, 4);
+    for (auto row : black.rows()) {
+        for (Pixel& p : row) p = Pixel{0, 0, 0};
+    }
+    bmap::Image nan_image(4, 4);
+    nan_image = black / black;
+    fused_ok = fused_ok && nan_image(1, 1).green == 0 && nan_image(3, 3).red == 0;
+    bool threw = false;
+    try {
+        fused = bmap::invert(passes.view().subview(0, 0, 4, 4));
+    } catch (const bmap::Error&) {
+        threw = true;
+    }
+    if (!fused_ok || !threw || roi.blue != inside.red || roi.green != 0 || roi.red != 255 ||
+        std::memcmp(&original(8, 8), &outside, sizeof(Pixel)) != 0) {
+        std::printf("FAILED! (fused: %d, size check: %d)\n", fused_ok, threw);
+        return 1;
+    }
+    std::printf("Success!\n");
+
+    // 9. Compile-Time Tables
+    // constexpr tables must match the static C tables bit for bit
+    std::printf("[9/9] Checking compile-time tables... ");
+    constexpr auto halve = bmap::make_resample_phases<2, 1, bmap::filters::Triangle>();
+    constexpr auto cubic = bmap::make_resample_phases<1, 2, bmap::filters::CatmullRom>();
+    static_assert(halve.weights[0].size() == 4 && cubic.weights[0].size() == 4, "unexpected tap count");
+    int phase_sum = 0;
+    for (auto weight : cubic.weights[1]) phase_sum += weight;
+    if (std::memcmp(bmap::srgb_to_linear16.data(), bmp_srgb_to_linear16, sizeof(bmp_srgb_to_linear16)) != 0 ||
+        std::memcmp(bmap::linear12_to_srgb.data(), bmp_linear12_to_srgb, sizeof(bmp_linear12_to_srgb)) != 0 ||
+        std::memcmp(bmap::lab_f16.data(), bmp_lab_f16, sizeof(bmp_lab_f16)) != 0 ||
+        phase_sum != 16384 || halve.first[0] != -1 || bmap::luma709.apply(Pixel{255, 255, 255}) != 255) {
+        std::printf("FAILED! (constexpr tables differ from the C tables)\n");
+        return 1;
+    }
+    std::printf("Success!\n");
+
+    std::printf("\n--- C++ Test Suite Completed Successfully! ---\n");
+    return 0;
+}
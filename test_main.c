@@ -5,8 +5,31 @@
  * @date 2026
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include "bmap.h"
+#include <limits.h>
+#include <pthread.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static void* run_daemon(void* socket_path) {
+    bmp_daemon_run((const char*)socket_path, 2);
+    return NULL;
+}
+
+static void invert_span(Pixel* row, int count, int x, int y, void* user) {
+    (void)x;
+    (void)y;
+    (void)user;
+    for (int i = 0; i < count; i++) {
+        row[i].blue = 255 - row[i].blue;
+        row[i].green = 255 - row[i].green;
+        row[i].red = 255 - row[i].red;
+    }
+}
 
 int main() {
     BMPError err;
@@ -15,7 +38,7 @@ int main() {
 
     // 1. Loading Test
     // Using airplane.bmp from the assets folder as seen in your directory structure
-    printf("[1/5] Loading image (assets/airplane.bmp)... ");
+    printf("[1/16] Loading image (assets/airplane.bmp)... ");
     BMPImage* img = bmp_load("assets/airplane.bmp", &err);
     if (!img) {
         printf("FAILED! Error Code: %d\n", err);
@@ -24,29 +47,534 @@ int main() {
     }
     printf("Success! (%dx%d)\n", img->width, img->height);
 
-    // 2. Filter Tests
-    printf("[2/5] Applying filters (Grayscale & Invert)... ");
+    // 2. Region & Tile Cache Tests
+    // A region read must match the same rectangle of the fully loaded image
+    printf("[2/16] Reading regions and cached tiles... ");
+    BMPImage* region = bmp_load_region("assets/airplane.bmp", 100, 50, 64, 32, &err);
+    int region_ok = region && region->width == 64 && region->height == 32;
+    for (int y = 0; region_ok && y < region->height; y++) {
+        region_ok = memcmp(&region->data[y * region->width],
+                           &img->data[(50 + y) * img->width + 100],
+                           region->width * sizeof(Pixel)) == 0;
+    }
+    bmp_free(region);
+
+    region = bmp_load_region_parallel("assets/airplane.bmp", 0, 0, img->width, img->height, 4, &err);
+    region_ok = region_ok && region &&
+                memcmp(region->data, img->data, (size_t)img->width * img->height * sizeof(Pixel)) == 0;
+    bmp_free(region);
+
+    // A rectangle starting far left of the image is clipped to the part that overlaps it
+    region = bmp_load_region("assets/airplane.bmp", INT_MIN + 10, 0, INT_MAX, 4, &err);
+    region_ok = region_ok && region && region->width == 9 && region->height == 4 &&
+                memcmp(region->data, img->data, 9 * sizeof(Pixel)) == 0;
+    bmp_free(region);
+
+    // Bulk access: an RGB patch blitted half off the corner lands swizzled back, and fills clip
+    uint8_t patch[16][32 * 3];
+    BMPImage* canvas = bmp_clone(img, NULL);
+    region_ok = region_ok && canvas &&
+                bmp_read_rect(img, 100, 50, 32, 16, patch, sizeof(patch[0]), BMP_ORDER_RGB) == BMP_SUCCESS &&
+                patch[1][0] == img->data[51 * img->width + 100].red &&
+                bmp_read_rect(img, 500, 0, 32, 16, patch, 0, BMP_ORDER_RGB) == BMP_ERR_INVALID_ARGUMENT;
+    if (region_ok) {
+        bmp_fill_rect(canvas, -10, -10, 50, 30, (Pixel){ 255, 255, 255 });
+        bmp_fill_span(canvas, 510, 0, 100, (Pixel){ 1, 2, 3 });
+        region_ok = bmp_write_rect(canvas, -8, -4, 32, 16, patch, 0, BMP_ORDER_RGB) == BMP_SUCCESS &&
+                    memcmp(&canvas->data[0], &img->data[54 * img->width + 108], 24 * sizeof(Pixel)) == 0 &&
+                    canvas->data[12 * img->width + 30].red == 255 && canvas->data[511].blue == 1 &&
+                    memcmp(&canvas->data[20 * img->width], &img->data[20 * img->width], sizeof(Pixel)) == 0 &&
+                    memcmp(&canvas->data[509], &img->data[509], sizeof(Pixel)) == 0;
+    }
+    bmp_free(canvas);
+
+    BMPOperation ops[] = { BMP_OP_INVERT };
+    bmp_cache_configure(1 << 20, 128);
+    BMPImage* tile = bmp_cache_get_tile("assets/airplane.bmp", 1, 2, ops, 1, &err);
+    BMPImage* cached = bmp_cache_get_tile("assets/airplane.bmp", 1, 2, ops, 1, &err);
+    int cache_ok = tile && cached && bmp_cache_usage() == 128 * 128 * sizeof(Pixel) &&
+                   memcmp(tile->data, cached->data, 128 * 128 * sizeof(Pixel)) == 0 &&
+                   tile->data[0].red == 255 - img->data[256 * img->width + 128].red;
+    bmp_free(tile);
+    bmp_free(cached);
+
+    // An op id that only matches the cached tile's op in its low byte is rejected, not served from the cache
+    BMPOperation bad_ops[] = { (BMPOperation)(BMP_OP_INVERT + 256) };
+    cached = bmp_cache_get_tile("assets/airplane.bmp", 1, 2, bad_ops, 1, &err);
+    cache_ok = cache_ok && !cached && err == BMP_ERR_INVALID_ARGUMENT;
+
+    // Rewriting a file in place with the same size within the same second must not hit the old tile
+    BMPImage* rewritten = bmp_create(8, 8, NULL);
+    cache_ok = cache_ok && rewritten;
+    if (cache_ok) {
+        bmp_fill_rect(rewritten, 0, 0, 8, 8, (Pixel){ 255, 255, 255 });
+        tile = bmp_save(rewritten, "test_output_cache.bmp") == BMP_SUCCESS ?
+               bmp_cache_get_tile("test_output_cache.bmp", 0, 0, NULL, 0, &err) : NULL;
+        bmp_fill_rect(rewritten, 0, 0, 8, 8, (Pixel){ 0, 0, 0 });
+        nanosleep(&(struct timespec){ 0, 20000000 }, NULL);
+        cached = bmp_save(rewritten, "test_output_cache.bmp") == BMP_SUCCESS ?
+                 bmp_cache_get_tile("test_output_cache.bmp", 0, 0, NULL, 0, &err) : NULL;
+        cache_ok = tile && cached && tile->data[0].red == 255 && cached->data[0].red == 0;
+        bmp_free(tile);
+        bmp_free(cached);
+        remove("test_output_cache.bmp");
+    }
+    bmp_free(rewritten);
+    bmp_cache_clear();
+    if (!region_ok || !cache_ok) {
+        printf("FAILED! (region: %d, cache: %d)\n", region_ok, cache_ok);
+        bmp_free(img);
+        return 1;
+    }
+    printf("Success!\n");
+
+    // 3. Drawing Tests
+    // A polygon rectangle equals the rect fill, a circle outline lies on its disc, lines clip
+    printf("[3/16] Drawing shapes... ");
+    BMPImage* drawn = bmp_create(64, 48, NULL);
+    BMPImage* filled = bmp_create(64, 48, NULL);
+    const int quad[] = { 5, 40, 5, -10, 70, -10, 70, 40 };
+    Pixel red = { 0, 0, 255 }, green = { 0, 255, 0 };
+    int draw_ok = drawn && filled;
+    if (draw_ok) {
+        bmp_fill_rect(drawn, 0, 0, 64, 48, (Pixel){ 0, 0, 0 });
+        bmp_fill_rect(filled, 0, 0, 64, 48, (Pixel){ 0, 0, 0 });
+        bmp_fill_rect(filled, 5, 0, 59, 40, red);
+        draw_ok = bmp_fill_polygon(drawn, quad, 4, red) == BMP_SUCCESS &&
+                  memcmp(drawn->data, filled->data, 64 * 48 * sizeof(Pixel)) == 0;
+        bmp_fill_circle(filled, 20, 20, 15, green);
+        bmp_draw_circle(drawn, 20, 20, 15, green);
+        bmp_draw_line(drawn, -100, -50, 200, 100, (Pixel){ 255, 0, 0 });
+        for (int i = 0; draw_ok && i < 64 * 48; i++) {
+            draw_ok = drawn->data[i].green == 0 || filled->data[i].green == 255;
+        }
+        draw_ok = draw_ok && drawn->data[35 * 64 + 20].green == 255 && drawn->data[20 * 64 + 20].green == 0 &&
+                  drawn->data[0].blue == 255 && drawn->data[32 * 64 + 63].blue == 255 && drawn->data[64].blue == 0;
+
+        // A line spanning almost the whole int range still steps exactly: y = (x + 1) / 2 around the origin
+        bmp_fill_rect(drawn, 0, 0, 64, 48, (Pixel){ 0, 0, 0 });
+        bmp_draw_line(drawn, -2000000000, -1000000000, 2000000000, 1000000000, red);
+        for (int x = 0; draw_ok && x < 64; x++) {
+            draw_ok = (x + 1) / 2 >= 48 || drawn->data[(x + 1) / 2 * 64 + x].red == 255;
+        }
+    }
+    bmp_free(drawn);
+    bmp_free(filled);
+    if (!draw_ok) {
+        printf("FAILED! (drawn shapes differ)\n");
+        bmp_free(img);
+        return 1;
+    }
+    printf("Success!\n");
+
+    // 4. Filter Tests
+    // Inverting by hand through row pointers and the row visitor must match the library filter
+    printf("[4/16] Applying filters (Grayscale & Invert)... ");
+    BMPImage* manual = bmp_clone(img, NULL);
     bmp_grayscale(img);
     bmp_invert(img);
-    printf("Done.\n");
+    int rows_ok = manual != NULL;
+    if (rows_ok) {
+        bmp_grayscale(manual);
+        BMP_FOR_EACH_ROW(manual, y, row) {
+            if (y >= manual->height / 2) break;
+            invert_span(row, manual->width, 0, y, NULL);
+        }
+        rows_ok = bmp_visit_rows(manual, 0, manual->height / 2, manual->width, manual->height - manual->height / 2,
+                                 invert_span, NULL) == BMP_SUCCESS &&
+                  bmp_visit_rows(manual, 1, 0, manual->width, 1, invert_span, NULL) == BMP_ERR_INVALID_ARGUMENT &&
+                  memcmp(manual->data, img->data, (size_t)img->width * img->height * sizeof(Pixel)) == 0 &&
+                  &bmp_row(img, 9)[5] == &img->data[9 * img->width + 5] &&
+                  bmp_pixel(img, 5, 9).red == bmp_get_pixel(img, 5, 9).red;
+    }
+    bmp_free(manual);
+    if (!rows_ok) {
+        printf("FAILED! (row access mismatch)\n");
+        bmp_free(img);
+        return 1;
+    }
+    printf("Done. (kernels: %s)\n", bmp_active_isa());
 
-    // 3. Transformation Tests
-    printf("[3/5] Applying transformations (Rotate & Flip)... ");
+    // 5. Transformation Tests
+    printf("[5/16] Applying transformations (Rotate & Flip)... ");
     bmp_rotate_right(img);
     bmp_flip_horizontal(img);
     printf("Done. New dimensions: %dx%d\n", img->width, img->height);
 
-    // 4. Saving Test
-    printf("[4/5] Saving processed image (test_output.bmp)... ");
+    // 6. Out-of-Core Tests
+    // The same chain on scratch-backed (out-of-core) storage must match the heap result
+    printf("[6/16] Processing out-of-core images... ");
+    BMPImage* mapped = bmp_load_mapped("assets/airplane.bmp", &err);
+    BMPOperation chain[] = { BMP_OP_GRAYSCALE, BMP_OP_INVERT, BMP_OP_ROTATE_RIGHT, BMP_OP_FLIP_HORIZONTAL };
+    if (!mapped || !bmp_is_mapped(mapped) || bmp_apply_operations(mapped, chain, 4) != BMP_SUCCESS ||
+        !bmp_is_mapped(mapped) ||
+        memcmp(mapped->data, img->data, (size_t)img->width * img->height * sizeof(Pixel)) != 0) {
+        printf("FAILED! (out-of-core result differs)\n");
+        bmp_free(mapped);
+        bmp_free(img);
+        return 1;
+    }
+    bmp_free(mapped);
+
+    // Wider than one rotation band, so source rows are released band by band
+    BMPImage* wide = bmp_create(2500, 3, NULL);
+    for (int i = 0; wide && i < 2500 * 3; i++) wide->data[i] = (Pixel){ (uint8_t)i, (uint8_t)(i >> 8), (uint8_t)(i >> 3) };
+    mapped = wide && bmp_save(wide, "test_output_wide.bmp") == BMP_SUCCESS ?
+             bmp_load_mapped("test_output_wide.bmp", &err) : NULL;
+    remove("test_output_wide.bmp");
+    if (mapped) {
+        bmp_rotate_right(mapped);
+        bmp_rotate_right(wide);
+    }
+    int wide_ok = mapped && bmp_is_mapped(mapped) && mapped->width == 3 &&
+                  memcmp(mapped->data, wide->data, 2500 * 3 * sizeof(Pixel)) == 0;
+    bmp_free(mapped);
+    bmp_free(wide);
+
+    // Shared (daemon) images stay in shared memory when resized or rotated, never in the scratch directory
+    bmp_set_scratch_directory("/nonexistent-bmap-scratch");
+    wide = bmp_client_create(8, 4, &err);
+    if (wide) {
+        bmp_resize(wide, 6, 2);
+        bmp_rotate_right(wide);
+    }
+    wide_ok = wide_ok && wide && bmp_is_mapped(wide) && wide->width == 2 && wide->height == 6;
+    bmp_free(wide);
+    bmp_set_scratch_directory(NULL);
+    if (!wide_ok) {
+        printf("FAILED! (mapped storage not kept)\n");
+        bmp_free(img);
+        return 1;
+    }
+    printf("Success!\n");
+
+    // 7. Daemon Tests
+    // The daemon must match too, for shared-memory images and staged heap and scratch-file images alike
+    printf("[7/16] Processing through the daemon... ");
+    pthread_t daemon;
+    if (pthread_create(&daemon, NULL, run_daemon, "test_bmapd.sock") != 0) {
+        printf("FAILED! (cannot start the daemon thread)\n");
+        bmp_free(img);
+        return 1;
+    }
+    BMPClient* client = NULL;
+    for (int attempt = 0; !client && attempt < 200; attempt++) {
+        client = bmp_client_connect("test_bmapd.sock", &err);
+        if (!client) nanosleep(&(struct timespec){ 0, 5000000 }, NULL);
+    }
+    BMPImage* shared = bmp_client_load("assets/airplane.bmp", &err);
+    BMPImage* heap = bmp_load("assets/airplane.bmp", &err);
+    mapped = bmp_load_mapped("assets/airplane.bmp", &err);
+    size_t bytes = (size_t)img->width * img->height * sizeof(Pixel);
+    int daemon_ok = client && shared && heap && mapped &&
+                    bmp_client_apply_operations(client, shared, chain, 4) == BMP_SUCCESS &&
+                    bmp_client_apply_operations(client, heap, chain, 4) == BMP_SUCCESS &&
+                    bmp_client_apply_operations(client, mapped, chain, 4) == BMP_SUCCESS &&
+                    shared->width == img->width && memcmp(shared->data, img->data, bytes) == 0 &&
+                    heap->width == img->width && memcmp(heap->data, img->data, bytes) == 0 &&
+                    mapped->width == img->width && memcmp(mapped->data, img->data, bytes) == 0;
+    bmp_free(shared);
+    bmp_free(heap);
+    bmp_free(mapped);
+    bmp_client_close(client);
+    bmp_daemon_stop();
+    pthread_join(daemon, NULL);
+    if (!daemon_ok) {
+        printf("FAILED! (daemon result differs)\n");
+        bmp_free(img);
+        return 1;
+    }
+    printf("Success!\n");
+
+    // 8. Sequence Tests
+    // A frame sequence reprocesses only the tile that changed, and a delta file replays both frames
+    printf("[8/16] Processing frame sequences and deltas... ");
+    BMPImage* frame = bmp_load("assets/airplane.bmp", &err);
+    BMPSequence* seq = bmp_sequence_create(64, chain, 4, &err);
+    BMPDeltaWriter* delta = bmp_delta_create("test_output.bmd", 64, 0, &err);
+    const BMPImage* out = frame && seq ? bmp_sequence_process(seq, frame, &err) : NULL;
+    int seq_ok = out && delta && bmp_delta_append(delta, frame) == BMP_SUCCESS &&
+                 memcmp(out->data, img->data, bytes) == 0;
+    uint8_t original = frame ? frame->data[100].red : 0;
+    if (seq_ok) {
+        frame->data[100].red ^= 0xFF;
+        seq_ok = bmp_delta_append(delta, frame) == BMP_SUCCESS;
+        out = bmp_sequence_process(seq, frame, &err);
+        bmp_apply_operations(frame, chain, 4);
+        seq_ok = seq_ok && out && bmp_sequence_dirty_tiles(seq) == 1 && memcmp(out->data, frame->data, bytes) == 0;
+    }
+    seq_ok = bmp_delta_finish(delta) == BMP_SUCCESS && seq_ok;
+    BMPDeltaReader* replay = bmp_delta_open("test_output.bmd", &err);
+    const BMPImage* replayed = replay && bmp_delta_frame_count(replay) == 2 ? bmp_delta_read(replay, &err) : NULL;
+    seq_ok = seq_ok && replayed && replayed->data[100].red == original;
+    replayed = seq_ok ? bmp_delta_read(replay, &err) : NULL;
+    seq_ok = seq_ok && replayed && replayed->data[100].red != original && !bmp_delta_read(replay, &err);
+    bmp_delta_close(replay);
+    remove("test_output.bmd");
+    bmp_sequence_free(seq);
+    bmp_free(frame);
+
+    // Tile edges past the limit are refused rather than overflowing the tile arithmetic
+    seq = bmp_sequence_create(BMP_SEQUENCE_MAX_TILE + 1, chain, 4, &err);
+    delta = bmp_delta_create("test_output.bmd", BMP_SEQUENCE_MAX_TILE + 1, 0, &err);
+    seq_ok = seq_ok && !seq && !delta && err == BMP_ERR_INVALID_ARGUMENT;
+    bmp_sequence_free(seq);
+    delta = bmp_delta_create("test_output.bmd", BMP_SEQUENCE_MAX_TILE, 0, &err);
+    seq_ok = seq_ok && delta && bmp_delta_append(delta, img) == BMP_SUCCESS && bmp_delta_finish(delta) == BMP_SUCCESS;
+    FILE* delta_file = seq_ok ? fopen("test_output.bmd", "r+b") : NULL;
+    if (delta_file) {
+        static const uint8_t huge_tile[4] = { 0xff, 0xff, 0xff, 0x7f };
+        fseek(delta_file, 12, SEEK_SET);
+        fwrite(huge_tile, 1, sizeof(huge_tile), delta_file);
+        fclose(delta_file);
+    }
+    replay = delta_file ? bmp_delta_open("test_output.bmd", &err) : NULL;
+    seq_ok = seq_ok && delta_file && !replay && err == BMP_ERR_INVALID_FORMAT;
+    bmp_delta_close(replay);
+
+    // A frame size whose first keyframe cannot fit in the file is refused before anything is allocated
+    delta = bmp_delta_create("test_output.bmd", 64, 0, &err);
+    seq_ok = seq_ok && delta && bmp_delta_append(delta, img) == BMP_SUCCESS && bmp_delta_finish(delta) == BMP_SUCCESS;
+    delta_file = seq_ok ? fopen("test_output.bmd", "r+b") : NULL;
+    if (delta_file) {
+        static const uint8_t huge_size[8] = { 0x30, 0x75, 0, 0, 0x30, 0x75, 0, 0 };
+        fseek(delta_file, 16, SEEK_SET);
+        fwrite(huge_size, 1, sizeof(huge_size), delta_file);
+        fclose(delta_file);
+    }
+    replay = delta_file ? bmp_delta_open("test_output.bmd", &err) : NULL;
+    seq_ok = seq_ok && delta_file && !replay && err == BMP_ERR_INVALID_FORMAT;
+    bmp_delta_close(replay);
+    remove("test_output.bmd");
+    if (!seq_ok) {
+        printf("FAILED! (sequence result differs)\n");
+        bmp_free(img);
+        return 1;
+    }
+    printf("Success!\n");
+
+    // 9. Saving Test
+    printf("[9/16] Saving processed image (test_output.bmp)... ");
     err = bmp_save(img, "test_output.bmp");
     if (err != BMP_SUCCESS) {
         printf("FAILED! Error Code: %d\n", err);
-    } else {
-        printf("Success!\n");
+        bmp_free(img);
+        return 1;
+    }
+    printf("Success!\n");
+
+    // 10. Reload & Resize Tests
+    // Reloading into an existing image reuses it; a same-size resize is an exact copy
+    printf("[10/16] Reloading and resizing into existing images... ");
+    BMPImage* reload = bmp_create(1, 1, NULL);
+    int reload_ok = reload && bmp_load_into(reload, "test_output.bmp") == BMP_SUCCESS;
+    if (reload_ok) bmp_resize(reload, img->width, img->height);
+    reload_ok = reload_ok && reload->width == img->width && reload->height == img->height &&
+                memcmp(reload->data, img->data, bytes) == 0;
+    if (reload_ok) bmp_resize(reload, img->width / 2, img->height / 3);
+    reload_ok = reload_ok && reload->width == img->width / 2 && reload->height == img->height / 3;
+
+    // Resizing into a caller-owned image matches bmp_resize()
+    BMPImage* resized = bmp_create(img->width / 2, img->height / 3, NULL);
+    reload_ok = reload_ok && resized && bmp_resize_into(img, resized, 0) == BMP_SUCCESS &&
+                memcmp(resized->data, reload->data, (size_t)resized->width * resized->height * sizeof(Pixel)) == 0;
+    bmp_free(resized);
+
+    // A header claiming zero rows is rejected and leaves the target image untouched
+    BMPImage* flat = bmp_create(4, 1, NULL);
+    FILE* flat_file = flat && bmp_save(flat, "test_output_flat.bmp") == BMP_SUCCESS ?
+                      fopen("test_output_flat.bmp", "r+b") : NULL;
+    if (flat_file) {
+        static const uint8_t zero_rows[4] = { 0, 0, 0, 0 };
+        fseek(flat_file, 22, SEEK_SET);
+        fwrite(zero_rows, 1, sizeof(zero_rows), flat_file);
+        fclose(flat_file);
+    }
+    reload_ok = reload_ok && flat_file && bmp_load_into(reload, "test_output_flat.bmp") == BMP_ERR_INVALID_FORMAT &&
+                reload->width == img->width / 2 && reload->height == img->height / 3;
+
+    // A file cut short inside the pixel rows fails instead of keeping the previous file's pixels
+    uint8_t short_head[200];
+    FILE* short_file = fopen("test_output.bmp", "rb");
+    size_t short_size = short_file ? fread(short_head, 1, sizeof(short_head), short_file) : 0;
+    if (short_file) fclose(short_file);
+    short_file = short_size == sizeof(short_head) ? fopen("test_output_cut.bmp", "wb") : NULL;
+    if (short_file) {
+        short_size = fwrite(short_head, 1, sizeof(short_head), short_file);
+        fclose(short_file);
+    }
+    reload_ok = reload_ok && short_size == sizeof(short_head) &&
+                bmp_load_into(reload, "test_output_cut.bmp") == BMP_ERR_INVALID_FORMAT &&
+                reload->width == img->width && reload->height == img->height;
+    bmp_free(flat);
+    bmp_free(reload);
+    remove("test_output_flat.bmp");
+    remove("test_output_cut.bmp");
+    if (!reload_ok) {
+        printf("FAILED! (reload or resize mismatch)\n");
+        bmp_free(img);
+        return 1;
+    }
+    printf("Success!\n");
+
+    // 11. Comparison Tests
+    // A reloaded copy is identical under every metric, and its rescaled copy is a perceptual near-duplicate
+    printf("[11/16] Comparing images... ");
+    BMPImage* copy = bmp_load("test_output.bmp", &err);
+    BMPCompareResult cmp;
+    int compare_ok = copy && bmp_compare(copy, img, BMP_COMPARE_EXACT, 1, NULL, &cmp) == BMP_SUCCESS &&
+                     cmp.first_x < 0 && bmp_compare(copy, img, BMP_COMPARE_SSIM, 2, NULL, &cmp) == BMP_SUCCESS &&
+                     cmp.max_abs_diff == 0 && cmp.mse == 0 && cmp.ssim == 1.0;
+    if (compare_ok) bmp_resize(copy, img->width / 2, img->height / 3);
+    const BMPImage* pair[] = { img, copy };
+    uint64_t hashes[2];
+    for (int kind = BMP_PERCEPTUAL_AHASH; compare_ok && kind <= BMP_PERCEPTUAL_PHASH; kind++) {
+        compare_ok = bmp_perceptual_hash_batch(pair, 2, (BMPPerceptualHash)kind, 2, hashes) == BMP_SUCCESS &&
+                     bmp_hamming_distance(hashes[0], hashes[1]) <= 6;
+    }
+    bmp_free(copy);
+    if (!compare_ok) {
+        printf("FAILED! (comparison or perceptual hash mismatch)\n");
+        bmp_free(img);
+        return 1;
+    }
+    printf("Success!\n");
+
+    // 12. Hash Tests
+    // Hashing rows during the load must equal hashing afterwards, and both must be reference XXH3
+    printf("[12/16] Hashing pixels... ");
+    uint64_t loaded_hash = 0;
+    BMPHash128 loaded_hash128 = {0, 0};
+    copy = bmp_load_hashed("test_output.bmp", &loaded_hash, &loaded_hash128, &err);
+    int hash_ok = copy && loaded_hash == bmp_hash(img) &&
+                  loaded_hash128.low == loaded_hash && loaded_hash128.high == bmp_hash128(img).high;
+    bmp_free(copy);
+    copy = bmp_create(64, 64, NULL);
+    for (int i = 0; copy && i < 64 * 64; i++) {
+        copy->data[i] = (Pixel){ (uint8_t)i, (uint8_t)(i >> 8), (uint8_t)(i * 7) };
+    }
+    hash_ok = hash_ok && copy && bmp_hash(copy) == 0x48299a92a19c050bULL &&
+              bmp_hash128(copy).high == 0x2e9d4628137b06f9ULL;
+
+    // A file cut short inside the pixel rows is rejected rather than hashed over missing rows
+    uint8_t cut_head[200];
+    FILE* cut_file = copy && bmp_save(copy, "test_output_cut.bmp") == BMP_SUCCESS ?
+                     fopen("test_output_cut.bmp", "rb") : NULL;
+    if (cut_file) {
+        hash_ok = hash_ok && fread(cut_head, 1, sizeof(cut_head), cut_file) == sizeof(cut_head);
+        fclose(cut_file);
+        cut_file = fopen("test_output_cut.bmp", "wb");
+    }
+    if (cut_file) {
+        hash_ok = hash_ok && fwrite(cut_head, 1, sizeof(cut_head), cut_file) == sizeof(cut_head);
+        fclose(cut_file);
+    }
+    bmp_free(copy);
+    copy = bmp_load_hashed("test_output_cut.bmp", &loaded_hash, NULL, &err);
+    hash_ok = hash_ok && cut_file && !copy && err == BMP_ERR_INVALID_FORMAT;
+    copy = bmp_load("test_output_cut.bmp", &err);
+    hash_ok = hash_ok && !copy && err == BMP_ERR_INVALID_FORMAT;
+    remove("test_output_cut.bmp");
+    if (!hash_ok) {
+        printf("FAILED! (hash differs from XXH3)\n");
+        bmp_free(img);
+        return 1;
+    }
+    printf("Success!\n");
+
+    // 13. Linear Light Tests
+    // In linear light a 50% mix and a downscaled checker of black and white are sRGB 188, not 128
+    printf("[13/16] Blending and resizing in linear light... ");
+    BMPImage* black = bmp_create(2, 2, NULL);
+    BMPImage* white = bmp_create(2, 2, NULL);
+    int linear_ok = black && white;
+    if (linear_ok) {
+        bmp_fill_rect(white, 0, 0, 2, 2, (Pixel){ 255, 255, 255 });
+        bmp_fill_rect(black, 0, 0, 2, 2, (Pixel){ 0, 0, 0 });
+        bmp_blend(black, white, 128, BMP_BLEND_OVER, BMP_MIX_LINEAR_LIGHT);
+        int mixed = black->data[0].green;
+        bmp_fill_rect(black, 0, 0, 2, 2, (Pixel){ 255, 255, 255 });
+        bmp_fill_span(black, 0, 0, 1, (Pixel){ 0, 0, 0 });
+        bmp_fill_span(black, 1, 1, 1, (Pixel){ 0, 0, 0 });
+        BMPImage* dot = bmp_create(1, 1, NULL);
+        linear_ok = dot && bmp_resize_into(black, dot, BMP_MIX_LINEAR_LIGHT) == BMP_SUCCESS &&
+                    mixed == 188 && dot->data[0].red == 188;
+        // The flag is per call: the same checker without it averages the bytes
+        linear_ok = linear_ok && bmp_resize_into(black, dot, 0) == BMP_SUCCESS && dot->data[0].red == 128;
+        bmp_free(dot);
+    }
+    bmp_free(white);
+    bmp_free(black);
+    if (!linear_ok) {
+        printf("FAILED! (linear-light result differs)\n");
+        bmp_free(img);
+        return 1;
+    }
+    printf("Success!\n");
+
+    // 14. Codec Tests
+    // QOI must round-trip losslessly, both through a file and in memory
+    printf("[14/16] Round-tripping QOI and PNM... ");
+    size_t qoi_size = 0;
+    copy = bmp_save_qoi(img, "test_output.qoi") == BMP_SUCCESS ? bmp_load_qoi("test_output.qoi", &err) : NULL;
+    int codec_ok = copy && memcmp(copy->data, img->data, bytes) == 0;
+    bmp_free(copy);
+    void* qoi = bmp_encode_qoi(img, &qoi_size, &err);
+    copy = qoi ? bmp_decode_qoi(qoi, qoi_size, &err) : NULL;
+    codec_ok = codec_ok && copy && qoi_size < bytes && memcmp(copy->data, img->data, bytes) == 0;
+    bmp_free(copy);
+    free(qoi);
+    remove("test_output.qoi");
+
+    // So must PPM in memory and PAM on disk
+    void* ppm = bmp_encode_pnm(img, BMP_PNM_PPM, &qoi_size, &err);
+    copy = ppm ? bmp_decode_pnm(ppm, qoi_size, &err) : NULL;
+    codec_ok = codec_ok && copy && memcmp(copy->data, img->data, bytes) == 0;
+    bmp_free(copy);
+    free(ppm);
+    copy = bmp_save_pnm(img, "test_output.pam", BMP_PNM_PAM) == BMP_SUCCESS ?
+           bmp_load_pnm("test_output.pam", &err) : NULL;
+    codec_ok = codec_ok && copy && memcmp(copy->data, img->data, bytes) == 0;
+    bmp_free(copy);
+    remove("test_output.pam");
+    if (!codec_ok) {
+        printf("FAILED! (codec round trip differs)\n");
+        bmp_free(img);
+        return 1;
+    }
+    printf("Success!\n");
+
+    // 15. Tiled Pyramid Tests
+    // A compressed tiled pyramid reassembles level 0 exactly and halves each level
+    printf("[15/16] Reading tiled pyramids... ");
+    BMPTiledLevel level;
+    BMPTiledReader* tiled = bmp_save_tiled(img, "test_output.bmt", 64, 0, 1) == BMP_SUCCESS ?
+                            bmp_tiled_open("test_output.bmt", &err) : NULL;
+    copy = tiled ? bmp_tiled_read_level(tiled, 0, &err) : NULL;
+    int tiled_ok = copy && memcmp(copy->data, img->data, bytes) == 0 &&
+                   bmp_tiled_level_info(tiled, bmp_tiled_level_count(tiled) - 1, &level) == BMP_SUCCESS &&
+                   level.tiles_x == 1 && level.tiles_y == 1;
+    bmp_free(copy);
+    bmp_tiled_close(tiled);
+
+    // A tile larger than the image holds the whole image; one whose raw size overflows the index is refused
+    tiled = bmp_save_tiled(img, "test_output.bmt", 32768, 1, 0) == BMP_SUCCESS ?
+            bmp_tiled_open("test_output.bmt", &err) : NULL;
+    copy = tiled ? bmp_tiled_read_tile(tiled, 0, 0, 0, &err) : NULL;
+    tiled_ok = tiled_ok && copy && copy->width == img->width && memcmp(copy->data, img->data, bytes) == 0 &&
+               bmp_save_tiled(img, "test_output.bmt", 32769, 1, 0) == BMP_ERR_INVALID_ARGUMENT;
+    bmp_free(copy);
+    bmp_tiled_close(tiled);
+    remove("test_output.bmt");
+    if (!tiled_ok) {
+        printf("FAILED! (tiled pyramid differs)\n");
+        bmp_free(img);
+        return 1;
     }
+    printf("Success!\n");
 
-    // 5. Memory Cleanup
-    printf("[5/5] Freeing allocated memory... ");
+    // 16. Memory Cleanup
+    printf("[16/16] Freeing allocated memory... ");
     bmp_free(img);
     printf("Done.\n");
 
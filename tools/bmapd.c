@@ -0,0 +1,60 @@
+/**
+ * @file bmapd.c
+ * @brief Standalone bmap daemon; see bmp_daemon_run().
+ * Processes that link libbmap call bmp_client_connect() and the
+ * bmp_client_* functions to run their operation chains here, sharing one
+ * pool of worker threads instead of each starting their own.
+ *
+ * Usage: bmapd [-s <socket>] [-j <threads>]
+ *   -s <socket>   Socket path (default: /tmp/bmapd.sock)
+ *   -j <threads>  Worker threads (default: number of CPUs)
+ * @author Arda Aksu
+ * @date 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bmap.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void on_signal(int sig) {
+    (void)sig;
+    bmp_daemon_stop();
+}
+
+int main(int argc, char** argv) {
+    const char* socket_path = BMP_DAEMON_SOCKET;
+    int threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: bmapd [-s <socket>] [-j <threads>]\n");
+            return 2;
+        }
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    printf("bmapd: serving on %s (kernels: %s)\n", socket_path, bmp_active_isa());
+    fflush(stdout);
+
+    BMPError err = bmp_daemon_run(socket_path, threads);
+    if (err != BMP_SUCCESS) {
+        fprintf(stderr, "bmapd: cannot serve on %s (error %d)\n", socket_path, err);
+        return 1;
+    }
+    printf("bmapd: stopped\n");
+    return 0;
+}
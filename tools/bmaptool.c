@@ -0,0 +1,389 @@
+/**
+ * @file bmaptool.c
+ * @brief Command-line batch processor built on the bmap library.
+ * Applies one operation chain to many BMP files in a single process, using a
+ * pool of worker threads. Each worker owns two images that it reuses across
+ * files: files are loaded into one, and rotations and resizes write into the
+ * other before the two swap, so steady-state processing does not allocate.
+ * The tool prints per-stage timing statistics at the end. Outputs keep the
+ * input file names, so two inputs with the same name are rejected up front.
+ *
+ * Usage: bmaptool [options] -o <dir> <input.bmp | 'glob*.bmp'>...
+ *   --gray            Convert to grayscale
+ *   --invert          Invert colors
+ *   --flip            Flip horizontally
+ *   --rotate <deg>    Rotate clockwise by 90, 180 or 270 degrees
+ *   --resize <N%|WxH> Resize by percentage or to an exact size
+ *   -j <threads>      Worker threads (default: number of CPUs)
+ *   -o <dir>          Output directory (required)
+ * @author Arda Aksu
+ * @date 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bmap.h"
+#include <glob.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_STAGES 32
+#define PATH_BUFFER 4096
+
+typedef enum {
+    STAGE_GRAY,
+    STAGE_INVERT,
+    STAGE_FLIP,
+    STAGE_ROTATE,   /* arg: number of quarter turns */
+    STAGE_RESIZE    /* arg: percent (> 0) or exact size in width/height */
+} StageKind;
+
+typedef struct {
+    StageKind kind;
+    int arg;
+    int width, height;
+    char name[32];
+} Stage;
+
+typedef struct {
+    double total_ms;
+    double max_ms;
+    long count;
+} StageStats;
+
+/* Shared job state; workers claim files through next_file */
+typedef struct {
+    char** files;
+    int file_count;
+    atomic_int next_file;
+    atomic_int failures;
+    const Stage* stages;
+    int stage_count;
+    const char* output_dir;
+    pthread_mutex_t stats_lock;
+    StageStats load, save;
+    StageStats stage_stats[MAX_STAGES];
+} Job;
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static void stats_add(StageStats* stats, double ms) {
+    stats->total_ms += ms;
+    stats->count++;
+    if (ms > stats->max_ms) stats->max_ms = ms;
+}
+
+static void stats_merge(StageStats* into, const StageStats* from) {
+    into->total_ms += from->total_ms;
+    into->count += from->count;
+    if (from->max_ms > into->max_ms) into->max_ms = from->max_ms;
+}
+
+/* A worker-owned image and the number of pixels its buffer can hold */
+typedef struct {
+    BMPImage* image;
+    size_t capacity;
+} Buffer;
+
+/* Gives the buffer a width x height shape, reallocating only when it is too small */
+static BMPImage* buffer_fit(Buffer* buffer, int width, int height) {
+    size_t count = (size_t)width * height;
+    if (count > buffer->capacity) {
+        BMPImage* grown = bmp_create(width, height, NULL);
+        if (!grown) return NULL;
+        bmp_free(buffer->image);
+        buffer->image = grown;
+        buffer->capacity = count;
+    }
+    buffer->image->width = width;
+    buffer->image->height = height;
+    return buffer->image;
+}
+
+static void buffer_swap(Buffer* a, Buffer* b) {
+    Buffer tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+/* Runs one stage on cur; out-of-place stages write into spare and swap it in */
+static BMPError run_stage(Buffer* cur, Buffer* spare, const Stage* stage) {
+    BMPImage* img = cur->image;
+    BMPImage* dst;
+    switch (stage->kind) {
+        case STAGE_GRAY:   bmp_grayscale(img); break;
+        case STAGE_INVERT: bmp_invert(img); break;
+        case STAGE_FLIP:   bmp_flip_horizontal(img); break;
+        case STAGE_ROTATE:
+            for (int i = 0; i < stage->arg; i++) {
+                dst = buffer_fit(spare, cur->image->height, cur->image->width);
+                if (!dst) return BMP_ERR_MALLOC_FAILED;
+                BMPError err = bmp_rotate_right_into(cur->image, dst);
+                if (err != BMP_SUCCESS) return err;
+                buffer_swap(cur, spare);
+            }
+            break;
+        case STAGE_RESIZE: {
+            int w = stage->width, h = stage->height;
+            if (stage->arg > 0) {
+                w = (int)((int64_t)img->width * stage->arg / 100);
+                h = (int)((int64_t)img->height * stage->arg / 100);
+                if (w < 1) w = 1;
+                if (h < 1) h = 1;
+            }
+            dst = buffer_fit(spare, w, h);
+            if (!dst) return BMP_ERR_MALLOC_FAILED;
+            BMPError err = bmp_resize_into(img, dst, 0);
+            if (err != BMP_SUCCESS) return err;
+            buffer_swap(cur, spare);
+            break;
+        }
+    }
+    return BMP_SUCCESS;
+}
+
+static const char* file_name(const char* path) {
+    const char* base = strrchr(path, '/');
+    return base ? base + 1 : path;
+}
+
+static int compare_file_names(const void* a, const void* b) {
+    return strcmp(file_name(*(char* const*)a), file_name(*(char* const*)b));
+}
+
+/* Reports every pair of inputs that would be written to the same output file */
+static int find_name_collisions(char** files, int count) {
+    char** sorted = (char**)malloc((size_t)count * sizeof(char*));
+    if (!sorted) return -1;
+    memcpy(sorted, files, (size_t)count * sizeof(char*));
+    qsort(sorted, (size_t)count, sizeof(char*), compare_file_names);
+
+    int collisions = 0;
+    for (int i = 1; i < count; i++) {
+        if (strcmp(file_name(sorted[i - 1]), file_name(sorted[i])) == 0) {
+            fprintf(stderr, "bmaptool: %s and %s would both be written as %s\n",
+                    sorted[i - 1], sorted[i], file_name(sorted[i]));
+            collisions++;
+        }
+    }
+    free(sorted);
+    return collisions;
+}
+
+static void* worker(void* arg) {
+    Job* job = (Job*)arg;
+    StageStats load = {0}, save = {0}, stages[MAX_STAGES];
+    memset(stages, 0, sizeof(stages));
+
+    /* Two images per worker: bmp_load_into() reuses the current one, transforms write the spare */
+    Buffer cur = { bmp_create(1, 1, NULL), 1 }, spare = { bmp_create(1, 1, NULL), 1 };
+    if (!cur.image || !spare.image) {
+        bmp_free(cur.image);
+        bmp_free(spare.image);
+        atomic_fetch_add(&job->failures, 1);
+        return NULL;
+    }
+
+    for (;;) {
+        int index = atomic_fetch_add(&job->next_file, 1);
+        if (index >= job->file_count) break;
+        const char* input = job->files[index];
+
+        double start = now_ms();
+        BMPError err = bmp_load_into(cur.image, input);
+        stats_add(&load, now_ms() - start);
+        /* Even a failed load may have resized the buffer; its shape never overstates the allocation */
+        cur.capacity = (size_t)cur.image->width * cur.image->height;
+        if (err != BMP_SUCCESS) {
+            fprintf(stderr, "bmaptool: cannot load %s (error %d)\n", input, err);
+            atomic_fetch_add(&job->failures, 1);
+            continue;
+        }
+
+        for (int s = 0; s < job->stage_count && err == BMP_SUCCESS; s++) {
+            start = now_ms();
+            err = run_stage(&cur, &spare, &job->stages[s]);
+            stats_add(&stages[s], now_ms() - start);
+        }
+        if (err != BMP_SUCCESS) {
+            fprintf(stderr, "bmaptool: cannot process %s (error %d)\n", input, err);
+            atomic_fetch_add(&job->failures, 1);
+            continue;
+        }
+
+        char output[PATH_BUFFER];
+        snprintf(output, sizeof(output), "%s/%s", job->output_dir, file_name(input));
+
+        start = now_ms();
+        err = bmp_save(cur.image, output);
+        stats_add(&save, now_ms() - start);
+        if (err != BMP_SUCCESS) {
+            fprintf(stderr, "bmaptool: cannot save %s (error %d)\n", output, err);
+            atomic_fetch_add(&job->failures, 1);
+        }
+    }
+
+    bmp_free(cur.image);
+    bmp_free(spare.image);
+
+    pthread_mutex_lock(&job->stats_lock);
+    stats_merge(&job->load, &load);
+    stats_merge(&job->save, &save);
+    for (int s = 0; s < job->stage_count; s++) stats_merge(&job->stage_stats[s], &stages[s]);
+    pthread_mutex_unlock(&job->stats_lock);
+    return NULL;
+}
+
+static void print_stats(const char* name, const StageStats* stats) {
+    printf("  %-16s %8ld  %12.3f  %10.3f  %10.3f\n", name, stats->count, stats->total_ms,
+           stats->count ? stats->total_ms / stats->count : 0.0, stats->max_ms);
+}
+
+static void usage(void) {
+    fprintf(stderr,
+            "Usage: bmaptool [options] -o <dir> <input.bmp | 'glob*.bmp'>...\n"
+            "  --gray            Convert to grayscale\n"
+            "  --invert          Invert colors\n"
+            "  --flip            Flip horizontally\n"
+            "  --rotate <deg>    Rotate clockwise by 90, 180 or 270 degrees\n"
+            "  --resize <N%%|WxH> Resize by percentage or to an exact size\n"
+            "  -j <threads>      Worker threads (default: number of CPUs)\n"
+            "  -o <dir>          Output directory (required)\n");
+}
+
+static int add_stage(Stage* stages, int* count, StageKind kind, const char* name) {
+    if (*count >= MAX_STAGES) {
+        fprintf(stderr, "bmaptool: at most %d operations per chain\n", MAX_STAGES);
+        return 0;
+    }
+    Stage* stage = &stages[(*count)++];
+    memset(stage, 0, sizeof(*stage));
+    stage->kind = kind;
+    snprintf(stage->name, sizeof(stage->name), "%s", name);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    Stage stages[MAX_STAGES];
+    int stage_count = 0;
+    const char* output_dir = NULL;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+    glob_t inputs;
+    memset(&inputs, 0, sizeof(inputs));
+    int globbed = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        int has_value = i + 1 < argc;
+
+        if (strcmp(a, "--gray") == 0) {
+            if (!add_stage(stages, &stage_count, STAGE_GRAY, "gray")) return 2;
+        } else if (strcmp(a, "--invert") == 0) {
+            if (!add_stage(stages, &stage_count, STAGE_INVERT, "invert")) return 2;
+        } else if (strcmp(a, "--flip") == 0) {
+            if (!add_stage(stages, &stage_count, STAGE_FLIP, "flip")) return 2;
+        } else if (strcmp(a, "--rotate") == 0 && has_value) {
+            int degrees = atoi(argv[++i]);
+            if (degrees <= 0 || degrees % 90 != 0) {
+                fprintf(stderr, "bmaptool: --rotate expects a multiple of 90\n");
+                return 2;
+            }
+            if (!add_stage(stages, &stage_count, STAGE_ROTATE, argv[i])) return 2;
+            stages[stage_count - 1].arg = (degrees / 90) % 4;
+            snprintf(stages[stage_count - 1].name, sizeof(stages[0].name), "rotate %d", degrees);
+        } else if (strcmp(a, "--resize") == 0 && has_value) {
+            const char* spec = argv[++i];
+            if (!add_stage(stages, &stage_count, STAGE_RESIZE, "resize")) return 2;
+            Stage* stage = &stages[stage_count - 1];
+            if (strchr(spec, '%')) {
+                stage->arg = atoi(spec);
+            } else if (sscanf(spec, "%dx%d", &stage->width, &stage->height) != 2) {
+                stage->width = 0;
+            }
+            if (stage->arg <= 0 && (stage->width <= 0 || stage->height <= 0)) {
+                fprintf(stderr, "bmaptool: --resize expects N%% or WxH\n");
+                return 2;
+            }
+            snprintf(stage->name, sizeof(stage->name), "resize %s", spec);
+        } else if (strcmp(a, "-j") == 0 && has_value) {
+            threads = atol(argv[++i]);
+        } else if (strcmp(a, "-o") == 0 && has_value) {
+            output_dir = argv[++i];
+        } else if (a[0] == '-') {
+            usage();
+            return 2;
+        } else {
+            /* Patterns are expanded here as well, for shells that pass them through quoted */
+            int flags = GLOB_NOCHECK | (globbed ? GLOB_APPEND : 0);
+            if (glob(a, flags, NULL, &inputs) != 0) {
+                fprintf(stderr, "bmaptool: cannot expand %s\n", a);
+                return 2;
+            }
+            globbed = 1;
+        }
+    }
+
+    if (!output_dir || !globbed || inputs.gl_pathc == 0) {
+        usage();
+        if (globbed) globfree(&inputs);
+        return 2;
+    }
+    if (find_name_collisions(inputs.gl_pathv, (int)inputs.gl_pathc) != 0) {
+        globfree(&inputs);
+        return 2;
+    }
+    if (threads < 1) threads = 1;
+    if (threads > (long)inputs.gl_pathc) threads = (long)inputs.gl_pathc;
+
+    Job job;
+    memset(&job, 0, sizeof(job));
+    job.files = inputs.gl_pathv;
+    job.file_count = (int)inputs.gl_pathc;
+    atomic_init(&job.next_file, 0);
+    atomic_init(&job.failures, 0);
+    job.stages = stages;
+    job.stage_count = stage_count;
+    job.output_dir = output_dir;
+    pthread_mutex_init(&job.stats_lock, NULL);
+
+    pthread_t* workers = (pthread_t*)malloc(threads * sizeof(pthread_t));
+    if (!workers) {
+        globfree(&inputs);
+        return 1;
+    }
+
+    double start = now_ms();
+    long started = 0;
+    for (; started < threads; started++) {
+        if (pthread_create(&workers[started], NULL, worker, &job) != 0) break;
+    }
+    if (started == 0) worker(&job);
+    for (long t = 0; t < started; t++) pthread_join(workers[t], NULL);
+    double wall_ms = now_ms() - start;
+
+    printf("bmaptool: %d files, %ld threads, %.3f ms wall (%.1f files/s), kernels: %s\n",
+           job.file_count, started ? started : 1, wall_ms,
+           wall_ms > 0 ? job.file_count * 1000.0 / wall_ms : 0.0, bmp_active_isa());
+    printf("  %-16s %8s  %12s  %10s  %10s\n", "stage", "calls", "total ms", "avg ms", "max ms");
+    print_stats("load", &job.load);
+    for (int s = 0; s < stage_count; s++) print_stats(stages[s].name, &job.stage_stats[s]);
+    print_stats("save", &job.save);
+
+    int failures = atomic_load(&job.failures);
+    if (failures) printf("bmaptool: %d file(s) failed\n", failures);
+
+    pthread_mutex_destroy(&job.stats_lock);
+    free(workers);
+    globfree(&inputs);
+    return failures ? 1 : 0;
+}